@@ -0,0 +1,172 @@
+#include "benchmark.hpp"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <thread>
+
+using json = nlohmann::json;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+volatile const void* keepSink = nullptr;
+
+// Nearest-rank sobre amostras ordenadas
+double percentile(const std::vector<double>& sorted, double p) {
+    size_t rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+    return sorted[rank == 0 ? 0 : rank - 1];
+}
+
+std::string utcTimestamp() {
+    std::time_t now = std::time(nullptr);
+    char buffer[32];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+    return buffer;
+}
+
+std::string compilerName() {
+#if defined(__clang__)
+    return "clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    return "msvc " + std::to_string(_MSC_VER);
+#else
+    return "unknown";
+#endif
+}
+} // namespace
+
+void benchmarkKeep(const void* value) { keepSink = value; }
+
+BenchmarkRunner::BenchmarkRunner(const BenchmarkOptions& options) : options(options) {}
+
+bool BenchmarkRunner::isEnabled(const std::string& name) const {
+    return options.filter.empty() || name.find(options.filter) != std::string::npos;
+}
+
+void BenchmarkRunner::run(const std::string& name, uint64_t itemsPerSample,
+                          const std::function<void()>& body) {
+    if (!isEnabled(name)) {
+        return;
+    }
+    if (itemsPerSample == 0) {
+        itemsPerSample = 1;
+    }
+
+    // Aquecimento: caches, alocacoes preguicosas, frequencia da CPU
+    auto warmupEnd = Clock::now() + std::chrono::duration<double>(options.minTimeSeconds * 0.1);
+    for (int i = 0; i < 3 || Clock::now() < warmupEnd; i++) {
+        body();
+    }
+
+    std::vector<double> samples;
+    samples.reserve(std::min<size_t>(options.maxSamples, 4096));
+    auto start = Clock::now();
+    auto minDuration = std::chrono::duration<double>(options.minTimeSeconds);
+    while (samples.size() < options.maxSamples &&
+           (samples.size() < options.minSamples || Clock::now() - start < minDuration)) {
+        auto begin = Clock::now();
+        body();
+        auto end = Clock::now();
+        samples.push_back(std::chrono::duration<double, std::nano>(end - begin).count() /
+                          static_cast<double>(itemsPerSample));
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    BenchmarkResult result;
+    result.name = name;
+    result.samples = samples.size();
+    result.itemsPerSample = itemsPerSample;
+    result.min = samples.front();
+    result.max = samples.back();
+    result.p50 = percentile(samples, 0.50);
+    result.p90 = percentile(samples, 0.90);
+    result.p99 = percentile(samples, 0.99);
+
+    double sum = 0.0;
+    for (double sample : samples) {
+        sum += sample;
+    }
+    result.mean = sum / samples.size();
+    double variance = 0.0;
+    for (double sample : samples) {
+        variance += (sample - result.mean) * (sample - result.mean);
+    }
+    result.stddev = std::sqrt(variance / samples.size());
+
+    std::printf("%-36s %10.1f ns/item  p90 %10.1f  p99 %10.1f  (%zu samples x %llu)\n",
+                name.c_str(), result.p50, result.p90, result.p99, result.samples,
+                static_cast<unsigned long long>(itemsPerSample));
+    results.push_back(result);
+}
+
+bool BenchmarkRunner::writeJson(const std::string& path) const {
+    json output;
+    output["schema"] = 1;
+    output["label"] = options.label;
+    output["timestamp"] = utcTimestamp();
+    output["compiler"] = compilerName();
+    output["hardware_threads"] = std::thread::hardware_concurrency();
+    output["min_time_s"] = options.minTimeSeconds;
+    output["unit"] = "ns/item";
+    output["parameters"] = json::object();
+    for (const auto& parameter : options.parameters) {
+        output["parameters"][parameter.first] = parameter.second;
+    }
+
+    json list = json::array();
+    for (const auto& result : results) {
+        list.push_back({{"name", result.name},
+                        {"samples", result.samples},
+                        {"items_per_sample", result.itemsPerSample},
+                        {"min", result.min},
+                        {"mean", result.mean},
+                        {"p50", result.p50},
+                        {"p90", result.p90},
+                        {"p99", result.p99},
+                        {"max", result.max},
+                        {"stddev", result.stddev}});
+    }
+    output["benchmarks"] = list;
+
+    std::ofstream file(path);
+    if (!file) {
+        std::fprintf(stderr, "Failed to write %s\n", path.c_str());
+        return false;
+    }
+    file << output.dump(2) << "\n";
+    return static_cast<bool>(file);
+}
+
+int BenchmarkRunner::compareWithBaseline(const std::string& path) const {
+    std::ifstream file(path);
+    json baseline = json::parse(file, nullptr, false);
+    if (baseline.is_discarded() || !baseline.contains("benchmarks")) {
+        std::fprintf(stderr, "Failed to read baseline %s\n", path.c_str());
+        return -1;
+    }
+
+    int regressions = 0;
+    for (const auto& entry : baseline["benchmarks"]) {
+        std::string name = entry.value("name", "");
+        double before = entry.value("p50", 0.0);
+        auto it = std::find_if(results.begin(), results.end(),
+                               [&](const BenchmarkResult& r) { return r.name == name; });
+        if (it == results.end() || before <= 0.0) {
+            continue;
+        }
+
+        double change = it->p50 / before - 1.0;
+        bool regressed = change > options.regressionThreshold;
+        regressions += regressed ? 1 : 0;
+        std::printf("%-36s %+7.1f%%%s\n", name.c_str(), change * 100.0,
+                    regressed ? "  REGRESSION" : "");
+    }
+    return regressions;
+}
@@ -0,0 +1,70 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct BenchmarkOptions {
+    // Roda so os casos cujo nome contem filter
+    std::string filter;
+    // Tempo minimo medido por caso (sem contar o aquecimento)
+    double minTimeSeconds = 0.5;
+    size_t minSamples = 10;
+    size_t maxSamples = 100000;
+    std::string outputPath;
+    std::string baselinePath;
+    // Regressao: p50 mais lento que o baseline por mais que essa fracao
+    double regressionThreshold = 0.10;
+    // Identifica a execucao no JSON (versao, commit, maquina)
+    std::string label;
+    // Configuracao da execucao gravada no JSON (ex.: numero de objetos, backend)
+    std::vector<std::pair<std::string, std::string>> parameters;
+};
+
+// Estatisticas em nanossegundos por item (amostra / itemsPerSample)
+struct BenchmarkResult {
+    std::string name;
+    size_t samples = 0;
+    uint64_t itemsPerSample = 1;
+    double min = 0.0;
+    double mean = 0.0;
+    double p50 = 0.0;
+    double p90 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+    double stddev = 0.0;
+};
+
+// Executa cada caso ate minTimeSeconds / minSamples, uma amostra por chamada do corpo.
+// Corpos baratos devem repetir o trabalho internamente e informar itemsPerSample.
+class BenchmarkRunner {
+  private:
+    BenchmarkOptions options;
+    std::vector<BenchmarkResult> results;
+
+  public:
+    explicit BenchmarkRunner(const BenchmarkOptions& options);
+
+    // Permite pular o setup de casos filtrados
+    bool isEnabled(const std::string& name) const;
+    void run(const std::string& name, uint64_t itemsPerSample, const std::function<void()>& body);
+
+    const std::vector<BenchmarkResult>& getResults() const { return results; }
+    bool writeJson(const std::string& path) const;
+    // Compara o p50 com um JSON anterior; retorna quantos casos regrediram, -1 se o
+    // arquivo nao pode ser lido
+    int compareWithBaseline(const std::string& path) const;
+};
+
+// Impede que o compilador descarte o resultado de um calculo medido
+void benchmarkKeep(const void* value);
+
+template <typename T> inline void benchmarkKeep(const T& value) {
+    benchmarkKeep(static_cast<const void*>(&value));
+}
+
+#endif // BENCHMARK_HPP
@@ -0,0 +1,186 @@
+#include "benchmark_scenes.hpp"
+#include "material.hpp"
+#include "mesh_renderer.hpp"
+#include "shader_asset.hpp"
+#include <cmath>
+#include <fstream>
+#include <vector>
+
+using json = nlohmann::json;
+
+namespace {
+constexpr float PI = 3.14159265358979f;
+constexpr float GRID_SPACING = 3.0f;
+
+std::shared_ptr<Mesh> makeCube(RendererBackend& backend) {
+    // 6 faces, 2 triangulos cada, normais por face
+    static const float faces[6][3] = {{1, 0, 0},  {-1, 0, 0}, {0, 1, 0},
+                                      {0, -1, 0}, {0, 0, 1},  {0, 0, -1}};
+    std::vector<float> vertices;
+    std::vector<float> normals;
+    for (const auto& n : faces) {
+        glm::vec3 normal(n[0], n[1], n[2]);
+        glm::vec3 u = std::abs(normal.y) > 0.5f ? glm::vec3(1, 0, 0) : glm::vec3(0, 1, 0);
+        glm::vec3 v = glm::cross(normal, u);
+        glm::vec3 corners[4] = {normal - u - v, normal + u - v, normal + u + v, normal - u + v};
+        const int order[6] = {0, 1, 2, 0, 2, 3};
+        for (int i : order) {
+            glm::vec3 p = corners[i] * 0.5f;
+            vertices.insert(vertices.end(), {p.x, p.y, p.z});
+            normals.insert(normals.end(), {normal.x, normal.y, normal.z});
+        }
+    }
+
+    auto mesh = std::make_shared<Mesh>();
+    mesh->setVertices(vertices);
+    mesh->setNormals(normals);
+    mesh->setMeshBuffer(backend.createMeshBuffer());
+    mesh->configure();
+    return mesh;
+}
+
+std::shared_ptr<Material> makeMaterial(RendererBackend& backend, const ColorRGBA& color) {
+    auto extension = backend.getShaderExtension();
+    auto vertexShader = std::make_unique<ShaderAsset>("flat.vxs" + extension, ShaderType::VERTEX);
+    vertexShader->setShaderCompiler(backend.createShaderCompiler());
+    auto fragmentShader =
+        std::make_unique<ShaderAsset>("flat.pxs" + extension, ShaderType::FRAGMENT);
+    fragmentShader->setShaderCompiler(backend.createShaderCompiler());
+
+    auto material = std::make_shared<Material>();
+    material->setShaderProgram(backend.createShaderProgram());
+    material->setVertexShader(std::move(vertexShader));
+    material->setFragmentShader(std::move(fragmentShader));
+    material->setBaseColor(color);
+    if (!material->init()) {
+        return nullptr;
+    }
+    // Compilacao assincrona: o benchmark nao deve medir o driver compilando
+    while (!material->isReady() && !material->hasFailed()) {
+    }
+    return material;
+}
+} // namespace
+
+uint32_t BenchmarkRandom::next() {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+float BenchmarkRandom::range(float min, float max) {
+    return min + (max - min) * (next() >> 8) * (1.0f / 16777216.0f);
+}
+
+bool writeSphereObj(const std::string& path, int segments, int rings) {
+    std::ofstream file(path);
+    if (!file) {
+        return false;
+    }
+
+    for (int r = 0; r <= rings; r++) {
+        float phi = PI * r / rings;
+        for (int s = 0; s <= segments; s++) {
+            float theta = 2.0f * PI * s / segments;
+            float x = std::sin(phi) * std::cos(theta);
+            float y = std::cos(phi);
+            float z = std::sin(phi) * std::sin(theta);
+            file << "v " << x << " " << y << " " << z << "\n";
+            file << "vn " << x << " " << y << " " << z << "\n";
+        }
+    }
+
+    // Indices do OBJ comecam em 1
+    int stride = segments + 1;
+    for (int r = 0; r < rings; r++) {
+        for (int s = 0; s < segments; s++) {
+            int a = r * stride + s + 1;
+            int b = a + stride;
+            file << "f " << a << "//" << a << " " << b << "//" << b << " " << (b + 1) << "//"
+                 << (b + 1) << "\n";
+            file << "f " << a << "//" << a << " " << (b + 1) << "//" << (b + 1) << " " << (a + 1)
+                 << "//" << (a + 1) << "\n";
+        }
+    }
+    return static_cast<bool>(file);
+}
+
+json makeSceneJson(uint32_t objectCount, const std::string& meshPath, uint32_t seed) {
+    BenchmarkRandom random(seed);
+
+    json scene;
+    scene["camera"] = {{"background_color", {0.2, 0.3, 0.3, 1.0}},
+                       {"fov", 60.0},
+                       {"view_rect", {800.0, 600.0}},
+                       {"position", {0.0, 6.0, 12.0}}};
+    scene["lights"] = json::array({{{"type", "DIRECTIONAL"}, {"direction", {0.5, -1.0, -0.5}}}});
+
+    json objects = json::array();
+    for (uint32_t i = 0; i < objectCount; i++) {
+        json mesh = {{"type", "MESH_RENDERER"},
+                     {"mesh", {{"path", meshPath}, {"shadeSmooth", i % 2 == 0}}},
+                     {"material",
+                      {{"vertexShaderPath", "flat.vxs"},
+                       {"fragmentShaderPath", "flat.pxs"},
+                       {"color", {random.range(0, 1), random.range(0, 1), random.range(0, 1),
+                                  1.0}}}}};
+        json transform = {
+            {"type", "TRANSFORM"},
+            {"position", {random.range(-5, 5), random.range(-2, 2), random.range(-5, 5)}},
+            {"rotation", {random.range(0, 360), random.range(0, 360), 0.0}},
+            {"scale", {1.0, 1.0, 1.0}}};
+        objects.push_back({{"components", {mesh, transform}}});
+    }
+    scene["gameObjects"] = objects;
+    return scene;
+}
+
+std::unique_ptr<Scene> makeGridScene(RendererBackend& backend, uint32_t count,
+                                     uint32_t materialCount, uint32_t seed) {
+    BenchmarkRandom random(seed);
+
+    auto cube = makeCube(backend);
+    std::vector<std::shared_ptr<Material>> materials;
+    for (uint32_t i = 0; i < materialCount; i++) {
+        float alpha = i % 8 == 7 ? 0.5f : 1.0f;
+        auto material = makeMaterial(
+            backend, {random.range(0, 1), random.range(0, 1), random.range(0, 1), alpha});
+        if (!material) {
+            return nullptr;
+        }
+        materials.push_back(material);
+    }
+
+    uint32_t side = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(count))));
+    float offset = (side - 1) * GRID_SPACING * 0.5f;
+
+    auto objects = new std::vector<GameObject*>();
+    objects->reserve(count);
+    for (uint32_t i = 0; i < count; i++) {
+        auto transform = std::make_unique<Transform>();
+        transform->setPosition({(i % side) * GRID_SPACING - offset, random.range(-1, 1),
+                                (i / side) * GRID_SPACING - offset});
+        transform->setEulerAngles({random.range(0, 360), random.range(0, 360), 0.0f});
+        transform->setScale({1.0f, 1.0f, 1.0f});
+
+        auto renderer = std::make_unique<MeshRenderer>();
+        renderer->setMaterial(materials[random.next() % materials.size()]);
+
+        auto object = new GameObject();
+        object->setTransform(std::move(transform));
+        object->setMesh(cube);
+        object->setMeshRenderer(std::move(renderer));
+        objects->push_back(object);
+    }
+
+    auto camera = new Camera();
+    camera->setPosition({0.0f, 15.0f, 30.0f});
+    camera->setViewRect(800.0f, 600.0f);
+
+    auto scene = std::make_unique<Scene>();
+    scene->setCamera(camera);
+    scene->setLights(new std::vector<Light>{{LightType::DIRECTIONAL, {0.5f, -1.0f, -0.5f}}});
+    scene->setGameObjects(objects);
+    return scene;
+}
@@ -0,0 +1,38 @@
+#ifndef BENCHMARK_SCENES_HPP
+#define BENCHMARK_SCENES_HPP
+
+#include "renderer/renderer_backend.hpp"
+#include "scene.hpp"
+#include <cstdint>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <string>
+
+// Cenas e assets gerados a partir de uma semente fixa, para que os numeros de duas
+// versoes do engine sejam comparaveis sem depender dos arquivos do projeto
+
+// Gerador xorshift32: mesma sequencia em qualquer compilador/plataforma
+class BenchmarkRandom {
+  private:
+    uint32_t state;
+
+  public:
+    explicit BenchmarkRandom(uint32_t seed) : state(seed ? seed : 0x9E3779B9u) {}
+    uint32_t next();
+    // [min, max)
+    float range(float min, float max);
+};
+
+// Esfera UV com normais por vertice (segments * rings * 2 triangulos)
+bool writeSphereObj(const std::string& path, int segments, int rings);
+
+// Descricao .scn com objectCount objetos espalhados perto da origem
+nlohmann::json makeSceneJson(uint32_t objectCount, const std::string& meshPath, uint32_t seed);
+
+// Cena em memoria: count cubos numa grade centrada na origem, com materialCount
+// materiais (1 em cada 8 translucido) e posicoes/rotacoes sorteadas pela semente.
+// A camera padrao ve so uma parte da grade, o resto e trabalho para o culling.
+std::unique_ptr<Scene> makeGridScene(RendererBackend& backend, uint32_t count,
+                                     uint32_t materialCount, uint32_t seed);
+
+#endif // BENCHMARK_SCENES_HPP
@@ -0,0 +1,313 @@
+#include "benchmark.hpp"
+#include "benchmark_scenes.hpp"
+#include "logger.hpp"
+#include "renderer/frustum_culler.hpp"
+#include "renderer/occlusion_culler.hpp"
+#include "renderer/render_queue.hpp"
+#include "renderer/renderer.hpp"
+#include "scene_compilation.hpp"
+#include "scene_loader.hpp"
+#include "scene_manager.hpp"
+#include "stb_image_header.hpp"
+#include "transform_hierarchy.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Uso (da raiz do projeto, onde ficam os shaders):
+//   benchmarks [--filter=texto] [--min-time=segundos] [--out=resultado.json]
+//              [--baseline=anterior.json] [--threshold=0.10] [--label=texto]
+//              [--gpu=software|opengl|vulkan|none] [--objects=N]
+// Sai com 1 se algum caso ficou mais lento que o baseline alem do threshold.
+
+namespace {
+constexpr uint32_t SEED = 1234;
+
+struct Arguments {
+    BenchmarkOptions options;
+    std::string gpu = "software";
+    uint32_t objects = 10000;
+};
+
+bool readArgument(const char* arg, const char* name, std::string& value) {
+    size_t length = std::strlen(name);
+    if (std::strncmp(arg, name, length) != 0 || arg[length] != '=') {
+        return false;
+    }
+    value = arg + length + 1;
+    return true;
+}
+
+Arguments parseArguments(int argc, char* argv[]) {
+    Arguments args;
+    for (int i = 1; i < argc; i++) {
+        std::string value;
+        if (readArgument(argv[i], "--filter", value)) {
+            args.options.filter = value;
+        } else if (readArgument(argv[i], "--min-time", value)) {
+            args.options.minTimeSeconds = std::atof(value.c_str());
+        } else if (readArgument(argv[i], "--out", value)) {
+            args.options.outputPath = value;
+        } else if (readArgument(argv[i], "--baseline", value)) {
+            args.options.baselinePath = value;
+        } else if (readArgument(argv[i], "--threshold", value)) {
+            args.options.regressionThreshold = std::atof(value.c_str());
+        } else if (readArgument(argv[i], "--label", value)) {
+            args.options.label = value;
+        } else if (readArgument(argv[i], "--gpu", value)) {
+            args.gpu = value;
+        } else if (readArgument(argv[i], "--objects", value)) {
+            args.objects = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+        } else {
+            std::fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+        }
+    }
+    return args;
+}
+
+bool parseGraphicsApi(const std::string& name, GraphicsAPI& api) {
+    if (name == "software") {
+        api = GraphicsAPI::SOFTWARE;
+    } else if (name == "opengl") {
+        api = GraphicsAPI::OPENGL;
+    } else if (name == "vulkan") {
+        api = GraphicsAPI::VULKAN;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Partes isoladas do frame, sem backend desenhando nada
+void runMicroBenchmarks(BenchmarkRunner& runner, uint32_t objectCount) {
+    if (runner.isEnabled("transform/get_model_matrix")) {
+        BenchmarkRandom random(SEED);
+        std::vector<Transform> transforms(1024);
+        for (auto& transform : transforms) {
+            transform.setPosition({random.range(-10, 10), random.range(-10, 10), 0.0f});
+            transform.setEulerAngles({random.range(0, 360), random.range(0, 360), 0.0f});
+            transform.setScale({1.0f, 2.0f, 1.0f});
+        }
+        // Objetos parados: so leem o cache
+        runner.run("transform/get_model_matrix", transforms.size(), [&]() {
+            glm::mat4 sum(0.0f);
+            for (const auto& transform : transforms) {
+                sum += transform.getModelMatrix();
+            }
+            benchmarkKeep(sum);
+        });
+        // Todos se movendo: recompoe a matriz local a cada leitura
+        runner.run("transform/dirty_model_matrix", transforms.size(), [&]() {
+            glm::mat4 sum(0.0f);
+            for (auto& transform : transforms) {
+                transform.setPosition(transform.getPosition());
+                sum += transform.getModelMatrix();
+            }
+            benchmarkKeep(sum);
+        });
+    }
+
+    if (runner.isEnabled("transform/hierarchy_update")) {
+        // Floresta com 3 filhos por no; a cada iteracao 1/8 das raizes se move e
+        // o lote recalcula so as subarvores delas
+        BenchmarkRandom random(SEED);
+        uint32_t rootCount = std::max<uint32_t>(1, objectCount / 16);
+        TransformHierarchy hierarchy;
+        std::vector<std::unique_ptr<Transform>> transforms;
+        transforms.reserve(objectCount);
+        for (uint32_t i = 0; i < objectCount; i++) {
+            auto transform = std::make_unique<Transform>();
+            transform->setPosition({random.range(-10, 10), random.range(-10, 10), 0.0f});
+            transform->setEulerAngles({0.0f, random.range(0, 360), 0.0f});
+            if (i >= rootCount) {
+                transform->setParent(transforms[(i - rootCount) / 3].get());
+            }
+            transform->setHierarchy(&hierarchy);
+            transforms.push_back(std::move(transform));
+        }
+        hierarchy.update();
+
+        uint32_t frame = 0;
+        runner.run("transform/hierarchy_update", objectCount, [&]() {
+            for (uint32_t i = frame++ % 8; i < rootCount; i += 8) {
+                Vector3 position = transforms[i]->getPosition();
+                position.y += 0.01f;
+                transforms[i]->setPosition(position);
+            }
+            hierarchy.update();
+            benchmarkKeep(hierarchy.getLastUpdateCount());
+        });
+
+        for (auto& transform : transforms) {
+            transform->setHierarchy(nullptr);
+        }
+    }
+
+    Renderer renderer;
+    if (!renderer.initBackend(GraphicsAPI::NONE) || !renderer.initHeadless(800, 600)) {
+        return;
+    }
+    RendererBackend& backend = *renderer.getRendererBackend();
+    auto scene = makeGridScene(backend, objectCount, 16, SEED);
+    if (!scene) {
+        return;
+    }
+
+    const Camera& camera = *scene->getCamera();
+    glm::mat4 viewProjection = camera.getProjectionMatrix() * camera.getViewMatrix();
+    glm::vec4 planes[6];
+    FrustumCuller::extractPlanes(viewProjection, planes);
+    std::vector<GameObject*>& objects = *scene->getGameObjects();
+
+    std::vector<int32_t> proxies;
+    runner.run("culling/bvh_query", objects.size(), [&]() {
+        scene->getSpatialIndex().queryFrustum(planes, proxies);
+        benchmarkKeep(proxies.data());
+    });
+
+    FrustumCuller frustumCuller;
+    for (GameObject* object : objects) {
+        AABB box;
+        BoundingSphere sphere;
+        object->getWorldBounds(box, sphere);
+        frustumCuller.add(box, sphere);
+    }
+    std::vector<uint32_t> visibleIndices;
+    runner.run("culling/frustum_simd", objects.size(), [&]() {
+        frustumCuller.cull(viewProjection, visibleIndices);
+        benchmarkKeep(visibleIndices.data());
+    });
+
+    std::vector<GameObject*> frustumVisible;
+    for (uint32_t index : visibleIndices) {
+        frustumVisible.push_back(objects[index]);
+    }
+    OcclusionCuller occlusionCuller;
+    std::vector<GameObject*> occlusionInput;
+    runner.run("culling/occlusion", frustumVisible.size(), [&]() {
+        occlusionInput = frustumVisible;
+        occlusionCuller.cull(viewProjection, occlusionInput);
+        benchmarkKeep(occlusionInput.data());
+    });
+
+    RenderQueue queue;
+    runner.run("render_queue/build_sort", objects.size(), [&]() {
+        queue.build(objects, &camera);
+        benchmarkKeep(queue.size());
+    });
+
+    // Frame completo de CPU: culling, fila e o que o backend nulo simula de uploads
+    runner.run("frame/null_cpu", 1, [&]() {
+        renderer.render(*scene);
+        renderer.present(nullptr);
+    });
+
+    scene.reset();
+}
+
+// Carregamento de assets e cenas a partir de arquivos gerados
+void runAssetBenchmarks(BenchmarkRunner& runner, const std::filesystem::path& workDir) {
+    std::string spherePath = (workDir / "benchmark_sphere.obj").string();
+    if (!writeSphereObj(spherePath, 128, 64)) {
+        std::fprintf(stderr, "Failed to write %s\n", spherePath.c_str());
+        return;
+    }
+
+    SceneLoader loader;
+    runner.run("asset/load_obj_mesh", 1, [&]() {
+        auto mesh = loader.loadObjMesh(spherePath, true);
+        benchmarkKeep(mesh.get());
+    });
+
+    std::string sceneText = makeSceneJson(1000, spherePath, SEED).dump();
+    CompiledScene compiled;
+    runner.run("scene_compiler/compile", 1, [&]() {
+        compileScene(nlohmann::json::parse(sceneText), compiled);
+        benchmarkKeep(compiled);
+    });
+
+    std::string scenePath = (workDir / "benchmark_scene.scnb").string();
+    if (!writeCompiledScene(scenePath, compiled)) {
+        std::fprintf(stderr, "Failed to write %s\n", scenePath.c_str());
+        return;
+    }
+
+    Renderer renderer;
+    if (!renderer.initBackend(GraphicsAPI::NONE) || !renderer.initHeadless(800, 600)) {
+        return;
+    }
+    SceneManager sceneManager;
+    sceneManager.setRendererBackend(*renderer.getRendererBackend());
+    sceneManager.addScene("benchmark", scenePath);
+    runner.run("scene_manager/load_scene", 1, [&]() {
+        sceneManager.loadScene("benchmark");
+        benchmarkKeep(sceneManager.getActiveScene());
+    });
+}
+
+// Frames desenhados de verdade num backend headless. Mede render + present; com a GPU
+// como gargalo o tempo converge para o da GPU (fences do ring/frames em voo).
+void runGpuBenchmarks(BenchmarkRunner& runner, const std::string& gpu, uint32_t objectCount) {
+    GraphicsAPI api;
+    std::string name = "frame/" + gpu + "_headless";
+    if (!runner.isEnabled(name) || !parseGraphicsApi(gpu, api)) {
+        return;
+    }
+
+    Renderer renderer;
+    if (!renderer.initBackend(api) || !renderer.initHeadless(1280, 720)) {
+        std::fprintf(stderr, "Skipping %s: headless %s not available\n", name.c_str(),
+                     gpu.c_str());
+        return;
+    }
+    auto scene = makeGridScene(*renderer.getRendererBackend(), objectCount, 16, SEED);
+    if (!scene) {
+        std::fprintf(stderr, "Skipping %s: failed to build scene\n", name.c_str());
+        return;
+    }
+
+    runner.run(name, 1, [&]() {
+        renderer.render(*scene);
+        renderer.present(nullptr);
+    });
+
+    // Esvazia a fila antes de destruir os recursos
+    std::vector<uint8_t> pixels;
+    int width = 0, height = 0;
+    renderer.getRendererBackend()->readPixels(pixels, width, height);
+    scene.reset();
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Arguments args = parseArguments(argc, argv);
+    args.options.parameters = {{"objects", std::to_string(args.objects)}, {"gpu", args.gpu}};
+    Logger::init("benchmarks");
+
+    std::filesystem::path workDir = std::filesystem::temp_directory_path() / "yume_benchmarks";
+    std::filesystem::create_directories(workDir);
+
+    BenchmarkRunner runner(args.options);
+    runMicroBenchmarks(runner, args.objects);
+    runAssetBenchmarks(runner, workDir);
+    if (args.gpu != "none") {
+        runGpuBenchmarks(runner, args.gpu, args.objects);
+    }
+
+    int exitCode = 0;
+    if (!args.options.outputPath.empty() && !runner.writeJson(args.options.outputPath)) {
+        exitCode = 1;
+    }
+    if (!args.options.baselinePath.empty() &&
+        runner.compareWithBaseline(args.options.baselinePath) != 0) {
+        exitCode = 1;
+    }
+
+    Logger::shutdown();
+    return exitCode;
+}
@@ -0,0 +1,55 @@
+#include "bounds.hpp"
+#include <algorithm>
+#include <cmath>
+
+AABB Bounds::fromVertices(const std::vector<float>& vertices) {
+    AABB box;
+    if (vertices.size() < 3) {
+        return box;
+    }
+
+    box.min = box.max = glm::vec3(vertices[0], vertices[1], vertices[2]);
+    for (size_t i = 3; i + 2 < vertices.size(); i += 3) {
+        glm::vec3 v(vertices[i], vertices[i + 1], vertices[i + 2]);
+        box.min = glm::min(box.min, v);
+        box.max = glm::max(box.max, v);
+    }
+    return box;
+}
+
+BoundingSphere Bounds::sphereFromVertices(const std::vector<float>& vertices, const AABB& box) {
+    BoundingSphere sphere;
+    sphere.center = box.getCenter();
+
+    float radiusSq = 0.0f;
+    for (size_t i = 0; i + 2 < vertices.size(); i += 3) {
+        glm::vec3 d = glm::vec3(vertices[i], vertices[i + 1], vertices[i + 2]) - sphere.center;
+        radiusSq = std::max(radiusSq, glm::dot(d, d));
+    }
+    sphere.radius = std::sqrt(radiusSq);
+    return sphere;
+}
+
+AABB Bounds::transform(const AABB& box, const glm::mat4& matrix) {
+    glm::vec3 center = glm::vec3(matrix * glm::vec4(box.getCenter(), 1.0f));
+    glm::vec3 extents = box.getExtents();
+
+    // Extensao no mundo = |M3x3| * extensao local
+    glm::vec3 worldExtents(0.0f);
+    for (int column = 0; column < 3; column++) {
+        worldExtents += glm::abs(glm::vec3(matrix[column])) * extents[column];
+    }
+
+    return {center - worldExtents, center + worldExtents};
+}
+
+BoundingSphere Bounds::transform(const BoundingSphere& sphere, const glm::mat4& matrix) {
+    float scaleSq = std::max({glm::dot(glm::vec3(matrix[0]), glm::vec3(matrix[0])),
+                              glm::dot(glm::vec3(matrix[1]), glm::vec3(matrix[1])),
+                              glm::dot(glm::vec3(matrix[2]), glm::vec3(matrix[2]))});
+
+    BoundingSphere result;
+    result.center = glm::vec3(matrix * glm::vec4(sphere.center, 1.0f));
+    result.radius = sphere.radius * std::sqrt(scaleSq);
+    return result;
+}
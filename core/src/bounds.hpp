@@ -0,0 +1,32 @@
+#ifndef BOUNDS_HPP
+#define BOUNDS_HPP
+
+#include <glm/glm.hpp>
+#include <vector>
+
+struct AABB {
+    glm::vec3 min = glm::vec3(0.0f);
+    glm::vec3 max = glm::vec3(0.0f);
+
+    glm::vec3 getCenter() const { return (min + max) * 0.5f; }
+    glm::vec3 getExtents() const { return (max - min) * 0.5f; }
+};
+
+struct BoundingSphere {
+    glm::vec3 center = glm::vec3(0.0f);
+    float radius = 0.0f;
+};
+
+namespace Bounds {
+// vertices no formato xyz intercalado, como em Mesh::getVertices()
+AABB fromVertices(const std::vector<float>& vertices);
+// Esfera centrada na AABB com raio ate o vertice mais distante
+BoundingSphere sphereFromVertices(const std::vector<float>& vertices, const AABB& box);
+
+// AABB que envolve a caixa transformada (metodo de Arvo, sem transformar os 8 cantos)
+AABB transform(const AABB& box, const glm::mat4& matrix);
+// Escala nao uniforme usa o maior eixo, entao o resultado e conservador
+BoundingSphere transform(const BoundingSphere& sphere, const glm::mat4& matrix);
+} // namespace Bounds
+
+#endif // BOUNDS_HPP
@@ -1,4 +1,5 @@
 #include "camera.hpp"
+#include <glm/gtc/matrix_transform.hpp>
 
 const Vector3& Camera::getPosition() const { return position; }
 
@@ -45,4 +46,18 @@ float Camera::getOrthoSize() const { return orthoSize; }
 void Camera::setViewRect(float width, float height) {
     setWidth(width);
     setHeight(height);
-}
\ No newline at end of file
+}
+
+glm::mat4 Camera::getViewMatrix() const {
+    return glm::lookAt({position.x, position.y, position.z}, glm::vec3(0.0f, 0.0f, 0.0f),
+                       glm::vec3(0.0f, 1.0f, 0.0f));
+}
+
+glm::mat4 Camera::getProjectionMatrix() const {
+    if (orthographic) {
+        float aspect = getAspectRatio();
+        return glm::ortho(-orthoSize * aspect, orthoSize * aspect, -orthoSize, orthoSize,
+                          nearDistance, farDistance);
+    }
+    return glm::perspective(glm::radians(fov), getAspectRatio(), nearDistance, farDistance);
+}
@@ -4,12 +4,15 @@
 #include "color.hpp"
 #include "skybox.hpp"
 #include "vector3.hpp"
+#include <glm/glm.hpp>
+#include <memory>
 
 class Camera {
   private:
     ColorRGBA backgroundColor = {0.2f, 0.3f, 0.3f, 1.0f};
     Vector3 position = {0.0f, 2.0f, 2.0f};
-    std::unique_ptr<Skybox> skybox;
+    // Compartilhado: copias da camera (snapshot da thread de render) usam o mesmo skybox
+    std::shared_ptr<Skybox> skybox;
     float fov = 45.0f;
     float nearDistance = 0.1f;
     float farDistance = 100.0f;
@@ -45,6 +48,10 @@ class Camera {
     void setOrthographic(bool ortho);
     bool isOrthographic() const;
     void setViewRect(float width, float height);
+
+    // Camera olha sempre para a origem (mesma convencao dos backends)
+    glm::mat4 getViewMatrix() const;
+    glm::mat4 getProjectionMatrix() const;
 };
 
 #endif // CAMERA_HPP
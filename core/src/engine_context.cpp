@@ -1,8 +1,11 @@
 #include "engine_context.hpp"
 
-Yume::Context::Context(IInput* input) : input(input) {}
+Yume::Context::Context(IInput* input) : input(input) { JobSystem::setShared(&jobs); }
 
 Yume::Context::~Context() {
+    if (&JobSystem::shared() == &jobs) {
+        JobSystem::setShared(nullptr);
+    }
     if (input) {
         delete input;
     }
@@ -10,4 +13,6 @@ Yume::Context::~Context() {
 
 Yume::IInput& Yume::Context::getInputSystem() { 
     return *input; 
-}
\ No newline at end of file
+}
+
+Yume::JobSystem& Yume::Context::getJobSystem() { return jobs; }
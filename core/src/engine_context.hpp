@@ -2,6 +2,7 @@
 #define ENGINE_CONTEXT_HPP
 
 #include "input/i_input.hpp"
+#include "job_system.hpp"
 
 namespace Yume {
 class Context {
@@ -9,9 +10,12 @@ class Context {
     Context(IInput* input);
     ~Context();
     IInput* input;
+    // Agendador compartilhado (JobSystem::shared()) enquanto o Context existir
+    JobSystem jobs;
 
     IInput& getInputSystem();
+    JobSystem& getJobSystem();
 };
 } // namespace Yume
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,213 @@
+#define CLASS_NAME "EngineStats"
+#include "engine_stats.hpp"
+#include "log_macros.hpp"
+#include "memory_tracker.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+FrameStats g_lastFrame;
+uint64_t g_frameCount = 0;
+Clock::time_point g_lastEnd;
+bool g_hasLastEnd = false;
+FrameTimeHistory g_frameTimes;
+FrameTimeHistory g_gpuFrameTimes;
+GpuFrameStats g_lastGpuFrame;
+std::ofstream g_csv;
+
+// Nearest-rank sobre amostras ordenadas
+double percentile(const std::vector<float>& sorted, double p) {
+    size_t rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+    return sorted[rank == 0 ? 0 : rank - 1];
+}
+
+void writeCsvRow(const FrameStats& frame, float milliseconds) {
+    g_csv << g_frameCount << "," << milliseconds << "," << frame.drawCalls << ","
+          << frame.triangles << "," << frame.programBinds << "," << frame.vertexArrayBinds << ","
+          << frame.textureBinds << "," << frame.bytesUploaded << "," << frame.objectsTested << ","
+          << frame.objectsVisible << "," << frame.objectsCulled << "," << frame.allocations
+          << "," << frame.allocatedBytes << "," << frame.renderLoopAllocations << ","
+          << MemoryTracker::getTotal().liveBytes << ","
+          << EngineStats::getAssetCount(AssetType::MESH) << ","
+          << EngineStats::getAssetCount(AssetType::MATERIAL) << ","
+          << EngineStats::getAssetCount(AssetType::SHADER) << ","
+          << EngineStats::getAssetCount(AssetType::TEXTURE) << "," << g_lastGpuFrame.totalMs;
+    for (float passMs : g_lastGpuFrame.passMs) {
+        g_csv << "," << passMs;
+    }
+    g_csv << "\n";
+}
+} // namespace
+
+const char* getGpuPassName(GpuPass pass) {
+    switch (pass) {
+    case GpuPass::CLEAR:
+        return "clear";
+    case GpuPass::OPAQUE:
+        return "opaque";
+    case GpuPass::SPRITES:
+        return "sprites";
+    case GpuPass::SKYBOX:
+        return "skybox";
+    default:
+        return "unknown";
+    }
+}
+
+FrameStats EngineStats::currentFrame;
+std::atomic<int32_t> EngineStats::assetCounts[static_cast<size_t>(AssetType::COUNT)] = {};
+
+FrameTimeHistory::FrameTimeHistory(size_t capacity) : samples(capacity > 0 ? capacity : 1) {}
+
+void FrameTimeHistory::add(float milliseconds) {
+    samples[next] = milliseconds;
+    next = (next + 1) % samples.size();
+    count = std::min(count + 1, samples.size());
+}
+
+void FrameTimeHistory::clear() {
+    next = 0;
+    count = 0;
+}
+
+FrameTimeSummary FrameTimeHistory::summarize() const {
+    FrameTimeSummary summary;
+    if (count == 0) {
+        return summary;
+    }
+
+    std::vector<float> sorted(samples.begin(), samples.begin() + count);
+    std::sort(sorted.begin(), sorted.end());
+
+    double sum = 0.0;
+    for (float sample : sorted) {
+        sum += sample;
+    }
+    summary.samples = static_cast<uint32_t>(count);
+    summary.mean = sum / count;
+    summary.p50 = percentile(sorted, 0.50);
+    summary.p95 = percentile(sorted, 0.95);
+    summary.p99 = percentile(sorted, 0.99);
+    summary.max = sorted.back();
+    return summary;
+}
+
+const FrameStats& EngineStats::lastFrame() { return g_lastFrame; }
+
+uint64_t EngineStats::getFrameCount() { return g_frameCount; }
+
+void EngineStats::endFrame() {
+    Clock::time_point now = Clock::now();
+    float milliseconds = 0.0f;
+    if (g_hasLastEnd) {
+        milliseconds = std::chrono::duration<float, std::milli>(now - g_lastEnd).count();
+        g_frameTimes.add(milliseconds);
+    }
+    g_lastEnd = now;
+    g_hasLastEnd = true;
+
+    MemoryTracker::endFrame(currentFrame.allocations, currentFrame.allocatedBytes,
+                            currentFrame.renderLoopAllocations);
+    g_lastFrame = currentFrame;
+    currentFrame = FrameStats();
+    g_frameCount++;
+
+    if (g_csv.is_open()) {
+        writeCsvRow(g_lastFrame, milliseconds);
+    }
+}
+
+FrameTimeSummary EngineStats::getFrameTimes() { return g_frameTimes.summarize(); }
+
+void EngineStats::resetFrameTimes() {
+    g_frameTimes.clear();
+    g_gpuFrameTimes.clear();
+    // Um carregamento entre dois frames nao deve entrar como tempo de frame
+    g_hasLastEnd = false;
+}
+
+void EngineStats::recordGpuFrame(const GpuFrameStats& gpuFrame) {
+    g_lastGpuFrame = gpuFrame;
+    g_gpuFrameTimes.add(gpuFrame.totalMs);
+}
+
+const GpuFrameStats& EngineStats::lastGpuFrame() { return g_lastGpuFrame; }
+
+FrameTimeSummary EngineStats::getGpuFrameTimes() { return g_gpuFrameTimes.summarize(); }
+
+bool EngineStats::isGpuBound(double threshold) {
+    FrameTimeSummary gpu = g_gpuFrameTimes.summarize();
+    FrameTimeSummary cpu = g_frameTimes.summarize();
+    if (gpu.samples == 0 || cpu.samples == 0) {
+        return false;
+    }
+    return gpu.p50 >= threshold * cpu.p50;
+}
+
+bool EngineStats::openCsv(const std::string& path) {
+    closeCsv();
+    g_csv.open(path);
+    if (!g_csv) {
+        LOG_ERROR("Failed to open " + path);
+        return false;
+    }
+    g_csv << "frame,cpu_ms,draw_calls,triangles,program_binds,vertex_array_binds,texture_binds,"
+             "bytes_uploaded,objects_tested,objects_visible,objects_culled,allocations,"
+             "allocated_bytes,render_loop_allocations,live_bytes,meshes,materials,shaders,"
+             "textures,gpu_ms";
+    // Colunas de GPU repetem o ultimo frame lido, que e alguns frames mais antigo
+    for (size_t i = 0; i < GPU_PASS_COUNT; i++) {
+        g_csv << ",gpu_" << getGpuPassName(static_cast<GpuPass>(i)) << "_ms";
+    }
+    g_csv << "\n";
+    return true;
+}
+
+void EngineStats::closeCsv() {
+    if (g_csv.is_open()) {
+        g_csv.close();
+    }
+}
+
+bool EngineStats::checkBudget(const FrameBudget& budget, std::string* violations) {
+    std::string report;
+    if (budget.maxDrawCalls && g_lastFrame.drawCalls > budget.maxDrawCalls) {
+        report += "draw calls " + std::to_string(g_lastFrame.drawCalls) + " > " +
+                  std::to_string(budget.maxDrawCalls) + "; ";
+    }
+    if (budget.maxTriangles && g_lastFrame.triangles > budget.maxTriangles) {
+        report += "triangles " + std::to_string(g_lastFrame.triangles) + " > " +
+                  std::to_string(budget.maxTriangles) + "; ";
+    }
+    if (budget.maxBytesUploaded && g_lastFrame.bytesUploaded > budget.maxBytesUploaded) {
+        report += "bytes uploaded " + std::to_string(g_lastFrame.bytesUploaded) + " > " +
+                  std::to_string(budget.maxBytesUploaded) + "; ";
+    }
+    if (budget.maxAllocations && g_lastFrame.allocations > budget.maxAllocations) {
+        report += "allocations " + std::to_string(g_lastFrame.allocations) + " > " +
+                  std::to_string(budget.maxAllocations) + "; ";
+    }
+    if (budget.maxFrameMsP95 > 0.0) {
+        double p95 = g_frameTimes.summarize().p95;
+        if (p95 > budget.maxFrameMsP95) {
+            report += "frame p95 " + std::to_string(p95) + " ms > " +
+                      std::to_string(budget.maxFrameMsP95) + " ms; ";
+        }
+    }
+    if (budget.maxGpuMsP95 > 0.0) {
+        double p95 = g_gpuFrameTimes.summarize().p95;
+        if (p95 > budget.maxGpuMsP95) {
+            report += "gpu p95 " + std::to_string(p95) + " ms > " +
+                      std::to_string(budget.maxGpuMsP95) + " ms; ";
+        }
+    }
+
+    if (violations) {
+        *violations = report;
+    }
+    return report.empty();
+}
@@ -0,0 +1,123 @@
+#ifndef ENGINE_STATS_HPP
+#define ENGINE_STATS_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class AssetType : uint8_t { MESH = 0, MATERIAL, SHADER, TEXTURE, COUNT };
+
+// Passes medidos pelos profilers de GPU dos backends
+enum class GpuPass : uint8_t { CLEAR = 0, OPAQUE, SPRITES, SKYBOX, COUNT };
+constexpr size_t GPU_PASS_COUNT = static_cast<size_t>(GpuPass::COUNT);
+const char* getGpuPassName(GpuPass pass);
+
+// Contadores de um frame. Os backends incrementam na thread de render; o frame
+// fecha em EngineStats::endFrame (chamado por Renderer::present).
+struct FrameStats {
+    uint32_t drawCalls = 0;
+    uint64_t triangles = 0;
+    uint32_t programBinds = 0;
+    // VAO no OpenGL, vertex buffer no Vulkan
+    uint32_t vertexArrayBinds = 0;
+    // Texturas no OpenGL, descriptor sets no Vulkan
+    uint32_t textureBinds = 0;
+    uint64_t bytesUploaded = 0;
+    uint32_t objectsTested = 0;
+    uint32_t objectsVisible = 0;
+    uint32_t objectsCulled = 0;
+    // So com YUME_TRACK_ALLOCATIONS; ver MemoryTracker
+    uint64_t allocations = 0;
+    uint64_t allocatedBytes = 0;
+    uint64_t renderLoopAllocations = 0;
+};
+
+// Tempos de GPU de um frame ja concluido. Chegam alguns frames depois do frame que
+// os gerou (frame indica qual); passes que nao rodaram ficam com 0.
+struct GpuFrameStats {
+    uint64_t frame = 0;
+    float passMs[GPU_PASS_COUNT] = {};
+    // Do inicio do primeiro pass ao fim do ultimo
+    float totalMs = 0.0f;
+};
+
+struct FrameTimeSummary {
+    uint32_t samples = 0;
+    double mean = 0.0;
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+// Limites por cena; 0 desliga o limite
+struct FrameBudget {
+    uint32_t maxDrawCalls = 0;
+    uint64_t maxTriangles = 0;
+    uint64_t maxBytesUploaded = 0;
+    // Alocacoes no heap por frame (so com YUME_TRACK_ALLOCATIONS)
+    uint64_t maxAllocations = 0;
+    double maxFrameMsP95 = 0.0;
+    double maxGpuMsP95 = 0.0;
+};
+
+// Tempos de frame (ms) dos ultimos capacity frames
+class FrameTimeHistory {
+  private:
+    std::vector<float> samples;
+    size_t next = 0;
+    size_t count = 0;
+
+  public:
+    explicit FrameTimeHistory(size_t capacity = 1024);
+    void add(float milliseconds);
+    void clear();
+    size_t size() const { return count; }
+    FrameTimeSummary summarize() const;
+};
+
+class EngineStats {
+  private:
+    static FrameStats currentFrame;
+    static std::atomic<int32_t> assetCounts[static_cast<size_t>(AssetType::COUNT)];
+
+  public:
+    // Frame em andamento; so a thread de render escreve
+    static FrameStats& current() { return currentFrame; }
+    static const FrameStats& lastFrame();
+    static uint64_t getFrameCount();
+
+    // Fecha o frame: guarda os contadores, mede o tempo desde o endFrame anterior
+    // e, se houver CSV aberto, grava uma linha
+    static void endFrame();
+    static FrameTimeSummary getFrameTimes();
+    static void resetFrameTimes();
+
+    // Chamado pelo profiler de GPU quando as consultas de um frame ficam prontas
+    static void recordGpuFrame(const GpuFrameStats& gpuFrame);
+    static const GpuFrameStats& lastGpuFrame();
+    static FrameTimeSummary getGpuFrameTimes();
+    // GPU-bound quando a GPU ocupa quase todo o intervalo entre frames (p50 contra p50).
+    // Sem amostras de GPU (backend sem timer queries) retorna false.
+    static bool isGpuBound(double threshold = 0.9);
+
+    // Assets vivos por tipo; pode ser chamado de qualquer thread. Texturas so sao
+    // descontadas pelos backends que sabem apaga-las (cubemaps do OpenGL).
+    static void countAsset(AssetType type, int32_t delta) {
+        assetCounts[static_cast<size_t>(type)].fetch_add(delta, std::memory_order_relaxed);
+    }
+    static int32_t getAssetCount(AssetType type) {
+        return assetCounts[static_cast<size_t>(type)].load(std::memory_order_relaxed);
+    }
+
+    // Uma linha por frame ate closeCsv()
+    static bool openCsv(const std::string& path);
+    static void closeCsv();
+
+    // Compara o ultimo frame (e os p95 da janela) com o orcamento. Retorna false se
+    // algum limite foi ultrapassado e, com violations, descreve quais.
+    static bool checkBudget(const FrameBudget& budget, std::string* violations = nullptr);
+};
+
+#endif // ENGINE_STATS_HPP
@@ -0,0 +1,103 @@
+#define CLASS_NAME "GameLoop"
+#include "log_macros.hpp"
+
+#include "game_loop.hpp"
+#include "trace.hpp"
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace {
+// Um frame maior que isso (breakpoint, carga de cena) nao vira uma rajada de passos
+constexpr double MAX_FRAME_SECONDS = 0.25;
+} // namespace
+
+bool GameLoop::shouldSuspend() const {
+    // Lockstep (gravacao/replay de input) avanca um passo por frame de input; pular
+    // passos enquanto os eventos continuam sendo lidos dessincroniza o replay
+    if (!window || settings.lockstep) {
+        return false;
+    }
+    Uint32 flags = SDL_GetWindowFlags(window);
+    if (flags & (SDL_WINDOW_HIDDEN | SDL_WINDOW_MINIMIZED)) {
+        return true;
+    }
+    return settings.suspendWhenUnfocused && !(flags & SDL_WINDOW_INPUT_FOCUS);
+}
+
+void GameLoop::waitUntil(Clock::time_point target) const {
+    TRACE_ZONE("GameLoop::wait");
+    auto spin = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double, std::milli>(settings.spinMilliseconds));
+    if (Clock::now() < target - spin) {
+        std::this_thread::sleep_until(target - spin);
+    }
+    while (Clock::now() < target) {
+        std::this_thread::yield();
+    }
+}
+
+bool GameLoop::tick(const StepCallback& step, const RenderCallback& render) {
+    if (shouldSuspend()) {
+        if (!suspended) {
+            LOG_INFO("Window hidden or unfocused, rendering suspended");
+            suspended = true;
+        }
+        std::this_thread::sleep_for(
+            std::chrono::duration<double, std::milli>(settings.suspendedMilliseconds));
+        return false;
+    }
+
+    Clock::time_point now = Clock::now();
+    if (!started || suspended) {
+        // Recomeca do zero: o tempo suspenso nao vira simulacao
+        if (suspended) {
+            LOG_INFO("Rendering resumed");
+        }
+        lastTime = now;
+        nextFrame = now;
+        accumulator = 0.0;
+        started = true;
+        suspended = false;
+    }
+
+    double dt = getFixedStep();
+    float alpha = 1.0f;
+    if (settings.lockstep) {
+        step(dt);
+        stepCount++;
+    } else {
+        double frameSeconds = std::chrono::duration<double>(now - lastTime).count();
+        accumulator += std::min(frameSeconds, MAX_FRAME_SECONDS);
+        lastTime = now;
+
+        uint32_t steps = 0;
+        while (accumulator >= dt && steps < settings.maxStepsPerFrame) {
+            step(dt);
+            accumulator -= dt;
+            stepCount++;
+            steps++;
+        }
+        // Nao deu para alcancar: descarta o atraso em vez de acumular
+        if (accumulator >= dt) {
+            accumulator = std::fmod(accumulator, dt);
+        }
+        alpha = static_cast<float>(accumulator / dt);
+    }
+
+    render(alpha);
+
+    if (settings.frameRateLimit > 0.0) {
+        auto interval = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / settings.frameRateLimit));
+        nextFrame += interval;
+        // Atrasado mais de um frame: realinha em vez de correr para recuperar
+        Clock::time_point current = Clock::now();
+        if (nextFrame < current - interval) {
+            nextFrame = current;
+        }
+        waitUntil(nextFrame);
+    }
+    return true;
+}
@@ -0,0 +1,62 @@
+#ifndef GAME_LOOP_HPP
+#define GAME_LOOP_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+struct SDL_Window;
+
+// Simulacao em passo fixo com interpolacao, limite de fps e suspensao com a janela
+// escondida. A cada tick o tempo real vira zero ou mais passos de fixedStep segundos e
+// um render com alpha em [0, 1) entre o penultimo e o ultimo passo (1 no lockstep).
+class GameLoop {
+  public:
+    using Clock = std::chrono::steady_clock;
+    using StepCallback = std::function<void(double dt)>;
+    using RenderCallback = std::function<void(float alpha)>;
+
+    struct Settings {
+        double tickRate = 60.0;
+        // 0 = sem limite (so o vsync do backend, se houver)
+        double frameRateLimit = 0.0;
+        // Apos dormir, gira ate o horario exato; o sleep do SO acorda atrasado
+        double spinMilliseconds = 1.0;
+        // Passos por tick antes de descartar o atraso (evita a espiral da morte)
+        uint32_t maxStepsPerFrame = 5;
+        // Exatamente um passo por tick, sem tempo real: mesma sequencia em toda execucao
+        bool lockstep = false;
+        bool suspendWhenUnfocused = true;
+        // Intervalo de espera suspenso; a entrada continua sendo lida nesse ritmo
+        double suspendedMilliseconds = 50.0;
+    };
+
+    GameLoop() = default;
+    explicit GameLoop(const Settings& settings) : settings(settings) {}
+
+    // Sem janela (headless) ou em lockstep nunca suspende
+    void setWindow(SDL_Window* window) { this->window = window; }
+    const Settings& getSettings() const { return settings; }
+    double getFixedStep() const { return 1.0 / settings.tickRate; }
+    uint64_t getStepCount() const { return stepCount; }
+    bool isSuspended() const { return suspended; }
+
+    // Roda os passos devidos e o render (se a janela estiver visivel) e espera o horario
+    // do proximo frame. Retorna false quando o frame foi pulado por suspensao.
+    bool tick(const StepCallback& step, const RenderCallback& render);
+
+  private:
+    Settings settings;
+    SDL_Window* window = nullptr;
+    Clock::time_point lastTime;
+    Clock::time_point nextFrame;
+    double accumulator = 0.0;
+    uint64_t stepCount = 0;
+    bool started = false;
+    bool suspended = false;
+
+    bool shouldSuspend() const;
+    void waitUntil(Clock::time_point target) const;
+};
+
+#endif // GAME_LOOP_HPP
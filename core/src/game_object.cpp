@@ -8,7 +8,7 @@ Transform* GameObject::getTransform() {
     return transform.get(); 
 }
 
-void GameObject::setMesh(std::unique_ptr<Mesh> m) { 
+void GameObject::setMesh(std::shared_ptr<Mesh> m) { 
     mesh = std::move(m); 
 }
 
@@ -70,4 +70,72 @@ const SpriteRenderer* GameObject::getSpriteRenderer() const {
 
 bool GameObject::hasSpriteRenderer() const { 
     return spriteRenderer != nullptr; 
-}
\ No newline at end of file
+}
+
+bool GameObject::getWorldBounds(AABB& box, BoundingSphere& sphere) {
+    AABB localBox;
+    BoundingSphere localSphere;
+    if (hasSprite() && hasSpriteRenderer()) {
+        // Quad unitario escalado pelo tamanho do sprite
+        glm::vec3 half(sprite->getWidth() * 0.5f, sprite->getHeight() * 0.5f, 0.0f);
+        localBox = {-half, half};
+        localSphere = {glm::vec3(0.0f), glm::length(half)};
+    } else if (hasMesh() && hasMeshRenderer()) {
+        localBox = mesh->getBounds();
+        localSphere = mesh->getBoundingSphere();
+    } else {
+        return false;
+    }
+
+    glm::mat4 model = transform ? transform->getModelMatrix() : glm::mat4(1.0f);
+    box = Bounds::transform(localBox, model);
+    sphere = Bounds::transform(localSphere, model);
+    return true;
+}
+
+void GameObject::copyRenderState(const GameObject& source) {
+    if (source.transform) {
+        if (!transform) {
+            transform = std::make_unique<Transform>();
+        }
+        transform->copyWorld(*source.transform);
+    } else {
+        transform.reset();
+    }
+
+    // Compara antes de copiar: evita o incremento atomico dos shared_ptr a cada frame
+    if (mesh != source.mesh) {
+        mesh = source.mesh;
+    }
+
+    if (source.meshRenderer) {
+        if (!meshRenderer) {
+            meshRenderer = std::make_unique<MeshRenderer>();
+        }
+        if (meshRenderer->getMaterial() != source.meshRenderer->getMaterial()) {
+            *meshRenderer = *source.meshRenderer;
+        }
+    } else {
+        meshRenderer.reset();
+    }
+
+    if (source.sprite) {
+        if (!sprite) {
+            sprite = std::make_unique<Sprite>();
+        }
+        *sprite = *source.sprite;
+    } else {
+        sprite.reset();
+    }
+
+    if (source.spriteRenderer) {
+        if (!spriteRenderer) {
+            spriteRenderer = std::make_unique<SpriteRenderer>();
+        }
+        if (spriteRenderer->getMaterial() != source.spriteRenderer->getMaterial()) {
+            *spriteRenderer = *source.spriteRenderer;
+        }
+    } else {
+        spriteRenderer.reset();
+    }
+}
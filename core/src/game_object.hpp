@@ -1,6 +1,7 @@
 #ifndef GAME_OBJECT_HPP
 #define GAME_OBJECT_HPP
 
+#include "bounds.hpp"
 #include "mesh.hpp"
 #include "mesh_renderer.hpp"
 #include "sprite.hpp"
@@ -10,7 +11,8 @@
 
 class GameObject {
   private:
-    std::unique_ptr<Mesh> mesh;
+    // Mesh pode ser compartilhada entre objetos (instancing)
+    std::shared_ptr<Mesh> mesh;
     std::unique_ptr<MeshRenderer> meshRenderer;
     std::unique_ptr<Sprite> sprite;
     std::unique_ptr<SpriteRenderer> spriteRenderer;
@@ -23,7 +25,7 @@ class GameObject {
     void setTransform(std::unique_ptr<Transform> t);
     Transform* getTransform();
 
-    void setMesh(std::unique_ptr<Mesh> m);
+    void setMesh(std::shared_ptr<Mesh> m);
     Mesh* getMesh();
     const Mesh* getMesh() const;
     bool hasMesh() const;
@@ -42,6 +44,15 @@ class GameObject {
     SpriteRenderer* getSpriteRenderer();
     const SpriteRenderer* getSpriteRenderer() const;
     bool hasSpriteRenderer() const;
+
+    // Volumes em espaco de mundo da mesh ou do quad do sprite; false se o objeto
+    // nao tem nada para desenhar
+    bool getWorldBounds(AABB& box, BoundingSphere& sphere);
+
+    // Copia a pose de mundo, o sprite e as referencias de mesh/material de source (proxy
+    // da thread de render, sem hierarquia). Os recursos sao compartilhados, nunca
+    // duplicados.
+    void copyRenderState(const GameObject& source);
 };
 
 #endif
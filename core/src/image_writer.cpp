@@ -0,0 +1,36 @@
+#define CLASS_NAME "ImageWriter"
+#include "image_writer.hpp"
+#include "log_macros.hpp"
+#include <fstream>
+#include <vector>
+
+namespace ImageWriter {
+
+bool writePPM(const std::string& path, const uint8_t* rgba, int width, int height) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        LOG_ERROR("Failed to open " + path);
+        return false;
+    }
+
+    file << "P6\n" << width << " " << height << "\n255\n";
+
+    std::vector<uint8_t> row(static_cast<size_t>(width) * 3);
+    for (int y = 0; y < height; y++) {
+        const uint8_t* src = rgba + static_cast<size_t>(y) * width * 4;
+        for (int x = 0; x < width; x++) {
+            row[x * 3 + 0] = src[x * 4 + 0];
+            row[x * 3 + 1] = src[x * 4 + 1];
+            row[x * 3 + 2] = src[x * 4 + 2];
+        }
+        file.write(reinterpret_cast<const char*>(row.data()), row.size());
+    }
+
+    if (!file) {
+        LOG_ERROR("Failed to write " + path);
+        return false;
+    }
+    return true;
+}
+
+} // namespace ImageWriter
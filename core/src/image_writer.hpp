@@ -0,0 +1,14 @@
+#ifndef IMAGE_WRITER_HPP
+#define IMAGE_WRITER_HPP
+
+#include <cstdint>
+#include <string>
+
+namespace ImageWriter {
+
+// Grava RGBA8 (linhas de cima para baixo) como PPM binario; o alpha e descartado
+bool writePPM(const std::string& path, const uint8_t* rgba, int width, int height);
+
+} // namespace ImageWriter
+
+#endif // IMAGE_WRITER_HPP
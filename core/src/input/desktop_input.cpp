@@ -1,19 +1,48 @@
 #include "desktop_input.hpp"
 #include <SDL_keycode.h>
 
+Yume::DesktopInput::~DesktopInput() { recorder.finish(frame); }
+
+bool Yume::DesktopInput::startRecording(const std::string& path) {
+    frame = 0;
+    recordStart = SDL_GetTicks();
+    return recorder.open(path);
+}
+
+void Yume::DesktopInput::record(InputEventType type, const SDL_Event& event) {
+    if (!recorder.isOpen()) {
+        return;
+    }
+    RecordedInputEvent recorded;
+    recorded.frame = frame;
+    recorded.timeMs = event.common.timestamp > recordStart ? event.common.timestamp - recordStart : 0;
+    recorded.type = type;
+    if (type != InputEventType::QUIT) {
+        recorded.key = event.key.keysym.sym;
+        recorded.modifiers = event.key.keysym.mod;
+    }
+    recorder.record(recorded);
+}
+
 void Yume::DesktopInput::processEvents() {
     SDL_Event event;
     while (SDL_PollEvent(&event)) {
         if (event.type == SDL_QUIT) {
+            record(InputEventType::QUIT, event);
             quit_requested = true;
         }
+        if (event.type == SDL_KEYUP) {
+            record(InputEventType::KEY_UP, event);
+        }
         if (event.type == SDL_KEYDOWN) {
+            record(InputEventType::KEY_DOWN, event);
             auto it = key_bindings.find(event.key.keysym.sym);
             if (it != key_bindings.end()) {
                 it->second();
             }
         }
     }
+    frame++;
 }
 
 bool Yume::DesktopInput::getQuitEvent() { 
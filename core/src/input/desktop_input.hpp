@@ -3,23 +3,35 @@
 
 #include "i_input.hpp"
 #include "input_key.hpp"
+#include "input_recording.hpp"
 #include <SDL_keycode.h>
 #include <functional>
 
 namespace Yume {
 class DesktopInput : public IInput {
-
+  public:
     using ActionCallback = std::function<void()>;
 
+    ~DesktopInput() override;
+
     void processEvents() override;
     void bindKey(KeyCode key, ActionCallback callback) override;
     bool getQuitEvent() override;
     void requestQuit() override;
 
+    // Grava os eventos de cada frame em path para o ReplayInput reproduzir
+    bool startRecording(const std::string& path);
+
   private:
     bool quit_requested = false;
     std::unordered_map<KeyCode, ActionCallback> key_bindings;
+
+    InputRecorder recorder;
+    uint64_t frame = 0;
+    uint32_t recordStart = 0;
+
+    void record(InputEventType type, const SDL_Event& event);
 };
 } // namespace Yume
 
-#endif
\ No newline at end of file
+#endif
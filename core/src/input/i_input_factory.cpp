@@ -1,7 +1,31 @@
 #include "i_input_factory.hpp"
 #include "desktop_input.hpp"
 #include "i_input.hpp"
+#include "replay_input.hpp"
+#include <cstdio>
+#include <cstdlib>
 
 Yume::IInput* Yume::IInputFactory::create() {
-    return new DesktopInput;
+#ifndef PLATFORM_WEBGL
+    // YUME_INPUT_REPLAY=arquivo reproduz uma gravacao feita com YUME_INPUT_RECORD=arquivo
+    if (const char* path = std::getenv("YUME_INPUT_REPLAY")) {
+        auto replay = new ReplayInput;
+        if (replay->load(path)) {
+            return replay;
+        }
+        // O logger ainda nao foi iniciado quando a entrada e criada
+        std::fprintf(stderr, "Unable to replay input from %s\n", path);
+        delete replay;
+    }
+#endif
+
+    auto input = new DesktopInput;
+#ifndef PLATFORM_WEBGL
+    if (const char* path = std::getenv("YUME_INPUT_RECORD")) {
+        if (!input->startRecording(path)) {
+            std::fprintf(stderr, "Unable to record input to %s\n", path);
+        }
+    }
+#endif
+    return input;
 }
@@ -0,0 +1,107 @@
+#define CLASS_NAME "InputRecorder"
+#include "../log_macros.hpp"
+
+#include "input_recording.hpp"
+#include <algorithm>
+#include <sstream>
+
+namespace {
+constexpr const char* HEADER = "yume-input 1";
+
+const char* eventName(Yume::InputEventType type) {
+    switch (type) {
+    case Yume::InputEventType::KEY_DOWN:
+        return "down";
+    case Yume::InputEventType::KEY_UP:
+        return "up";
+    default:
+        return "quit";
+    }
+}
+} // namespace
+
+bool Yume::InputRecorder::open(const std::string& path) {
+    file.open(path, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+        LOG_ERROR("Unable to record input to " + path);
+        return false;
+    }
+    file << HEADER << '\n';
+    return true;
+}
+
+void Yume::InputRecorder::record(const RecordedInputEvent& event) {
+    if (!file.is_open()) {
+        return;
+    }
+    // Flush a cada evento: sao raros e a gravacao sobrevive a um crash
+    file << event.frame << ' ' << event.timeMs << ' ' << eventName(event.type) << ' '
+         << event.key << ' ' << event.modifiers << std::endl;
+}
+
+void Yume::InputRecorder::finish(uint64_t frameCount) {
+    if (!file.is_open()) {
+        return;
+    }
+    file << frameCount << " end" << std::endl;
+    file.close();
+}
+
+bool Yume::readInputRecording(const std::string& path, std::vector<RecordedInputEvent>& events,
+                              uint64_t& frameCount) {
+    std::ifstream file(path);
+    std::string line;
+    if (!std::getline(file, line) || line != HEADER) {
+        LOG_ERROR("Not an input recording: " + path);
+        return false;
+    }
+
+    events.clear();
+    frameCount = 0;
+    bool ended = false;
+    for (int lineNumber = 2; std::getline(file, line); lineNumber++) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        std::istringstream fields(line);
+        RecordedInputEvent event;
+        std::string type;
+        if (!(fields >> event.frame)) {
+            LOG_ERROR(path + ":" + std::to_string(lineNumber) + ": expected a frame number");
+            return false;
+        }
+        fields >> std::ws;
+        if (fields.peek() == 'e') {
+            frameCount = event.frame;
+            ended = true;
+            break;
+        }
+
+        if (!(fields >> event.timeMs >> type >> event.key >> event.modifiers)) {
+            LOG_ERROR(path + ":" + std::to_string(lineNumber) + ": malformed event");
+            return false;
+        }
+        if (type == "down") {
+            event.type = InputEventType::KEY_DOWN;
+        } else if (type == "up") {
+            event.type = InputEventType::KEY_UP;
+        } else if (type == "quit") {
+            event.type = InputEventType::QUIT;
+        } else {
+            LOG_ERROR(path + ":" + std::to_string(lineNumber) + ": unknown event " + type);
+            return false;
+        }
+        events.push_back(event);
+    }
+
+    // Editadas a mao podem vir fora de ordem; stable mantem a ordem dentro do frame
+    std::stable_sort(events.begin(), events.end(),
+                     [](const RecordedInputEvent& a, const RecordedInputEvent& b) {
+                         return a.frame < b.frame;
+                     });
+    if (!ended) {
+        frameCount = events.empty() ? 0 : events.back().frame + 1;
+    }
+    return true;
+}
@@ -0,0 +1,47 @@
+#ifndef INPUT_RECORDING_HPP
+#define INPUT_RECORDING_HPP
+
+#include "input_key.hpp"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Gravacao de entrada em texto, uma linha por evento, facil de editar a mao:
+//   yume-input 1
+//   <frame> <ms> down|up|quit <tecla> <modificadores>
+//   <frame> end
+// frame e a chamada de processEvents em que o evento chegou (0 = primeiro frame) e ms o
+// tempo desde o inicio da gravacao, so informativo: o replay segue os frames.
+namespace Yume {
+
+enum class InputEventType : uint8_t { KEY_DOWN, KEY_UP, QUIT };
+
+struct RecordedInputEvent {
+    uint64_t frame = 0;
+    uint32_t timeMs = 0;
+    InputEventType type = InputEventType::KEY_DOWN;
+    KeyCode key = 0;
+    uint16_t modifiers = 0;
+};
+
+class InputRecorder {
+  private:
+    std::ofstream file;
+
+  public:
+    bool open(const std::string& path);
+    bool isOpen() const { return file.is_open(); }
+    void record(const RecordedInputEvent& event);
+    // Marca o total de frames; o replay pede para sair depois do ultimo
+    void finish(uint64_t frameCount);
+};
+
+// Eventos em ordem de frame; frameCount e o do "end" (ou o frame do ultimo evento + 1
+// se a gravacao foi interrompida)
+bool readInputRecording(const std::string& path, std::vector<RecordedInputEvent>& events,
+                        uint64_t& frameCount);
+
+} // namespace Yume
+
+#endif // INPUT_RECORDING_HPP
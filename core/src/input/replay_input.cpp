@@ -0,0 +1,49 @@
+#define CLASS_NAME "ReplayInput"
+#include "../log_macros.hpp"
+
+#include "replay_input.hpp"
+
+bool Yume::ReplayInput::load(const std::string& path) {
+    if (!readInputRecording(path, events, frameCount)) {
+        return false;
+    }
+    nextEvent = 0;
+    frame = 0;
+    LOG_INFO("Replaying " + std::to_string(events.size()) + " input events over " +
+             std::to_string(frameCount) + " frames from " + path);
+    return true;
+}
+
+void Yume::ReplayInput::processEvents() {
+    // A fila do SDL continua sendo esvaziada; so fechar a janela e atendido
+    SDL_Event event;
+    while (SDL_PollEvent(&event)) {
+        if (event.type == SDL_QUIT) {
+            quit_requested = true;
+        }
+    }
+
+    for (; nextEvent < events.size() && events[nextEvent].frame <= frame; nextEvent++) {
+        const RecordedInputEvent& recorded = events[nextEvent];
+        if (recorded.type == InputEventType::QUIT) {
+            quit_requested = true;
+        } else if (recorded.type == InputEventType::KEY_DOWN) {
+            auto it = key_bindings.find(recorded.key);
+            if (it != key_bindings.end()) {
+                it->second();
+            }
+        }
+    }
+
+    if (++frame >= frameCount) {
+        quit_requested = true;
+    }
+}
+
+bool Yume::ReplayInput::getQuitEvent() { return quit_requested; }
+
+void Yume::ReplayInput::requestQuit() { quit_requested = true; }
+
+void Yume::ReplayInput::bindKey(KeyCode key, ActionCallback callback) {
+    key_bindings[key] = callback;
+}
@@ -0,0 +1,38 @@
+#ifndef REPLAY_INPUT_HPP
+#define REPLAY_INPUT_HPP
+
+#include "i_input.hpp"
+#include "input_recording.hpp"
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Yume {
+// Reproduz uma gravacao do DesktopInput: a cada processEvents (um por frame) dispara
+// os eventos gravados naquele frame, ignorando o teclado real. Depois do ultimo frame
+// gravado pede para sair, entao a execucao tem sempre o mesmo numero de frames.
+class ReplayInput : public IInput {
+  public:
+    using ActionCallback = std::function<void()>;
+
+    bool load(const std::string& path);
+
+    void processEvents() override;
+    void bindKey(KeyCode key, ActionCallback callback) override;
+    bool getQuitEvent() override;
+    void requestQuit() override;
+
+    uint64_t getFrame() const { return frame; }
+
+  private:
+    bool quit_requested = false;
+    std::unordered_map<KeyCode, ActionCallback> key_bindings;
+    std::vector<RecordedInputEvent> events;
+    size_t nextEvent = 0;
+    uint64_t frame = 0;
+    uint64_t frameCount = 0;
+};
+} // namespace Yume
+
+#endif // REPLAY_INPUT_HPP
@@ -0,0 +1,344 @@
+#include "job_system.hpp"
+#include "trace.hpp"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+std::atomic<Yume::JobSystem*> g_shared{nullptr};
+
+// Pool e indice da thread atual, se ela for um worker
+thread_local Yume::JobSystem* t_system = nullptr;
+thread_local size_t t_worker = 0;
+} // namespace
+
+Yume::JobCounter::~JobCounter() {
+    // Espera o finish() que zerou o contador soltar o mutex
+    std::lock_guard<std::mutex> lock(mutex);
+}
+
+void Yume::JobCounter::JobQueue::pushBack(Job job) {
+    if (size == ring.size()) {
+        std::vector<Job> grown(std::max<size_t>(16, ring.size() * 2));
+        for (size_t i = 0; i < size; i++) {
+            grown[i] = std::move(ring[(head + i) % ring.size()]);
+        }
+        ring.swap(grown);
+        head = 0;
+    }
+    ring[(head + size) % ring.size()] = std::move(job);
+    size++;
+}
+
+Yume::JobCounter::Job Yume::JobCounter::JobQueue::popBack() {
+    size--;
+    return std::move(ring[(head + size) % ring.size()]);
+}
+
+Yume::JobCounter::Job Yume::JobCounter::JobQueue::popFront() {
+    Job job = std::move(ring[head]);
+    head = (head + 1) % ring.size();
+    size--;
+    return job;
+}
+
+Yume::JobSystem::JobSystem(size_t workerCount) : mainThread(std::this_thread::get_id()) {
+    if (workerCount == 0) {
+        size_t hw = std::thread::hardware_concurrency();
+        workerCount = hw > 1 ? hw - 1 : 1;
+    }
+    this->workerCount = workerCount;
+}
+
+Yume::JobSystem::~JobSystem() {
+    if (workers.empty()) {
+        return;
+    }
+    // Os workers esvaziam as filas antes de sair
+    stopping = true;
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    sleepCondition.notify_all();
+    for (auto& worker : workers) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+Yume::JobSystem& Yume::JobSystem::shared() {
+    if (JobSystem* jobs = g_shared.load(std::memory_order_acquire)) {
+        return *jobs;
+    }
+    static JobSystem fallback;
+    return fallback;
+}
+
+void Yume::JobSystem::setShared(JobSystem* jobs) { g_shared.store(jobs, std::memory_order_release); }
+
+void Yume::JobSystem::start() {
+    // Todas as filas existem antes da primeira thread tentar roubar
+    workers.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; i++) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    for (size_t i = 0; i < workerCount; i++) {
+        workers[i]->thread = std::thread(&JobSystem::workerLoop, this, i);
+    }
+}
+
+void Yume::JobSystem::run(JobFunction function, JobCounter* counter) {
+    if (counter) {
+        counter->value.fetch_add(1, std::memory_order_relaxed);
+    }
+    push(Job{std::move(function), counter});
+}
+
+void Yume::JobSystem::runAfter(JobCounter& dependency, JobFunction function,
+                               JobCounter* counter) {
+    if (counter) {
+        counter->value.fetch_add(1, std::memory_order_relaxed);
+    }
+    Job job{std::move(function), counter};
+    {
+        std::lock_guard<std::mutex> lock(dependency.mutex);
+        if (dependency.value.load(std::memory_order_acquire) != 0) {
+            dependency.waiting.push_back(std::move(job));
+            return;
+        }
+    }
+    push(std::move(job));
+}
+
+void Yume::JobSystem::runOnMainThread(JobFunction function, JobCounter* counter) {
+    if (counter) {
+        counter->value.fetch_add(1, std::memory_order_relaxed);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mainMutex);
+        mainJobs.pushBack(Job{std::move(function), counter});
+    }
+    // Acorda a thread principal se ela estiver em wait()
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    sleepCondition.notify_all();
+}
+
+void Yume::JobSystem::push(Job job) {
+    std::call_once(startFlag, [this]() { start(); });
+
+    // Conta com o mutex da fila: quem tira o job (e decrementa) ve o incremento antes
+    if (t_system == this) {
+        Worker& own = *workers[t_worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        own.jobs.pushBack(std::move(job));
+        queuedJobs.fetch_add(1, std::memory_order_release);
+    } else {
+        std::lock_guard<std::mutex> lock(globalMutex);
+        globalJobs.pushBack(std::move(job));
+        queuedJobs.fetch_add(1, std::memory_order_release);
+    }
+
+    // Com o mutex: um worker entre o teste do predicado e o wait nao perde o aviso
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    sleepCondition.notify_one();
+}
+
+bool Yume::JobSystem::takeJob(Job& job) {
+    if (queuedJobs.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+
+    size_t first = 0;
+    if (t_system == this) {
+        // Propria fila pelo fim: o job mais recente, com os dados ainda no cache
+        Worker& own = *workers[t_worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            job = own.jobs.popBack();
+            queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+        first = t_worker + 1;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(globalMutex);
+        if (!globalJobs.empty()) {
+            job = globalJobs.popFront();
+            queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    // Roubo pelo inicio, o job mais antigo (em geral o maior pedaco restante)
+    for (size_t i = 0; i < workers.size(); i++) {
+        Worker& victim = *workers[(first + i) % workers.size()];
+        if (t_system == this && &victim == workers[t_worker].get()) {
+            continue;
+        }
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = victim.jobs.popFront();
+            queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void Yume::JobSystem::execute(Job& job) {
+    job.function();
+    // Solta as capturas antes de o contador liberar quem espera
+    job.function = nullptr;
+    finish(job.counter);
+}
+
+void Yume::JobSystem::finish(JobCounter* counter) {
+    if (!counter) {
+        return;
+    }
+
+    std::vector<Job> released;
+    bool done = false;
+    {
+        std::lock_guard<std::mutex> lock(counter->mutex);
+        if (counter->value.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            released.swap(counter->waiting);
+            done = true;
+        }
+    }
+    // Daqui em diante o contador pode ja ter sido destruido
+
+    for (Job& job : released) {
+        push(std::move(job));
+    }
+    if (done) {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+        }
+        sleepCondition.notify_all();
+    }
+}
+
+void Yume::JobSystem::wait(JobCounter& counter) {
+    if (counter.isDone()) {
+        return;
+    }
+    TRACE_ZONE("JobSystem::wait");
+    std::call_once(startFlag, [this]() { start(); });
+
+    bool mainThread = isMainThread();
+    while (!counter.isDone()) {
+        Job job;
+        if (takeJob(job)) {
+            execute(job);
+            continue;
+        }
+        if (mainThread) {
+            runMainThreadJobs();
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        // O timeout cobre jobs de afinidade, que nao contam em queuedJobs
+        sleepCondition.wait_for(lock, std::chrono::milliseconds(1), [&]() {
+            return counter.isDone() || queuedJobs.load(std::memory_order_acquire) > 0;
+        });
+    }
+}
+
+void Yume::JobSystem::parallelFor(size_t count, size_t grain, const RangeFunction& function) {
+    if (count == 0) {
+        return;
+    }
+    if (grain == 0) {
+        grain = std::max<size_t>(1, count / ((workerCount + 1) * 4));
+    }
+    size_t chunks = (count + grain - 1) / grain;
+    if (chunks == 1) {
+        function(0, count);
+        return;
+    }
+
+    // Poucos jobs que disputam os blocos por um indice atomico: balanceia sozinho e a
+    // lambda cabe no buffer interno do std::function (sem alocar por frame)
+    struct Range {
+        const RangeFunction* function;
+        size_t count;
+        size_t grain;
+        std::atomic<size_t> next{0};
+    } range{&function, count, grain};
+
+    auto work = [&range]() {
+        for (size_t begin = range.next.fetch_add(range.grain); begin < range.count;
+             begin = range.next.fetch_add(range.grain)) {
+            (*range.function)(begin, std::min(range.count, begin + range.grain));
+        }
+    };
+
+    JobCounter counter;
+    size_t helpers = std::min(chunks - 1, workerCount);
+    for (size_t i = 0; i < helpers; i++) {
+        run(work, &counter);
+    }
+    work();
+    wait(counter);
+}
+
+void Yume::JobSystem::setMainThread() { mainThread = std::this_thread::get_id(); }
+
+bool Yume::JobSystem::isMainThread() const { return mainThread.load() == std::this_thread::get_id(); }
+
+void Yume::JobSystem::runMainThreadJobs() {
+    if (!isMainThread()) {
+        return;
+    }
+
+    // So os que ja estavam na fila: um job que se reenfileira roda no proximo frame.
+    // Um job de afinidade esperando em wait chega aqui de novo com mainJobsRunning em
+    // uso; so nesse caso a fila e local (e mainJobs realoca o anel no proximo push).
+    JobQueue nested;
+    JobQueue& jobs = runningMainJobs ? nested : mainJobsRunning;
+    {
+        std::lock_guard<std::mutex> lock(mainMutex);
+        if (mainJobs.empty()) {
+            return;
+        }
+        std::swap(jobs, mainJobs);
+    }
+
+    bool outer = !runningMainJobs;
+    runningMainJobs = true;
+    while (!jobs.empty()) {
+        Job job = jobs.popFront();
+        execute(job);
+    }
+    if (outer) {
+        runningMainJobs = false;
+    }
+}
+
+void Yume::JobSystem::workerLoop(size_t index) {
+    t_system = this;
+    t_worker = index;
+    Trace::setThreadName("Job worker");
+
+    for (;;) {
+        Job job;
+        if (takeJob(job)) {
+            execute(job);
+            continue;
+        }
+        if (stopping) {
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepCondition.wait(lock, [this]() {
+            return queuedJobs.load(std::memory_order_acquire) > 0 || stopping;
+        });
+    }
+}
@@ -0,0 +1,146 @@
+#ifndef JOB_SYSTEM_HPP
+#define JOB_SYSTEM_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Yume {
+
+class JobSystem;
+
+// Conta os jobs pendentes de um grupo: run(..., &counter) incrementa, o fim do job
+// decrementa. Serve para esperar (JobSystem::wait) e como dependencia (runAfter).
+// Nao pode ser destruido com jobs pendentes.
+class JobCounter {
+  public:
+    JobCounter() = default;
+    ~JobCounter();
+
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    bool isDone() const { return value.load(std::memory_order_acquire) == 0; }
+
+  private:
+    friend class JobSystem;
+
+    struct Job {
+        std::function<void()> function;
+        JobCounter* counter = nullptr;
+    };
+
+    // Fila dupla sobre um anel que so cresce: depois do aquecimento push/pop nao
+    // alocam (std::deque aloca e libera blocos ao cruzar fronteiras)
+    class JobQueue {
+      private:
+        std::vector<Job> ring;
+        size_t head = 0;
+        size_t size = 0;
+
+      public:
+        bool empty() const { return size == 0; }
+        void pushBack(Job job);
+        Job popBack();
+        Job popFront();
+    };
+
+    std::atomic<int32_t> value{0};
+    std::mutex mutex;
+    // Jobs de runAfter esperando este contador zerar
+    std::vector<Job> waiting;
+};
+
+// Agendador unico da engine: uma thread por nucleo (menos a principal), cada uma com a
+// propria fila. A dona empilha e desempilha no fim (LIFO, cache quente); threads sem
+// trabalho roubam do inicio das outras. Jobs enviados de fora do pool (principal,
+// render) vao para uma fila global.
+//
+// Quem espera (wait, parallelFor) executa jobs enquanto o contador nao zera, entao
+// jobs podem criar e esperar outros jobs sem travar o pool.
+//
+// Jobs com afinidade (runOnMainThread) so rodam na thread registrada por
+// setMainThread, a dona do contexto grafico (a de render, quando existe), em
+// runMainThreadJobs ou enquanto ela espera.
+class JobSystem {
+  public:
+    using JobFunction = std::function<void()>;
+    using RangeFunction = std::function<void(size_t begin, size_t end)>;
+
+    // workerCount == 0 usa hardware_concurrency() - 1 (minimo 1). As threads so sobem
+    // no primeiro job, entao a engine pode ser construida em inicializacao estatica.
+    explicit JobSystem(size_t workerCount = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // O do Yume::Context vivo; sem Context (ferramentas, benchmarks) um global
+    static JobSystem& shared();
+    static void setShared(JobSystem* jobs);
+
+    size_t getWorkerCount() const { return workerCount; }
+
+    void run(JobFunction function, JobCounter* counter = nullptr);
+    // Enfileira function so depois que dependency zerar
+    void runAfter(JobCounter& dependency, JobFunction function, JobCounter* counter = nullptr);
+    void runOnMainThread(JobFunction function, JobCounter* counter = nullptr);
+
+    // Executa outros jobs ate counter zerar
+    void wait(JobCounter& counter);
+    // Divide [0, count) em blocos de grain (0 = automatico) e espera todos; a thread
+    // chamadora executa o primeiro bloco
+    void parallelFor(size_t count, size_t grain, const RangeFunction& function);
+
+    // Marca a thread atual como dona dos jobs com afinidade
+    void setMainThread();
+    bool isMainThread() const;
+    void runMainThreadJobs();
+
+  private:
+    using Job = JobCounter::Job;
+    using JobQueue = JobCounter::JobQueue;
+
+    struct Worker {
+        std::thread thread;
+        std::mutex mutex;
+        JobQueue jobs;
+    };
+
+    size_t workerCount = 0;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::once_flag startFlag;
+
+    std::mutex globalMutex;
+    JobQueue globalJobs;
+    std::mutex mainMutex;
+    JobQueue mainJobs;
+    // Trocada com mainJobs em runMainThreadJobs; as duas mantem o anel entre frames
+    JobQueue mainJobsRunning;
+    // So a thread principal le e escreve
+    bool runningMainJobs = false;
+    std::atomic<std::thread::id> mainThread;
+
+    // Jobs nas filas (sem os de afinidade), para as threads saberem quando dormir
+    std::atomic<size_t> queuedJobs{0};
+    std::mutex sleepMutex;
+    std::condition_variable sleepCondition;
+    std::atomic<bool> stopping{false};
+
+    void start();
+    void push(Job job);
+    bool takeJob(Job& job);
+    void execute(Job& job);
+    void finish(JobCounter* counter);
+    void workerLoop(size_t index);
+};
+
+} // namespace Yume
+
+#endif // JOB_SYSTEM_HPP
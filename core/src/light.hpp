@@ -9,7 +9,9 @@ enum class LightType : uint8_t { DIRECTIONAL = 0, POINT = 1, SPOT = 2 };
 struct Light {
     LightType type;
     Vector3 direction;
-    // float position[3];
+    // Usados por POINT e SPOT para achar os objetos atingidos
+    Vector3 position = {0.0f, 0.0f, 0.0f};
+    float range = 10.0f;
 };
 
 #endif
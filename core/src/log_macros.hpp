@@ -4,10 +4,43 @@
 #include "logger.hpp"
 #include <string>
 
-#define LOG_INFO(msg) Logger::log(CLASS_NAME, __func__, (std::string("[INFO] ") + msg).c_str())
+// Niveis abaixo de YUME_LOG_MIN_LEVEL (0 info, 1 warn, 2 error, 3 nenhum) nao geram
+// codigo (o if constante ainda checa a mensagem e evita avisos de variavel sem uso);
+// nos demais a mensagem so e montada se o nivel estiver ligado em tempo de execucao
+#ifndef YUME_LOG_MIN_LEVEL
+#define YUME_LOG_MIN_LEVEL 0
+#endif
+
+#define LOG_AT(level, msg)                                                                 \
+    do {                                                                                   \
+        if (Logger::isEnabled(level)) {                                                    \
+            Logger::write(level, CLASS_NAME, __func__, LogText() + msg);                   \
+        }                                                                                  \
+    } while (0)
 
-#define LOG_WARN(msg) Logger::log(CLASS_NAME, __func__, (std::string("[WARN] ") + msg).c_str())
+#define LOG_DISABLED(level, msg)                                                           \
+    do {                                                                                   \
+        if (false) {                                                                       \
+            Logger::write(level, CLASS_NAME, __func__, LogText() + msg);                   \
+        }                                                                                  \
+    } while (0)
+
+#if YUME_LOG_MIN_LEVEL <= 0
+#define LOG_INFO(msg) LOG_AT(LogLevel::INFO, msg)
+#else
+#define LOG_INFO(msg) LOG_DISABLED(LogLevel::INFO, msg)
+#endif
 
-#define LOG_ERROR(msg) Logger::log(CLASS_NAME, __func__, (std::string("[ERROR] ") + msg).c_str())
+#if YUME_LOG_MIN_LEVEL <= 1
+#define LOG_WARN(msg) LOG_AT(LogLevel::WARN, msg)
+#else
+#define LOG_WARN(msg) LOG_DISABLED(LogLevel::WARN, msg)
+#endif
+
+#if YUME_LOG_MIN_LEVEL <= 2
+#define LOG_ERROR(msg) LOG_AT(LogLevel::ERR, msg)
+#else
+#define LOG_ERROR(msg) LOG_DISABLED(LogLevel::ERR, msg)
+#endif
 
 #endif
@@ -1,45 +1,332 @@
 #include "logger.hpp"
+#include <algorithm>
 #include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <ctime>
 #include <fstream>
-#include <iomanip>
+#include <memory>
 #include <mutex>
-#include <sstream>
-#include <string>
+#include <thread>
+#include <vector>
 
+namespace {
+using SystemClock = std::chrono::system_clock;
 
-static std::ofstream g_logFile;
-static std::mutex g_logMutex;
+// Cabecalho de cada registro no ring; o texto vem logo depois
+struct RecordHeader {
+    const char* className;
+    const char* methodName;
+    int64_t timestamp; // ns desde a epoch
+    uint32_t length;
+    LogLevel level;
+};
 
-static std::string formatDateTime(const char* format) {
-    using namespace std::chrono;
-    auto now = system_clock::now();
-    auto time = system_clock::to_time_t(now);
+constexpr size_t RECORD_ALIGNMENT = 8;
+constexpr auto FLUSH_INTERVAL = std::chrono::milliseconds(20);
+// Tentativas de esperar a thread de escrita antes de descartar a mensagem
+constexpr int FULL_RING_RETRIES = 1000;
+
+// Ring de um produtor (a thread dona) e um consumidor (a thread de escrita)
+struct LogRing {
+    static constexpr uint64_t CAPACITY = 64 * 1024; // potencia de 2
+    // Maior texto aceito; o resto e cortado
+    static constexpr uint32_t MAX_MESSAGE = CAPACITY / 4;
+
+    alignas(64) std::atomic<uint64_t> head{0};
+    alignas(64) std::atomic<uint64_t> tail{0};
+    // A thread dona terminou; o ring e liberado depois de esvaziado
+    std::atomic<bool> retired{false};
+    uint8_t data[CAPACITY];
+
+    void copyIn(uint64_t position, const void* source, size_t size) {
+        size_t offset = position & (CAPACITY - 1);
+        size_t first = std::min<size_t>(size, CAPACITY - offset);
+        std::memcpy(data + offset, source, first);
+        std::memcpy(data, static_cast<const uint8_t*>(source) + first, size - first);
+    }
+
+    void copyOut(uint64_t position, void* destination, size_t size) const {
+        size_t offset = position & (CAPACITY - 1);
+        size_t first = std::min<size_t>(size, CAPACITY - offset);
+        std::memcpy(destination, data + offset, first);
+        std::memcpy(static_cast<uint8_t*>(destination) + first, data, size - first);
+    }
+};
+
+struct RingHandle {
+    LogRing* ring = nullptr;
+    ~RingHandle() {
+        if (ring) {
+            ring->retired.store(true, std::memory_order_release);
+        }
+    }
+};
+
+// Registro copiado para fora do ring, esperando formatacao
+struct PendingRecord {
+    RecordHeader header;
+    size_t textOffset;
+};
+
+std::mutex g_registryMutex;
+std::vector<std::unique_ptr<LogRing>> g_rings;
+thread_local RingHandle t_ring;
+
+std::ofstream g_logFile;
+std::thread g_writer;
+std::mutex g_wakeMutex;
+std::condition_variable g_wake;
+bool g_running = false;
+std::atomic<uint64_t> g_dropped{0};
+// Nivel pedido por setLevel; vale quando houver arquivo aberto
+std::atomic<uint8_t> g_requestedLevel{static_cast<uint8_t>(LogLevel::INFO)};
+
+// Estado da thread de escrita
+std::vector<PendingRecord> g_pending;
+std::string g_texts;
+std::string g_output;
+std::time_t g_cachedSecond = -1;
+std::string g_cachedDate;
+
+LogRing* currentRing() {
+    if (t_ring.ring) {
+        return t_ring.ring;
+    }
+
+    // Primeira mensagem desta thread: unico ponto com lock no lado do produtor
+    std::lock_guard<std::mutex> lock(g_registryMutex);
+    g_rings.push_back(std::make_unique<LogRing>());
+    t_ring.ring = g_rings.back().get();
+    return t_ring.ring;
+}
+
+void wakeWriter() { g_wake.notify_one(); }
+
+const char* levelTag(LogLevel level) {
+    switch (level) {
+    case LogLevel::INFO:
+        return "[INFO] ";
+    case LogLevel::WARN:
+        return "[WARN] ";
+    case LogLevel::ERR:
+        return "[ERROR] ";
+    default:
+        return "";
+    }
+}
+
+std::string formatDateTime(std::time_t time, const char* format) {
     std::tm tm{};
 #ifdef _WIN32
     localtime_s(&tm, &time);
 #else
     localtime_r(&time, &tm);
 #endif
-    std::ostringstream oss;
-    oss << std::put_time(&tm, format);
-    return oss.str();
+    char buffer[64];
+    size_t length = std::strftime(buffer, sizeof(buffer), format, &tm);
+    return std::string(buffer, length);
+}
+
+// localtime + strftime so quando o segundo muda
+const std::string& cachedDate(int64_t timestampNs) {
+    std::time_t second = static_cast<std::time_t>(timestampNs / 1000000000);
+    if (second != g_cachedSecond) {
+        g_cachedDate = formatDateTime(second, "%Y-%m-%d %H:%M:%S");
+        g_cachedSecond = second;
+    }
+    return g_cachedDate;
+}
+
+// Copia tudo que esta publicado nos rings, libera o espaco e grava em ordem de tempo
+void drain() {
+    g_pending.clear();
+    g_texts.clear();
+    {
+        std::lock_guard<std::mutex> lock(g_registryMutex);
+        for (auto it = g_rings.begin(); it != g_rings.end();) {
+            LogRing& ring = **it;
+            bool retired = ring.retired.load(std::memory_order_acquire);
+            uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+            uint64_t head = ring.head.load(std::memory_order_acquire);
+
+            while (tail < head) {
+                PendingRecord record;
+                ring.copyOut(tail, &record.header, sizeof(RecordHeader));
+                record.textOffset = g_texts.size();
+                g_texts.resize(g_texts.size() + record.header.length);
+                ring.copyOut(tail + sizeof(RecordHeader), &g_texts[record.textOffset],
+                             record.header.length);
+                g_pending.push_back(record);
+
+                size_t size = sizeof(RecordHeader) + record.header.length;
+                tail += (size + RECORD_ALIGNMENT - 1) / RECORD_ALIGNMENT * RECORD_ALIGNMENT;
+            }
+            ring.tail.store(tail, std::memory_order_release);
+
+            if (retired) {
+                it = g_rings.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    if (g_pending.empty()) {
+        return;
+    }
+
+    std::stable_sort(g_pending.begin(), g_pending.end(),
+                     [](const PendingRecord& a, const PendingRecord& b) {
+                         return a.header.timestamp < b.header.timestamp;
+                     });
+
+    g_output.clear();
+    for (const PendingRecord& record : g_pending) {
+        g_output += '[';
+        g_output += cachedDate(record.header.timestamp);
+        g_output += "] [";
+        g_output += record.header.className;
+        g_output += "::";
+        g_output += record.header.methodName;
+        g_output += "] ";
+        g_output += levelTag(record.header.level);
+        g_output.append(g_texts, record.textOffset, record.header.length);
+        g_output += '\n';
+    }
+
+    g_logFile.write(g_output.data(), g_output.size());
+    g_logFile.flush();
+}
+
+void writerLoop() {
+    std::unique_lock<std::mutex> lock(g_wakeMutex);
+    while (g_running) {
+        g_wake.wait_for(lock, FLUSH_INTERVAL);
+        lock.unlock();
+        drain();
+        lock.lock();
+    }
+    lock.unlock();
+    drain();
+}
+} // namespace
+
+std::atomic<uint8_t> Logger::minLevel{static_cast<uint8_t>(LogLevel::OFF)};
+
+void LogText::append(const char* text, size_t size) {
+    if (overflow.empty() && length + size <= INLINE_CAPACITY) {
+        std::memcpy(inlineData + length, text, size);
+    } else {
+        if (overflow.empty()) {
+            overflow.assign(inlineData, length);
+        }
+        overflow.append(text, size);
+    }
+    length += size;
+}
+
+LogText& LogText::operator+(const char* text) {
+    if (text) {
+        append(text, std::strlen(text));
+    }
+    return *this;
 }
 
 void Logger::init(const char* baseName) {
-    std::string filename =
-        "logs/" + std::string(baseName) + "_" + formatDateTime("%Y-%m-%d_%H-%M-%S") + ".log";
+    shutdown();
+
+    std::string filename = "logs/" + std::string(baseName) + "_" +
+                           formatDateTime(SystemClock::to_time_t(SystemClock::now()),
+                                          "%Y-%m-%d_%H-%M-%S") +
+                           ".log";
     g_logFile.open(filename, std::ios::out | std::ios::app);
+    if (!g_logFile.is_open()) {
+        return;
+    }
+
+    g_dropped.store(0);
+    g_running = true;
+    g_writer = std::thread(writerLoop);
+    minLevel.store(g_requestedLevel.load());
 }
 
 void Logger::shutdown() {
-    if (g_logFile.is_open())
+    minLevel.store(static_cast<uint8_t>(LogLevel::OFF));
+    if (g_writer.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(g_wakeMutex);
+            g_running = false;
+        }
+        wakeWriter();
+        g_writer.join();
+    }
+
+    if (g_logFile.is_open()) {
+        uint64_t dropped = g_dropped.load();
+        if (dropped > 0) {
+            g_logFile << "[Logger] " << dropped << " messages dropped (ring full)\n";
+        }
         g_logFile.close();
+    }
 }
 
-void Logger::log(const char* className, const char* methodName, const char* message) {
-    std::lock_guard<std::mutex> lock(g_logMutex);
-    if (!g_logFile.is_open())
-        return;
-    g_logFile << "[" << formatDateTime("%Y-%m-%d %H:%M:%S") << "] "
-              << "[" << className << "::" << methodName << "] " << message << std::endl;
+void Logger::setLevel(LogLevel level) {
+    g_requestedLevel.store(static_cast<uint8_t>(level));
+    if (g_logFile.is_open()) {
+        minLevel.store(static_cast<uint8_t>(level));
+    }
+}
+
+LogLevel Logger::getLevel() { return static_cast<LogLevel>(g_requestedLevel.load()); }
+
+bool Logger::parseLevel(const std::string& name, LogLevel& level) {
+    static const char* names[] = {"info", "warn", "error", "off"};
+    for (uint8_t i = 0; i <= static_cast<uint8_t>(LogLevel::OFF); i++) {
+        if (name == names[i]) {
+            level = static_cast<LogLevel>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+uint64_t Logger::getDroppedCount() { return g_dropped.load(std::memory_order_relaxed); }
+
+void Logger::write(LogLevel level, const char* className, const char* methodName,
+                   const LogText& message) {
+    LogRing* ring = currentRing();
+
+    RecordHeader header;
+    header.className = className;
+    header.methodName = methodName;
+    header.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           SystemClock::now().time_since_epoch())
+                           .count();
+    header.length = static_cast<uint32_t>(std::min<size_t>(message.size(), LogRing::MAX_MESSAGE));
+    header.level = level;
+
+    size_t size = sizeof(RecordHeader) + header.length;
+    size = (size + RECORD_ALIGNMENT - 1) / RECORD_ALIGNMENT * RECORD_ALIGNMENT;
+
+    uint64_t head = ring->head.load(std::memory_order_relaxed);
+    uint64_t tail = ring->tail.load(std::memory_order_acquire);
+    for (int retry = 0; LogRing::CAPACITY - (head - tail) < size; retry++) {
+        if (retry == FULL_RING_RETRIES || !isEnabled(level)) {
+            g_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        wakeWriter();
+        std::this_thread::yield();
+        tail = ring->tail.load(std::memory_order_acquire);
+    }
+
+    ring->copyIn(head, &header, sizeof(RecordHeader));
+    ring->copyIn(head + sizeof(RecordHeader), message.data(), header.length);
+    ring->head.store(head + size, std::memory_order_release);
+
+    // Erros saem logo (podem anteceder um crash); o resto espera o lote ou o ring encher
+    if (level >= LogLevel::ERR || head + size - tail > LogRing::CAPACITY / 2) {
+        wakeWriter();
+    }
 }
@@ -1,11 +1,66 @@
 #ifndef LOGGER_HPP
 #define LOGGER_HPP
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// ERR e nao ERROR: o windows.h define ERROR como macro
+enum class LogLevel : uint8_t { INFO = 0, WARN, ERR, OFF };
+
+// Mensagem montada na pilha pelos macros LOG_*; so vai para o heap se passar de
+// INLINE_CAPACITY. Aceita a mesma concatenacao que std::string ("a" + s + "b").
+class LogText {
+  public:
+    static constexpr size_t INLINE_CAPACITY = 256;
+
+  private:
+    char inlineData[INLINE_CAPACITY];
+    size_t length = 0;
+    std::string overflow;
+
+    void append(const char* text, size_t size);
+
+  public:
+    LogText() = default;
+    LogText(const LogText&) = delete;
+    LogText& operator=(const LogText&) = delete;
+
+    LogText& operator+(const char* text);
+    LogText& operator+(const std::string& text) { append(text.data(), text.size()); return *this; }
+    LogText& operator+(char c) { append(&c, 1); return *this; }
+
+    const char* data() const { return overflow.empty() ? inlineData : overflow.data(); }
+    size_t size() const { return length; }
+};
+
+// Log assincrono: cada thread grava registros binarios (nivel, classe, metodo, hora e
+// texto) num ring proprio sem locks; uma thread de escrita formata e grava em lotes.
+// Com o ring cheio a thread espera um pouco pela escrita e depois descarta a mensagem.
 class Logger {
+  private:
+    // OFF enquanto nao ha arquivo aberto: os macros nem montam a mensagem
+    static std::atomic<uint8_t> minLevel;
+
   public:
     static void init(const char* filename);
+    // Grava o que estiver pendente e para a thread de escrita
     static void shutdown();
-    static void log(const char* className, const char* methodName, const char* message);
+
+    // Nivel minimo em tempo de execucao; o de compilacao e YUME_LOG_MIN_LEVEL
+    static void setLevel(LogLevel level);
+    static LogLevel getLevel();
+    // "info", "warn", "error" ou "off"
+    static bool parseLevel(const std::string& name, LogLevel& level);
+    static bool isEnabled(LogLevel level) {
+        return static_cast<uint8_t>(level) >= minLevel.load(std::memory_order_relaxed);
+    }
+
+    static void write(LogLevel level, const char* className, const char* methodName,
+                      const LogText& message);
+    // Mensagens descartadas por ring cheio desde o init
+    static uint64_t getDroppedCount();
 };
 
-#endif
+#endif // LOGGER_HPP
@@ -10,11 +10,19 @@
 #include "vector3.hpp"
 #include "window/window_desc.hpp"
 #include "window/window_manager.hpp"
+#include "engine_stats.hpp"
+#include "game_loop.hpp"
 #include "logger.hpp"
+#include "memory_tracker.hpp"
+#include "renderer/backends/capture/capture_renderer_backend.hpp"
+#include "sampling_profiler.hpp"
+#include "trace.hpp"
 #include <SDL2/SDL_keycode.h>
 
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
+#include <cstdlib>
 #include <memory>
 
 #include <SDL2/SDL.h>
@@ -22,7 +30,8 @@
 #ifdef PLATFORM_WEBGL
 GraphicsAPI graphicsAPI = GraphicsAPI::WEBGL;
 #else
-// Escolha a API aqui: GraphicsAPI::OPENGL ou GraphicsAPI::VULKAN
+// Escolha a API aqui: GraphicsAPI::OPENGL, GraphicsAPI::VULKAN, GraphicsAPI::SOFTWARE
+// ou GraphicsAPI::NONE (nao desenha nada, so conta as chamadas)
 GraphicsAPI graphicsAPI = GraphicsAPI::OPENGL;
 #endif
 
@@ -32,6 +41,9 @@ std::unique_ptr<WindowManager> screenManager;
 std::unique_ptr<SceneManager> sceneManager;
 RendererBackend* rendererBackend = nullptr;
 WindowDesc winDesc;
+std::string profilePath = "profile.folded";
+int profileFrequency = SamplingProfiler::DEFAULT_FREQUENCY;
+GameLoop::Settings loopSettings;
 
 auto inputMan = Yume::IInputFactory::create();
 Yume::Context engine(inputMan);
@@ -41,17 +53,103 @@ void init() {
     winDesc.title = "Engine";
     winDesc.width = 800;
     winDesc.height = 600;
+
+#ifndef PLATFORM_WEBGL
+    // YUME_HEADLESS=1 renderiza sem janela (CI, benchmarks); YUME_CAPTURE_DIR grava os frames
+    if (const char* value = std::getenv("YUME_HEADLESS")) {
+        winDesc.headless = std::atoi(value) != 0;
+    }
+    if (const char* value = std::getenv("YUME_CAPTURE_DIR")) {
+        winDesc.captureDirectory = value;
+    }
+    if (const char* value = std::getenv("YUME_CAPTURE_INTERVAL")) {
+        winDesc.captureInterval = std::atoi(value);
+    }
+    // YUME_LOG_LEVEL=info|warn|error|off filtra o log em tempo de execucao
+    if (const char* value = std::getenv("YUME_LOG_LEVEL")) {
+        LogLevel level;
+        if (Logger::parseLevel(value, level)) {
+            Logger::setLevel(level);
+        } else {
+            std::fprintf(stderr, "Unknown YUME_LOG_LEVEL: %s\n", value);
+        }
+    }
+    // YUME_TRACE=arquivo.json grava zonas de CPU no formato do Chrome trace / Perfetto
+    if (const char* value = std::getenv("YUME_TRACE")) {
+        Trace::setThreadName("main");
+        Trace::begin(value);
+    }
+    // YUME_STATS_CSV=arquivo.csv grava os contadores de cada frame
+    if (const char* value = std::getenv("YUME_STATS_CSV")) {
+        EngineStats::openCsv(value);
+    }
+    // YUME_PROFILE=arquivo.folded liga o profiler por amostragem (Linux) desde o inicio;
+    // F9 liga depois ou grava o que ja foi amostrado. YUME_PROFILE_HZ muda a frequencia.
+    if (const char* value = std::getenv("YUME_PROFILE_HZ")) {
+        profileFrequency = std::atoi(value);
+    }
+    if (const char* value = std::getenv("YUME_PROFILE")) {
+        profilePath = value;
+        SamplingProfiler::start(profilePath, profileFrequency);
+    }
+    // YUME_FPS_LIMIT=N limita os frames por segundo; YUME_TICK_RATE muda o passo fixo (60 Hz).
+    // YUME_PAUSE_UNFOCUSED=0 continua renderizando sem foco (minimizada sempre suspende).
+    if (const char* value = std::getenv("YUME_FPS_LIMIT")) {
+        loopSettings.frameRateLimit = std::atof(value);
+    }
+    if (const char* value = std::getenv("YUME_TICK_RATE")) {
+        double rate = std::atof(value);
+        if (rate > 0.0) {
+            loopSettings.tickRate = rate;
+        } else {
+            std::fprintf(stderr, "Invalid YUME_TICK_RATE: %s\n", value);
+        }
+    }
+    if (const char* value = std::getenv("YUME_PAUSE_UNFOCUSED")) {
+        loopSettings.suspendWhenUnfocused = std::atoi(value) != 0;
+    }
+    // Um passo por frame quando a execucao precisa ser repetivel: headless (comparacao de
+    // frames) e gravacao/replay de entrada. YUME_LOCKSTEP=0|1 forca.
+    loopSettings.lockstep = winDesc.headless || std::getenv("YUME_INPUT_RECORD") ||
+                            std::getenv("YUME_INPUT_REPLAY");
+    if (const char* value = std::getenv("YUME_LOCKSTEP")) {
+        loopSettings.lockstep = std::atoi(value) != 0;
+    }
+#endif
     
     screenManager = std::make_unique<WindowManager>();
     screenManager->setGraphicsApi(graphicsAPI);
     screenManager->init(winDesc);
 
+#ifndef PLATFORM_WEBGL
+    // YUME_RENDER_CAPTURE=arquivo.yrc grava as chamadas ao backend dos primeiros
+    // YUME_RENDER_CAPTURE_FRAMES frames (300) para tools/render_replay
+    if (const char* value = std::getenv("YUME_RENDER_CAPTURE")) {
+        uint32_t frames = 300;
+        if (const char* count = std::getenv("YUME_RENDER_CAPTURE_FRAMES")) {
+            frames = static_cast<uint32_t>(std::strtoul(count, nullptr, 10));
+        }
+        Renderer* renderer = screenManager->getRenderer();
+        auto capture = new CaptureRendererBackend(
+            std::unique_ptr<RendererBackend>(renderer->getRendererBackend()));
+        renderer->setRendererBackend(capture);
+        capture->startCapture(value, frames);
+    }
+#endif
+
     rendererBackend = screenManager->getRenderer()->getRendererBackend();
 
     sceneManager = std::make_unique<SceneManager>();
     sceneManager->setRendererBackend(*rendererBackend);
     sceneManager->addScene("cena1", "scene_with_sprite.scnb");
-    sceneManager->addScene("cena2", "scene.scnb");
+    // YUME_SCENE troca a cena inicial (ex.: uma gerada por tools/scene_generator)
+    const char* scenePath = "scene.scnb";
+#ifndef PLATFORM_WEBGL
+    if (const char* value = std::getenv("YUME_SCENE")) {
+        scenePath = value;
+    }
+#endif
+    sceneManager->addScene("cena2", scenePath);
     sceneManager->loadScene("cena2");
 
     engine.getInputSystem().bindKey(SDLK_ESCAPE, [&]() { 
@@ -59,8 +157,52 @@ void init() {
     });
 
     engine.getInputSystem().bindKey(SDLK_SPACE, [&]() { 
+        // A carga cria e destroi recursos do backend: precisa do contexto
+        screenManager->pauseRendering();
         sceneManager->loadScene("cena2");
+        screenManager->resumeRendering();
+    });
+
+    // F8: pick pelo indice espacial do objeto no centro da tela
+    engine.getInputSystem().bindKey(SDLK_F8, [&]() {
+        Scene* scene = sceneManager->getActiveScene();
+        if (!scene || !scene->getCamera()) {
+            return;
+        }
+        glm::mat4 cameraToWorld = glm::inverse(scene->getCamera()->getViewMatrix());
+        glm::vec3 origin(cameraToWorld[3]);
+        glm::vec3 forward = -glm::normalize(glm::vec3(cameraToWorld[2]));
+
+        RaycastHit hit;
+        if (!scene->raycast(origin, forward, scene->getCamera()->getFarDistance(), hit)) {
+            std::printf("Pick: nothing under the crosshair\n");
+            return;
+        }
+        const auto* objects = scene->getGameObjects();
+        auto found = std::find(objects->begin(), objects->end(), hit.object);
+        std::printf("Pick: game object %ld at %.2f (%.2f, %.2f, %.2f)\n",
+                    static_cast<long>(found - objects->begin()), hit.distance, hit.point.x,
+                    hit.point.y, hit.point.z);
     });
+
+#ifndef PLATFORM_WEBGL
+    // YUME_RENDER_THREAD=0 desenha na thread principal, sem sobrepor simulacao e render
+    bool useRenderThread = true;
+    if (const char* value = std::getenv("YUME_RENDER_THREAD")) {
+        useRenderThread = std::atoi(value) != 0;
+    }
+    if (useRenderThread) {
+        screenManager->startRenderThread();
+    }
+
+    engine.getInputSystem().bindKey(SDLK_F9, [&]() {
+        if (SamplingProfiler::isRunning()) {
+            SamplingProfiler::writeFoldedStacks();
+        } else {
+            SamplingProfiler::start(profilePath, profileFrequency);
+        }
+    });
+#endif
 }
 
 #ifdef PLATFORM_WEBGL
@@ -85,27 +227,64 @@ void main_loop() {
 #else
 void main_loop() {
 
+    // Estado simulado no passo fixo; o render interpola entre o passo anterior e o atual
     float x = 0.0f, y = 0.0f, z = 0.0f;
+    float previousX = x, previousY = y;
+
+    // YUME_FRAME_LIMIT encerra depois de N frames (0 = sem limite)
+    uint64_t frameLimit = 0;
+    if (const char* value = std::getenv("YUME_FRAME_LIMIT")) {
+        frameLimit = std::strtoull(value, nullptr, 10);
+    }
+
+    GameLoop loop(loopSettings);
+    loop.setWindow(screenManager->getWindow());
+
+    auto step = [&](double dt) {
+        TRACE_ZONE("main_loop::step");
+        previousX = x;
+        previousY = y;
+        // Mesma velocidade de antes a 60 fps, agora independente da taxa de frames
+        x += 0.06f * static_cast<float>(dt);
+        y += 0.24f * static_cast<float>(dt);
+    };
+
+    auto render = [&](float alpha) {
+        float renderX = previousX + (x - previousX) * alpha;
+        float renderY = previousY + (y - previousY) * alpha;
+        auto gameObjects = sceneManager->getActiveScene()->getGameObjects();
+        if (gameObjects && !gameObjects->empty() && (*gameObjects)[0]->getTransform()) {
+            (*gameObjects)[0]->getTransform()->setPosition({sin(renderX), cos(renderY), z});
+        }
+
+        screenManager->render(*sceneManager->getActiveScene());
+
+        screenManager->present();
+        TRACE_FRAME_MARK();
+    };
 
     bool running = true;
     while (running) {
+        TRACE_ZONE("main_loop");
 
-        engine.getInputSystem().processEvents();
+        {
+            TRACE_ZONE("InputSystem::processEvents");
+            engine.getInputSystem().processEvents();
+        }
 
         if (engine.getInputSystem().getQuitEvent()) {
             running = false;
         }
 
-        x += 0.001f;
-        y += 0.004f;
-
-        (*sceneManager->getActiveScene()->getGameObjects())[0]->getTransform()->setPosition({sin(x),cos(y),z});
-        
-        screenManager->render(*sceneManager->getActiveScene());
+        loop.tick(step, render);
 
-        screenManager->present();
+        if (frameLimit != 0 && screenManager->getFrameIndex() >= frameLimit) {
+            running = false;
+        }
     }
 
+    // Devolve o contexto antes de a cena e o backend serem destruidos
+    screenManager->stopRenderThread();
     SDL_Quit();
 }
 
@@ -120,6 +299,10 @@ int main(int argc, char* argv[]) {
         emscripten_set_main_loop(main_loop, 0, 1);
 #else
         main_loop();
+        SamplingProfiler::stop();
+        Trace::end();
+        EngineStats::closeCsv();
+        MemoryTracker::reportRenderLoopAllocations();
 #endif
 
         Logger::shutdown();
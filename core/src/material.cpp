@@ -2,11 +2,16 @@
 #include "log_macros.hpp"
 
 #include "color.hpp"
+#include "engine_stats.hpp"
 #include "light.hpp"
 #include "material.hpp"
 
 
-Material::Material() {}
+std::atomic<uint32_t> Material::nextId{1};
+
+Material::Material() { EngineStats::countAsset(AssetType::MATERIAL, 1); }
+
+Material::~Material() { EngineStats::countAsset(AssetType::MATERIAL, -1); }
 
 bool Material::init() {
     if (!vertexShader || !fragmentShader || !shaderProgram) {
@@ -23,13 +28,70 @@ bool Material::init() {
     }
 
     if (!shaderProgram->link()) {
+        failed = true;
+        return false;
+    }
+
+    // A variante instanciada e opcional; falhas aqui so desativam o instancing
+    if (instancedVertexShader && instancedShaderProgram) {
+        if (!instancedVertexShader->load() ||
+            !instancedShaderProgram->attachShader(*instancedVertexShader) ||
+            !instancedShaderProgram->attachShader(*fragmentShader) ||
+            !instancedShaderProgram->link()) {
+            LOG_WARN("Instanced shader variant failed, drawing without instancing: " +
+                     instancedVertexShader->getPath());
+            instancedShaderProgram.reset();
+        }
+    }
+
+    isReady();
+    return !failed;
+}
+
+bool Material::isReady() {
+    if (ready) {
+        return true;
+    }
+    if (failed || !shaderProgram || !shaderProgram->isReady()) {
         return false;
     }
 
+    if (!shaderProgram->isValid()) {
+        LOG_ERROR("Shader program failed to build, material will not be drawn");
+        failed = true;
+        return false;
+    }
+
+    // Uniforms so podem ser enviados depois do link
+    ready = true;
     setBaseColor(baseColor);
+    drawable.store(true, std::memory_order_release);
     return true;
 }
 
+void Material::setInstancedVariant(std::unique_ptr<ShaderAsset> vertex,
+                                   std::unique_ptr<ShaderProgram> program) {
+    instancedVertexShader = std::move(vertex);
+    instancedShaderProgram = std::move(program);
+    if (instancedShaderProgram) {
+        instancedShaderProgram->setInstanced(true);
+    }
+}
+
+ShaderProgram* Material::getInstancedShaderProgram() {
+    if (!instancedShaderProgram || !instancedShaderProgram->isReady()) {
+        return nullptr;
+    }
+
+    if (!instancedShaderProgram->isValid()) {
+        LOG_WARN("Instanced shader variant failed to build, drawing without instancing");
+        instancedShaderProgram.reset();
+        return nullptr;
+    }
+
+    return instancedShaderProgram.get();
+}
+
 void Material::use() {
     if (shaderProgram) {
         shaderProgram->use();
@@ -38,7 +100,7 @@ void Material::use() {
 
 void Material::setBaseColor(const ColorRGBA color) {
     baseColor = color;
-    if (shaderProgram) {
+    if (ready && shaderProgram) {
         shaderProgram->setUniformBuffer("MaterialData", &baseColor, sizeof(baseColor));
     }
 }
@@ -5,6 +5,8 @@
 #include "light.hpp"
 #include "shader_asset.hpp"
 #include "shader_program.hpp"
+#include <atomic>
+#include <cstdint>
 #include <memory>
 
 class Material {
@@ -12,14 +14,35 @@ class Material {
     std::unique_ptr<ShaderAsset> vertexShader;
     std::unique_ptr<ShaderAsset> fragmentShader;
     std::unique_ptr<ShaderProgram> shaderProgram;
+    // Variante opcional com transform por instancia; usa o mesmo fragment shader
+    std::unique_ptr<ShaderAsset> instancedVertexShader;
+    std::unique_ptr<ShaderProgram> instancedShaderProgram;
     ColorRGBA baseColor = COLOR::GREEN;
+    bool ready = false;
+    bool failed = false;
+    // Copia de ready publicada pela thread que chama isReady (a de render)
+    std::atomic<bool> drawable{false};
+
+    static std::atomic<uint32_t> nextId;
+    uint32_t id = nextId++;
 
   public:
     Material();
+    ~Material();
 
+    // Submete compilacao e link; com suporte do driver retorna sem esperar.
+    // O material so deve ser desenhado depois que isReady() retornar true.
     bool init();
+    bool isReady();
+    bool hasFailed() const { return failed; }
+    // Seguro em qualquer thread: nao toca no contexto grafico, so le o que o ultimo
+    // isReady() verdadeiro publicou
+    bool isDrawable() const { return drawable.load(std::memory_order_acquire); }
     void use();
     void setBaseColor(const ColorRGBA color);
+    const ColorRGBA& getBaseColor() const { return baseColor; }
+    bool isTranslucent() const { return baseColor.a < 1.0f; }
+    uint32_t getId() const { return id; }
     void applyLight(const Light light);
 
     void setVertexShader(std::unique_ptr<ShaderAsset> shader) { vertexShader = std::move(shader); }
@@ -28,10 +51,19 @@ class Material {
         fragmentShader = std::move(shader);
     }
 
+    const ShaderAsset* getVertexShader() const { return vertexShader.get(); }
+    const ShaderAsset* getFragmentShader() const { return fragmentShader.get(); }
+    const ShaderAsset* getInstancedVertexShader() const { return instancedVertexShader.get(); }
+
     ShaderProgram* getShaderProgram() const { return shaderProgram.get(); }
     void setShaderProgram(std::unique_ptr<ShaderProgram> program) {
         shaderProgram = std::move(program);
     }
+
+    void setInstancedVariant(std::unique_ptr<ShaderAsset> vertex,
+                             std::unique_ptr<ShaderProgram> program);
+    // nullptr se nao houver variante ou se ela ainda estiver compilando
+    ShaderProgram* getInstancedShaderProgram();
 };
 
 #endif // MATERIAL_HPP
\ No newline at end of file
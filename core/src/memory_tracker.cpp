@@ -0,0 +1,316 @@
+#define CLASS_NAME "MemoryTracker"
+#include "memory_tracker.hpp"
+#include "log_macros.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+const char* MemoryTracker::getTagName(MemoryTag tag) {
+    switch (tag) {
+    case MemoryTag::UNTAGGED:
+        return "untagged";
+    case MemoryTag::SCENE_LOAD:
+        return "scene load";
+    case MemoryTag::RENDERER:
+        return "renderer";
+    case MemoryTag::ASSETS:
+        return "assets";
+    default:
+        return "unknown";
+    }
+}
+
+#ifdef YUME_TRACK_ALLOCATIONS
+
+namespace {
+constexpr size_t TAG_COUNT = static_cast<size_t>(MemoryTag::COUNT);
+
+struct Counters {
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> frees{0};
+    std::atomic<int64_t> liveBytes{0};
+    std::atomic<int64_t> peakBytes{0};
+};
+
+// Fica antes de cada bloco; headerSize volta ao ponteiro devolvido pelo malloc
+struct alignas(16) BlockHeader {
+    uint64_t size;
+    uint32_t headerSize;
+    MemoryTag tag;
+};
+
+// Sem construtores dinamicos: podem ser usados por alocacoes antes do main
+Counters g_tags[TAG_COUNT];
+Counters g_total;
+std::atomic<uint64_t> g_frameAllocations{0};
+std::atomic<uint64_t> g_frameBytes{0};
+std::atomic<uint64_t> g_frameRenderLoop{0};
+std::atomic<uint64_t> g_renderLoopAllocations{0};
+std::atomic<const void*> g_flaggedCallers[MemoryTracker::MAX_FLAGGED_CALLERS] = {};
+std::atomic<size_t> g_flaggedCount{0};
+
+thread_local MemoryTag t_tag = MemoryTag::UNTAGGED;
+thread_local bool t_renderLoop = false;
+
+void updatePeak(std::atomic<int64_t>& peak, int64_t live) {
+    int64_t current = peak.load(std::memory_order_relaxed);
+    while (live > current &&
+           !peak.compare_exchange_weak(current, live, std::memory_order_relaxed)) {
+    }
+}
+
+void count(Counters& counters, int64_t size) {
+    counters.allocations.fetch_add(1, std::memory_order_relaxed);
+    int64_t live = counters.liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+    updatePeak(counters.peakBytes, live);
+}
+
+void flagCaller(const void* caller) {
+    size_t known = std::min(g_flaggedCount.load(std::memory_order_acquire),
+                            MemoryTracker::MAX_FLAGGED_CALLERS);
+    for (size_t i = 0; i < known; i++) {
+        if (g_flaggedCallers[i].load(std::memory_order_relaxed) == caller) {
+            return;
+        }
+    }
+
+    size_t slot = g_flaggedCount.fetch_add(1, std::memory_order_acq_rel);
+    if (slot < MemoryTracker::MAX_FLAGGED_CALLERS) {
+        g_flaggedCallers[slot].store(caller, std::memory_order_relaxed);
+    }
+}
+
+void* rawAllocate(size_t size, size_t alignment) {
+#ifdef _WIN32
+    return _aligned_malloc(size, alignment);
+#else
+    if (alignment <= alignof(std::max_align_t)) {
+        return std::malloc(size);
+    }
+    void* memory = nullptr;
+    return posix_memalign(&memory, alignment, size) == 0 ? memory : nullptr;
+#endif
+}
+
+void rawFree(void* memory) {
+#ifdef _WIN32
+    _aligned_free(memory);
+#else
+    std::free(memory);
+#endif
+}
+
+void* trackedAllocate(size_t size, size_t alignment, const void* caller) {
+    if (alignment < alignof(BlockHeader)) {
+        alignment = alignof(BlockHeader);
+    }
+    // Multiplo do alinhamento: o ponteiro devolvido continua alinhado
+    size_t headerSize = sizeof(BlockHeader) > alignment ? sizeof(BlockHeader) : alignment;
+    // size + headerSize daria a volta e alocaria um bloco pequeno demais
+    if (size > SIZE_MAX - headerSize) {
+        return nullptr;
+    }
+    auto raw = static_cast<uint8_t*>(rawAllocate(size + headerSize, alignment));
+    if (!raw) {
+        return nullptr;
+    }
+
+    uint8_t* user = raw + headerSize;
+    BlockHeader* header = reinterpret_cast<BlockHeader*>(user) - 1;
+    header->size = size;
+    header->headerSize = static_cast<uint32_t>(headerSize);
+    header->tag = t_tag;
+
+    int64_t bytes = static_cast<int64_t>(size);
+    count(g_tags[static_cast<size_t>(t_tag)], bytes);
+    count(g_total, bytes);
+    g_frameAllocations.fetch_add(1, std::memory_order_relaxed);
+    g_frameBytes.fetch_add(size, std::memory_order_relaxed);
+
+    if (t_renderLoop) {
+        g_renderLoopAllocations.fetch_add(1, std::memory_order_relaxed);
+        g_frameRenderLoop.fetch_add(1, std::memory_order_relaxed);
+        flagCaller(caller);
+    }
+    return user;
+}
+
+void trackedFree(void* memory) {
+    if (!memory) {
+        return;
+    }
+
+    BlockHeader* header = static_cast<BlockHeader*>(memory) - 1;
+    int64_t bytes = static_cast<int64_t>(header->size);
+    Counters& tag = g_tags[static_cast<size_t>(header->tag)];
+    tag.frees.fetch_add(1, std::memory_order_relaxed);
+    tag.liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+    g_total.frees.fetch_add(1, std::memory_order_relaxed);
+    g_total.liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+
+    rawFree(static_cast<uint8_t*>(memory) - header->headerSize);
+}
+
+MemoryStats snapshot(const Counters& counters) {
+    MemoryStats stats;
+    stats.allocations = counters.allocations.load(std::memory_order_relaxed);
+    stats.frees = counters.frees.load(std::memory_order_relaxed);
+    stats.liveBytes = counters.liveBytes.load(std::memory_order_relaxed);
+    stats.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+    return stats;
+}
+} // namespace
+
+#if defined(__GNUC__) || defined(__clang__)
+#define MEMORY_CALLER() __builtin_return_address(0)
+#else
+#define MEMORY_CALLER() nullptr
+#endif
+
+void* operator new(std::size_t size) {
+    void* memory = trackedAllocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__, MEMORY_CALLER());
+    if (!memory) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new[](std::size_t size) {
+    void* memory = trackedAllocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__, MEMORY_CALLER());
+    if (!memory) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return trackedAllocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__, MEMORY_CALLER());
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return trackedAllocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__, MEMORY_CALLER());
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    void* memory = trackedAllocate(size, static_cast<size_t>(alignment), MEMORY_CALLER());
+    if (!memory) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    void* memory = trackedAllocate(size, static_cast<size_t>(alignment), MEMORY_CALLER());
+    if (!memory) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return trackedAllocate(size, static_cast<size_t>(alignment), MEMORY_CALLER());
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment,
+                     const std::nothrow_t&) noexcept {
+    return trackedAllocate(size, static_cast<size_t>(alignment), MEMORY_CALLER());
+}
+
+void operator delete(void* memory) noexcept { trackedFree(memory); }
+void operator delete[](void* memory) noexcept { trackedFree(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { trackedFree(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { trackedFree(memory); }
+void operator delete(void* memory, std::size_t) noexcept { trackedFree(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { trackedFree(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { trackedFree(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { trackedFree(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { trackedFree(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept {
+    trackedFree(memory);
+}
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept {
+    trackedFree(memory);
+}
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept {
+    trackedFree(memory);
+}
+
+bool MemoryTracker::isEnabled() { return true; }
+
+MemoryStats MemoryTracker::getStats(MemoryTag tag) {
+    return snapshot(g_tags[static_cast<size_t>(tag)]);
+}
+
+MemoryStats MemoryTracker::getTotal() { return snapshot(g_total); }
+
+void MemoryTracker::endFrame(uint64_t& allocations, uint64_t& bytes,
+                             uint64_t& renderLoopAllocations) {
+    allocations = g_frameAllocations.exchange(0, std::memory_order_relaxed);
+    bytes = g_frameBytes.exchange(0, std::memory_order_relaxed);
+    renderLoopAllocations = g_frameRenderLoop.exchange(0, std::memory_order_relaxed);
+}
+
+uint64_t MemoryTracker::getRenderLoopAllocations() {
+    return g_renderLoopAllocations.load(std::memory_order_relaxed);
+}
+
+size_t MemoryTracker::getFlaggedCallers(const void** callers, size_t capacity) {
+    size_t count = std::min(g_flaggedCount.load(std::memory_order_acquire), MAX_FLAGGED_CALLERS);
+    count = std::min(count, capacity);
+    for (size_t i = 0; i < count; i++) {
+        callers[i] = g_flaggedCallers[i].load(std::memory_order_relaxed);
+    }
+    return count;
+}
+
+MemoryTracker::Scope::Scope(MemoryTag tag) : previous(t_tag) { t_tag = tag; }
+
+MemoryTracker::Scope::~Scope() { t_tag = previous; }
+
+MemoryTracker::RenderLoopScope::RenderLoopScope() : previous(t_renderLoop) {
+    t_renderLoop = true;
+}
+
+MemoryTracker::RenderLoopScope::~RenderLoopScope() { t_renderLoop = previous; }
+
+#else
+
+bool MemoryTracker::isEnabled() { return false; }
+MemoryStats MemoryTracker::getStats(MemoryTag) { return MemoryStats(); }
+MemoryStats MemoryTracker::getTotal() { return MemoryStats(); }
+
+void MemoryTracker::endFrame(uint64_t& allocations, uint64_t& bytes,
+                             uint64_t& renderLoopAllocations) {
+    allocations = 0;
+    bytes = 0;
+    renderLoopAllocations = 0;
+}
+
+uint64_t MemoryTracker::getRenderLoopAllocations() { return 0; }
+size_t MemoryTracker::getFlaggedCallers(const void**, size_t) { return 0; }
+
+MemoryTracker::Scope::Scope(MemoryTag) : previous(MemoryTag::UNTAGGED) {}
+MemoryTracker::Scope::~Scope() {}
+MemoryTracker::RenderLoopScope::RenderLoopScope() : previous(false) {}
+MemoryTracker::RenderLoopScope::~RenderLoopScope() {}
+
+#endif
+
+void MemoryTracker::reportRenderLoopAllocations() {
+    uint64_t total = getRenderLoopAllocations();
+    if (!isEnabled() || total == 0) {
+        return;
+    }
+
+    LOG_WARN(std::to_string(total) + " allocations inside the render loop");
+    const void* callers[MAX_FLAGGED_CALLERS];
+    size_t count = getFlaggedCallers(callers, MAX_FLAGGED_CALLERS);
+    for (size_t i = 0; i < count; i++) {
+        char address[32];
+        std::snprintf(address, sizeof(address), "%p", callers[i]);
+        LOG_WARN(std::string("  allocated from ") + address);
+    }
+}
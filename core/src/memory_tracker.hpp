@@ -0,0 +1,74 @@
+#ifndef MEMORY_TRACKER_HPP
+#define MEMORY_TRACKER_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// Subsistema a que uma alocacao e atribuida; vale o MEMORY_SCOPE mais interno da thread
+enum class MemoryTag : uint8_t { UNTAGGED = 0, SCENE_LOAD, RENDERER, ASSETS, COUNT };
+
+struct MemoryStats {
+    uint64_t allocations = 0;
+    uint64_t frees = 0;
+    int64_t liveBytes = 0;
+    int64_t peakBytes = 0;
+};
+
+// Contagem de alocacoes do heap pela troca do operator new/delete global. So existe com
+// YUME_TRACK_ALLOCATIONS (opcao do CMake); sem ela as consultas retornam zero e os
+// macros somem. Frees sao atribuidos a tag da alocacao, nao ao escopo atual.
+class MemoryTracker {
+  public:
+    static constexpr size_t MAX_FLAGGED_CALLERS = 16;
+
+    static bool isEnabled();
+    static const char* getTagName(MemoryTag tag);
+    static MemoryStats getStats(MemoryTag tag);
+    static MemoryStats getTotal();
+
+    // Alocacoes desde o frame anterior; chamado por EngineStats::endFrame
+    static void endFrame(uint64_t& allocations, uint64_t& bytes, uint64_t& renderLoopAllocations);
+
+    // Alocacoes feitas dentro de MEMORY_RENDER_LOOP(): a meta e zero por frame.
+    // Guarda os enderecos absolutos de quem chamou operator new; em binarios PIE,
+    // subtrair a base de /proc/<pid>/maps antes do addr2line.
+    static uint64_t getRenderLoopAllocations();
+    static size_t getFlaggedCallers(const void** callers, size_t capacity);
+    // Loga o total e os enderecos guardados
+    static void reportRenderLoopAllocations();
+
+    class Scope {
+      private:
+        MemoryTag previous;
+
+      public:
+        explicit Scope(MemoryTag tag);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    class RenderLoopScope {
+      private:
+        bool previous;
+
+      public:
+        RenderLoopScope();
+        ~RenderLoopScope();
+        RenderLoopScope(const RenderLoopScope&) = delete;
+        RenderLoopScope& operator=(const RenderLoopScope&) = delete;
+    };
+};
+
+#define MEMORY_CONCAT_INNER(a, b) a##b
+#define MEMORY_CONCAT(a, b) MEMORY_CONCAT_INNER(a, b)
+
+#ifdef YUME_TRACK_ALLOCATIONS
+#define MEMORY_SCOPE(tag) MemoryTracker::Scope MEMORY_CONCAT(memoryScope, __LINE__)(tag)
+#define MEMORY_RENDER_LOOP() MemoryTracker::RenderLoopScope MEMORY_CONCAT(renderLoop, __LINE__)
+#else
+#define MEMORY_SCOPE(tag) ((void)0)
+#define MEMORY_RENDER_LOOP() ((void)0)
+#endif
+
+#endif // MEMORY_TRACKER_HPP
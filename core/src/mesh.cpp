@@ -1,13 +1,24 @@
 #include "mesh.hpp"
+#include "engine_stats.hpp"
 #include <GL/glew.h>
 
+std::atomic<uint32_t> Mesh::nextId{1};
+
+Mesh::Mesh() { EngineStats::countAsset(AssetType::MESH, 1); }
+
+Mesh::~Mesh() { EngineStats::countAsset(AssetType::MESH, -1); }
+
 bool Mesh::configure() {
     bool result = meshBuffer->createBuffers(vertices, normals);
 
     return result;
 }
 
-void Mesh::setVertices(const std::vector<float>& v) { vertices = v; }
+void Mesh::setVertices(const std::vector<float>& v) {
+    vertices = v;
+    bounds = Bounds::fromVertices(vertices);
+    boundingSphere = Bounds::sphereFromVertices(vertices, bounds);
+}
 
 const std::vector<float>& Mesh::getVertices() const { return vertices; }
 
@@ -1,7 +1,10 @@
 #ifndef MESH_HPP
 #define MESH_HPP
 
+#include "bounds.hpp"
 #include "mesh_buffer.hpp"
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -10,9 +13,16 @@ class Mesh {
     std::vector<float> vertices;
     std::vector<float> normals;
     std::unique_ptr<MeshBuffer> meshBuffer;
+    // Calculados em setVertices, em espaco local
+    AABB bounds;
+    BoundingSphere boundingSphere;
+
+    static std::atomic<uint32_t> nextId;
+    uint32_t id = nextId++;
 
   public:
-    Mesh() = default;
+    Mesh();
+    ~Mesh();
 
     void setVertices(const std::vector<float>& v);
     const std::vector<float>& getVertices() const;
@@ -27,6 +37,10 @@ class Mesh {
     void* getMeshHandle() const;
     void* getMeshBufferHandle() const;
 
+    const AABB& getBounds() const { return bounds; }
+    const BoundingSphere& getBoundingSphere() const { return boundingSphere; }
+
+    uint32_t getId() const { return id; }
     MeshBuffer* getMeshBuffer() const;
     void setMeshBuffer(std::unique_ptr<MeshBuffer> buffer);
 };
@@ -1,10 +1,12 @@
 #include "mesh_buffer_factory.hpp"
+#include "renderer/backends/null/null_mesh_buffer.hpp"
 
 #ifdef PLATFORM_WEBGL
 #include "renderer/backends/webgl/web_gl_mesh_buffer.hpp"
 #else
 #include "renderer/backends/opengl/open_gl_mesh_buffer.hpp"
 #include "renderer/backends/vulkan/vulkan_mesh_buffer.hpp"
+#include "renderer/backends/software/software_mesh_buffer.hpp"
 #ifdef _WIN32
 #include "renderer/backends/directx12/d3d12_mesh_buffer.hpp"
 #endif
@@ -17,14 +19,18 @@ std::unique_ptr<MeshBuffer> MeshBufferFactory::create(GraphicsAPI api, void* con
         return std::make_unique<WebGLMeshBuffer>();
 #else
     case GraphicsAPI::OPENGL:
-        return std::make_unique<OpenGLMeshBuffer>();
+        return std::make_unique<OpenGLMeshBuffer>(static_cast<OpenGLRendererBackend*>(context));
     case GraphicsAPI::VULKAN:
         return std::make_unique<VulkanMeshBuffer>(static_cast<VulkanRendererBackend*>(context));
+    case GraphicsAPI::SOFTWARE:
+        return std::make_unique<SoftwareMeshBuffer>(static_cast<SoftwareRendererBackend*>(context));
 #ifdef _WIN32
     case GraphicsAPI::DIRECTX12:
         return std::make_unique<D3D12MeshBuffer>(static_cast<D3D12RendererBackend*>(context));
 #endif
 #endif
+    case GraphicsAPI::NONE:
+        return std::make_unique<NullMeshBuffer>(static_cast<NullRendererBackend*>(context));
     default:
         return nullptr;
     }
@@ -0,0 +1,456 @@
+#define CLASS_NAME "CaptureRendererBackend"
+#include "../../../log_macros.hpp"
+
+#include "../../../material.hpp"
+#include "capture_renderer_backend.hpp"
+#include <fstream>
+
+namespace {
+constexpr size_t INITIAL_CAPTURE_BYTES = 1 << 20;
+
+void copyVector(float* destination, const Vector3& source) {
+    destination[0] = source.x;
+    destination[1] = source.y;
+    destination[2] = source.z;
+}
+} // namespace
+
+CaptureRendererBackend::CaptureRendererBackend(std::unique_ptr<RendererBackend> backend)
+    : backend(std::move(backend)) {}
+
+CaptureRendererBackend::~CaptureRendererBackend() {
+    // Aplicacao encerrou antes do fim da captura: grava o que houver
+    if (capturing) {
+        finishCapture();
+    }
+}
+
+bool CaptureRendererBackend::startCapture(const std::string& path, uint32_t frames) {
+    if (capturing || frames == 0) {
+        LOG_ERROR("Capture already running or no frames requested");
+        return false;
+    }
+
+    capturePath = path;
+    frameLimit = frames;
+    framesCaptured = 0;
+    writer.clear();
+    writer.reserve(INITIAL_CAPTURE_BYTES);
+    capturedMeshes.clear();
+    capturedMaterials.clear();
+    capturedTextures.clear();
+    capturedObjects.clear();
+    nextObjectId = 1;
+    hasCamera = false;
+    hasLights = false;
+    capturing = true;
+
+    LOG_INFO("Capturing " + std::to_string(frames) + " frames to " + path);
+    return true;
+}
+
+void CaptureRendererBackend::finishCapture() {
+    capturing = false;
+
+    CaptureFileHeader header;
+    header.frameCount = framesCaptured;
+    header.sourceApi = static_cast<uint32_t>(backend->getGraphicsAPI());
+
+    std::ofstream file(capturePath, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(writer.bytes().data()), writer.size());
+    if (!file) {
+        LOG_ERROR("Failed to write capture " + capturePath);
+    } else {
+        LOG_INFO("Wrote " + std::to_string(framesCaptured) + " frames (" +
+                 std::to_string(writer.size()) + " bytes) to " + capturePath);
+    }
+
+    writer.clear();
+    capturedObjects.clear();
+}
+
+std::string CaptureRendererBackend::shaderBasePath(const ShaderAsset* shader) const {
+    if (!shader) {
+        return "";
+    }
+
+    // A extensao e do backend capturado; o replay usa a do backend de destino
+    std::string path = shader->getPath();
+    std::string extension = backend->getShaderExtension();
+    if (!extension.empty() && path.size() >= extension.size() &&
+        path.compare(path.size() - extension.size(), extension.size(), extension) == 0) {
+        path.resize(path.size() - extension.size());
+    }
+    return path;
+}
+
+void CaptureRendererBackend::captureMesh(const Mesh& mesh) {
+    if (!capturedMeshes.insert(mesh.getId()).second) {
+        return;
+    }
+
+    const std::vector<float>& vertices = mesh.getVertices();
+    const std::vector<float>& normals = mesh.getNormals();
+    writer.begin(CaptureRecord::DEFINE_MESH);
+    writer.write(mesh.getId());
+    writer.write(static_cast<uint32_t>(vertices.size()));
+    writer.write(static_cast<uint32_t>(normals.size()));
+    writer.write(vertices.data(), vertices.size() * sizeof(float));
+    writer.write(normals.data(), normals.size() * sizeof(float));
+    writer.end();
+}
+
+void CaptureRendererBackend::captureMaterial(const Material& material) {
+    if (!capturedMaterials.insert(material.getId()).second) {
+        return;
+    }
+
+    writer.begin(CaptureRecord::DEFINE_MATERIAL);
+    writer.write(material.getId());
+    writer.write(material.getBaseColor().v, sizeof(float) * 4);
+    writer.writeString(shaderBasePath(material.getVertexShader()));
+    writer.writeString(shaderBasePath(material.getFragmentShader()));
+    writer.writeString(shaderBasePath(material.getInstancedVertexShader()));
+    writer.end();
+}
+
+void CaptureRendererBackend::captureTexture(unsigned int textureID) {
+    if (textureID == 0 || !capturedTextures.insert(textureID).second) {
+        return;
+    }
+
+    auto it = textureSources.find(textureID);
+    if (it == textureSources.end()) {
+        // Criada antes do decorador; o replay desenha sem textura
+        LOG_WARN("Unknown source for texture " + std::to_string(textureID));
+    }
+
+    if (it != textureSources.end() && it->second.cubemap) {
+        writer.begin(CaptureRecord::DEFINE_CUBEMAP);
+        writer.write(static_cast<uint32_t>(textureID));
+        writer.write(static_cast<uint32_t>(it->second.paths.size()));
+        for (const std::string& path : it->second.paths) {
+            writer.writeString(path);
+        }
+    } else {
+        writer.begin(CaptureRecord::DEFINE_TEXTURE);
+        writer.write(static_cast<uint32_t>(textureID));
+        writer.write(it != textureSources.end() ? it->second.filterType : uint8_t(0));
+        writer.writeString(it != textureSources.end() ? it->second.paths[0] : "");
+    }
+    writer.end();
+}
+
+uint32_t CaptureRendererBackend::captureObject(GameObject& gameObject) {
+    const Mesh* mesh = nullptr;
+    const Sprite* sprite = nullptr;
+    const Material* material = nullptr;
+    if (gameObject.hasSprite() && gameObject.hasSpriteRenderer()) {
+        sprite = gameObject.getSprite();
+        material = gameObject.getSpriteRenderer()->getMaterial();
+    } else if (gameObject.hasMesh() && gameObject.hasMeshRenderer()) {
+        mesh = gameObject.getMesh();
+        material = gameObject.getMeshRenderer()->getMaterial();
+    }
+
+    // Mesma regra da RenderQueue: o que nao seria desenhado neste frame fica de fora
+    if (!material || !const_cast<Material*>(material)->isReady()) {
+        return 0;
+    }
+
+    CapturedObject& captured = capturedObjects[&gameObject];
+    unsigned int texture = sprite ? sprite->getTexture() : 0;
+    float spriteWidth = sprite ? sprite->getWidth() : 0.0f;
+    float spriteHeight = sprite ? sprite->getHeight() : 0.0f;
+
+    // Objeto novo, ou endereco reaproveitado por outro objeto depois de trocar de cena
+    if (captured.id == 0 || captured.mesh != mesh || captured.material != material ||
+        captured.texture != texture || captured.spriteWidth != spriteWidth ||
+        captured.spriteHeight != spriteHeight) {
+        captureMaterial(*material);
+        if (mesh) {
+            captureMesh(*mesh);
+        }
+        captureTexture(texture);
+
+        captured.id = nextObjectId++;
+        captured.mesh = mesh;
+        captured.material = material;
+        captured.texture = texture;
+        captured.spriteWidth = spriteWidth;
+        captured.spriteHeight = spriteHeight;
+        captured.hasTransform = false;
+
+        CaptureObjectData data;
+        data.id = captured.id;
+        data.mesh = mesh ? mesh->getId() : 0;
+        data.material = material->getId();
+        data.texture = texture;
+        data.spriteWidth = spriteWidth;
+        data.spriteHeight = spriteHeight;
+        writer.begin(CaptureRecord::DEFINE_OBJECT);
+        writer.write(data);
+        writer.end();
+    }
+
+    if (Transform* transform = gameObject.getTransform()) {
+        CaptureTransformData data;
+        data.object = captured.id;
+        std::memcpy(data.model, &transform->getModelMatrix()[0][0], sizeof(data.model));
+
+        if (!captured.hasTransform || std::memcmp(&data, &captured.transform, sizeof(data)) != 0) {
+            writer.begin(CaptureRecord::SET_TRANSFORM);
+            writer.write(data);
+            writer.end();
+            captured.transform = data;
+            captured.hasTransform = true;
+        }
+    }
+
+    return captured.id;
+}
+
+void CaptureRendererBackend::captureCamera(Camera& camera) {
+    CaptureCameraData data;
+    copyVector(data.position, camera.getPosition());
+    std::memcpy(data.background, camera.getBackgroundColor().v, sizeof(data.background));
+    data.fov = camera.getFov();
+    data.nearDistance = camera.getNearDistance();
+    data.farDistance = camera.getFarDistance();
+    data.width = camera.getWidth();
+    data.height = camera.getHeight();
+    data.orthoSize = camera.getOrthoSize();
+    data.orthographic = camera.isOrthographic() ? 1 : 0;
+
+    if (!hasCamera || std::memcmp(&data, &lastCamera, sizeof(data)) != 0) {
+        writer.begin(CaptureRecord::SET_CAMERA);
+        writer.write(data);
+        writer.end();
+        lastCamera = data;
+        hasCamera = true;
+    }
+}
+
+void CaptureRendererBackend::captureLights(const std::vector<Light>* lights) {
+    currentLights.clear();
+    if (lights) {
+        for (const Light& light : *lights) {
+            CaptureLightData data;
+            data.type = static_cast<uint32_t>(light.type);
+            copyVector(data.direction, light.direction);
+            copyVector(data.position, light.position);
+            data.range = light.range;
+            currentLights.push_back(data);
+        }
+    }
+
+    if (hasLights && currentLights.size() == lastLights.size() &&
+        (currentLights.empty() ||
+         std::memcmp(currentLights.data(), lastLights.data(),
+                     currentLights.size() * sizeof(CaptureLightData)) == 0)) {
+        return;
+    }
+
+    writer.begin(CaptureRecord::SET_LIGHTS);
+    writer.write(static_cast<uint32_t>(currentLights.size()));
+    writer.write(currentLights.data(), currentLights.size() * sizeof(CaptureLightData));
+    writer.end();
+    lastLights.swap(currentLights);
+    hasLights = true;
+}
+
+unsigned int CaptureRendererBackend::loadTexture(const std::string& path, uint8_t filterType) {
+    unsigned int textureID = backend->loadTexture(path, filterType);
+    if (textureID != 0) {
+        TextureSource& source = textureSources[textureID];
+        source.paths = {path};
+        source.filterType = filterType;
+        source.cubemap = false;
+    }
+    return textureID;
+}
+
+unsigned int CaptureRendererBackend::createCubemapTexture(const std::vector<std::string>& faces) {
+    unsigned int textureID = backend->createCubemapTexture(faces);
+    if (textureID != 0) {
+        TextureSource& source = textureSources[textureID];
+        source.paths = faces;
+        source.filterType = 0;
+        source.cubemap = true;
+    }
+    return textureID;
+}
+
+void CaptureRendererBackend::drawSprite(const Sprite& sprite) {
+    if (capturing) {
+        captureTexture(sprite.getTexture());
+        CaptureSpriteData data;
+        data.texture = sprite.getTexture();
+        data.width = sprite.getWidth();
+        data.height = sprite.getHeight();
+        writer.begin(CaptureRecord::DRAW_SPRITE);
+        writer.write(data);
+        writer.end();
+    }
+    backend->drawSprite(sprite);
+}
+
+bool CaptureRendererBackend::init() { return backend->init(); }
+
+bool CaptureRendererBackend::init(SDL_Window* window) { return backend->init(window); }
+
+bool CaptureRendererBackend::initHeadless(int width, int height) {
+    return backend->initHeadless(width, height);
+}
+
+bool CaptureRendererBackend::readPixels(std::vector<uint8_t>& rgba, int& width, int& height) {
+    return backend->readPixels(rgba, width, height);
+}
+
+bool CaptureRendererBackend::initWindowContext() { return backend->initWindowContext(); }
+
+bool CaptureRendererBackend::makeCurrent() { return backend->makeCurrent(); }
+
+void CaptureRendererBackend::releaseCurrent() { backend->releaseCurrent(); }
+
+void CaptureRendererBackend::present(SDL_Window* window) {
+    backend->present(window);
+    if (!capturing) {
+        return;
+    }
+
+    writer.begin(CaptureRecord::PRESENT);
+    writer.end();
+    if (++framesCaptured == frameLimit) {
+        finishCapture();
+    }
+}
+
+void CaptureRendererBackend::bindCamera(Camera* camera) {
+    if (capturing && camera) {
+        captureCamera(*camera);
+        writer.begin(CaptureRecord::BIND_CAMERA);
+        writer.end();
+    }
+    mainCamera = camera;
+    backend->bindCamera(camera);
+}
+
+void CaptureRendererBackend::applyMaterial(Material* material) {
+    if (capturing && material) {
+        captureMaterial(*material);
+        writer.begin(CaptureRecord::APPLY_MATERIAL);
+        writer.write(material->getId());
+        writer.end();
+    }
+    backend->applyMaterial(material);
+}
+
+void CaptureRendererBackend::clear(Camera* camera) {
+    if (capturing) {
+        writer.begin(CaptureRecord::CLEAR);
+        writer.end();
+    }
+    backend->clear(camera);
+}
+
+void CaptureRendererBackend::draw(const Mesh& mesh) {
+    if (capturing) {
+        captureMesh(mesh);
+        writer.begin(CaptureRecord::DRAW);
+        writer.write(mesh.getId());
+        writer.end();
+    }
+    backend->draw(mesh);
+}
+
+bool CaptureRendererBackend::drawInstanced(const Mesh& mesh, const glm::mat4* models,
+                                           uint32_t count) {
+    // Se o backend recusar, o chamador desenha as copias com draw, que tambem e gravado
+    if (capturing) {
+        captureMesh(mesh);
+        writer.begin(CaptureRecord::DRAW_INSTANCED);
+        writer.write(mesh.getId());
+        writer.write(count);
+        writer.write(models, count * sizeof(glm::mat4));
+        writer.end();
+    }
+    return backend->drawInstanced(mesh, models, count);
+}
+
+GraphicsAPI CaptureRendererBackend::getGraphicsAPI() const { return backend->getGraphicsAPI(); }
+
+std::string CaptureRendererBackend::getShaderExtension() const {
+    return backend->getShaderExtension();
+}
+
+std::unique_ptr<ShaderProgram> CaptureRendererBackend::createShaderProgram() {
+    return backend->createShaderProgram();
+}
+
+std::unique_ptr<ShaderCompiler> CaptureRendererBackend::createShaderCompiler() {
+    return backend->createShaderCompiler();
+}
+
+std::unique_ptr<MeshBuffer> CaptureRendererBackend::createMeshBuffer() {
+    return backend->createMeshBuffer();
+}
+
+void CaptureRendererBackend::onCameraSet() { backend->setCamera(mainCamera); }
+
+void CaptureRendererBackend::setUniforms(ShaderProgram* shaderProgram) {
+    backend->setUniforms(shaderProgram);
+}
+
+unsigned int CaptureRendererBackend::getRequiredWindowFlags() const {
+    return backend->getRequiredWindowFlags();
+}
+
+void CaptureRendererBackend::renderGameObjects(std::vector<GameObject*>* gameObjects,
+                                               std::vector<Light>* lights) {
+    if (capturing) {
+        visibleIds.clear();
+        for (GameObject* gameObject : *gameObjects) {
+            if (uint32_t id = captureObject(*gameObject)) {
+                visibleIds.push_back(id);
+            }
+        }
+        captureLights(lights);
+
+        writer.begin(CaptureRecord::RENDER_OBJECTS);
+        writer.write(static_cast<uint32_t>(visibleIds.size()));
+        writer.write(visibleIds.data(), visibleIds.size() * sizeof(uint32_t));
+        writer.end();
+    }
+    backend->renderGameObjects(gameObjects, lights);
+}
+
+void CaptureRendererBackend::renderSkybox(const Mesh& mesh, unsigned int shaderProgram,
+                                          unsigned int textureID) {
+    // O handle do programa so vale neste backend; o material vem do skybox da camera
+    Skybox* skybox = mainCamera ? mainCamera->getSkybox() : nullptr;
+    if (capturing && skybox && skybox->getMaterial()) {
+        captureMaterial(*skybox->getMaterial());
+        captureMesh(mesh);
+        captureTexture(textureID);
+        writer.begin(CaptureRecord::DRAW_SKYBOX);
+        writer.write(mesh.getId());
+        writer.write(skybox->getMaterial()->getId());
+        writer.write(static_cast<uint32_t>(textureID));
+        writer.end();
+    }
+    backend->renderSkybox(mesh, shaderProgram, textureID);
+}
+
+void CaptureRendererBackend::setBufferDataImpl(const std::string& name, const void* data,
+                                               size_t size) {
+    if (capturing) {
+        writer.begin(CaptureRecord::SET_BUFFER_DATA);
+        writer.writeString(name);
+        writer.write(static_cast<uint32_t>(size));
+        writer.write(data, size);
+        writer.end();
+    }
+    backend->setBufferDataImpl(name, data, size);
+}
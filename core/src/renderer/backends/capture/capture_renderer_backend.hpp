@@ -0,0 +1,109 @@
+#ifndef CAPTURE_RENDERER_BACKEND_HPP
+#define CAPTURE_RENDERER_BACKEND_HPP
+
+#include "../../render_capture.hpp"
+#include "../../renderer_backend.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Envolve um backend real: toda chamada e repassada e, durante uma captura, tambem
+// gravada em memoria no formato de render_capture.hpp. O arquivo e escrito quando os
+// frames pedidos terminam (ou no destrutor, com o que houver). tools/render_replay
+// reproduz a captura em qualquer backend sem logica de jogo nem carga de cena.
+class CaptureRendererBackend : public RendererBackend {
+  private:
+    struct TextureSource {
+        std::vector<std::string> paths;
+        uint8_t filterType = 0;
+        bool cubemap = false;
+    };
+
+    struct CapturedObject {
+        uint32_t id = 0;
+        const Mesh* mesh = nullptr;
+        const Material* material = nullptr;
+        unsigned int texture = 0;
+        float spriteWidth = 0.0f;
+        float spriteHeight = 0.0f;
+        bool hasTransform = false;
+        CaptureTransformData transform;
+    };
+
+    std::unique_ptr<RendererBackend> backend;
+    // Origem de todas as texturas, capturando ou nao: a cena costuma carregar antes
+    std::unordered_map<unsigned int, TextureSource> textureSources;
+
+    CaptureWriter writer;
+    std::string capturePath;
+    uint32_t frameLimit = 0;
+    uint32_t framesCaptured = 0;
+    bool capturing = false;
+
+    // Recursos ja gravados na captura atual
+    std::unordered_set<uint32_t> capturedMeshes;
+    std::unordered_set<uint32_t> capturedMaterials;
+    std::unordered_set<unsigned int> capturedTextures;
+    std::unordered_map<const GameObject*, CapturedObject> capturedObjects;
+    uint32_t nextObjectId = 1;
+    std::vector<uint32_t> visibleIds;
+    CaptureCameraData lastCamera;
+    bool hasCamera = false;
+    std::vector<CaptureLightData> lastLights;
+    std::vector<CaptureLightData> currentLights;
+    bool hasLights = false;
+
+    std::string shaderBasePath(const ShaderAsset* shader) const;
+    void captureMesh(const Mesh& mesh);
+    void captureMaterial(const Material& material);
+    void captureTexture(unsigned int textureID);
+    uint32_t captureObject(GameObject& gameObject);
+    void captureCamera(Camera& camera);
+    void captureLights(const std::vector<Light>* lights);
+    void finishCapture();
+
+  public:
+    explicit CaptureRendererBackend(std::unique_ptr<RendererBackend> backend);
+    ~CaptureRendererBackend() override;
+
+    // Grava os proximos frames em path; o arquivo e escrito ao fim do frame numero frames
+    bool startCapture(const std::string& path, uint32_t frames);
+    bool isCapturing() const { return capturing; }
+    RendererBackend* getBackend() { return backend.get(); }
+
+    unsigned int loadTexture(const std::string& path, uint8_t filterType = 0) override;
+    void drawSprite(const Sprite& sprite) override;
+    bool init() override;
+    bool init(SDL_Window* window) override;
+    bool initHeadless(int width, int height) override;
+    bool readPixels(std::vector<uint8_t>& rgba, int& width, int& height) override;
+    void present(SDL_Window* window) override;
+    bool initWindowContext() override;
+    bool makeCurrent() override;
+    void releaseCurrent() override;
+    void bindCamera(Camera* camera) override;
+    void applyMaterial(Material* material) override;
+    void clear(Camera* camera) override;
+    void draw(const Mesh& mesh) override;
+    bool drawInstanced(const Mesh& mesh, const glm::mat4* models, uint32_t count) override;
+    GraphicsAPI getGraphicsAPI() const override;
+    std::string getShaderExtension() const override;
+    unsigned int createCubemapTexture(const std::vector<std::string>& faces) override;
+    std::unique_ptr<ShaderProgram> createShaderProgram() override;
+    std::unique_ptr<ShaderCompiler> createShaderCompiler() override;
+    std::unique_ptr<MeshBuffer> createMeshBuffer() override;
+    void onCameraSet() override;
+    void setUniforms(ShaderProgram* shaderProgram) override;
+    unsigned int getRequiredWindowFlags() const override;
+
+    void renderGameObjects(std::vector<GameObject*>* gameObjects,
+                           std::vector<Light>* lights) override;
+    void renderSkybox(const Mesh& mesh, unsigned int shaderProgram,
+                      unsigned int textureID) override;
+    void setBufferDataImpl(const std::string& name, const void* data, size_t size) override;
+};
+
+#endif // CAPTURE_RENDERER_BACKEND_HPP
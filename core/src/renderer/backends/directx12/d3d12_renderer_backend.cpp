@@ -4,6 +4,7 @@
 #include "../../../mesh_buffer_factory.hpp"
 #include "../../../shader_compiler_factory.hpp"
 #include "../../../shader_program_factory.hpp"
+#include "../../../trace.hpp"
 #include "d3d12_mesh_buffer.hpp"
 #include "d3d12_renderer_backend.hpp"
 #include "d3d12_shader_program.hpp"
@@ -384,6 +385,7 @@ void D3D12RendererBackend::updateConstantBuffer(int binding, const void* data, s
 }
 
 unsigned int D3D12RendererBackend::createCubemapTexture(const std::vector<std::string>& faces) {
+    TRACE_ZONE("D3D12RendererBackend::createCubemapTexture");
     return 0;
 }
 
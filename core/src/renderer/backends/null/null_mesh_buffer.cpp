@@ -0,0 +1,12 @@
+#include "null_mesh_buffer.hpp"
+#include "null_renderer_backend.hpp"
+
+bool NullMeshBuffer::createBuffers(const std::vector<float>& vertices,
+                                   const std::vector<float>& normals) {
+    vertexCount = static_cast<uint32_t>(vertices.size() / 3);
+    if (backend) {
+        backend->recordMeshUpload(vertexCount,
+                                  (vertices.size() + normals.size()) * sizeof(float));
+    }
+    return true;
+}
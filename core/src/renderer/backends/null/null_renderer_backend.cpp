@@ -0,0 +1,253 @@
+#define CLASS_NAME "NullRendererBackend"
+#include "../../../log_macros.hpp"
+
+#include "../../../material.hpp"
+#include "mesh_buffer_factory.hpp"
+#include "null_renderer_backend.hpp"
+#include "shader_compiler_factory.hpp"
+#include "shader_program_factory.hpp"
+#include <glm/glm.hpp>
+
+namespace {
+// Mesmos blocos que o backend OpenGL envia por draw (Matrices e MaterialData)
+constexpr uint64_t MATRICES_BLOCK_SIZE = 3 * sizeof(glm::mat4);
+constexpr uint64_t MATERIAL_BLOCK_SIZE = sizeof(glm::vec4);
+constexpr uint32_t SPRITE_VERTEX_COUNT = 6;
+} // namespace
+
+void NullRendererBackend::Counters::add(const Counters& other) {
+    frames += other.frames;
+    clears += other.clears;
+    cameraBinds += other.cameraBinds;
+    materialBinds += other.materialBinds;
+    uniformUpdates += other.uniformUpdates;
+    drawCalls += other.drawCalls;
+    instancedDrawCalls += other.instancedDrawCalls;
+    instances += other.instances;
+    spriteDraws += other.spriteDraws;
+    skyboxDraws += other.skyboxDraws;
+    vertices += other.vertices;
+    meshBuffers += other.meshBuffers;
+    shaderPrograms += other.shaderPrograms;
+    shaderCompiles += other.shaderCompiles;
+    textures += other.textures;
+    bytesUploaded += other.bytesUploaded;
+}
+
+GraphicsAPI NullRendererBackend::getGraphicsAPI() const { return GraphicsAPI::NONE; }
+
+std::string NullRendererBackend::getShaderExtension() const { return ""; }
+
+unsigned int NullRendererBackend::getRequiredWindowFlags() const { return 0; }
+
+std::unique_ptr<ShaderProgram> NullRendererBackend::createShaderProgram() {
+    frameCounters.shaderPrograms++;
+    record(NullCommandType::CREATE_SHADER_PROGRAM);
+    return ShaderProgramFactory::create(getGraphicsAPI(), this);
+}
+
+std::unique_ptr<MeshBuffer> NullRendererBackend::createMeshBuffer() {
+    return MeshBufferFactory::create(getGraphicsAPI(), this);
+}
+
+std::unique_ptr<ShaderCompiler> NullRendererBackend::createShaderCompiler() {
+    return ShaderCompilerFactory::create(getGraphicsAPI(), this);
+}
+
+bool NullRendererBackend::initWindowContext() { return true; }
+
+bool NullRendererBackend::init(SDL_Window* window) { return init(); }
+
+bool NullRendererBackend::init() {
+    resetCounters();
+    LOG_INFO("Null renderer backend, nothing will be drawn");
+    return true;
+}
+
+void NullRendererBackend::record(NullCommandType type, uint32_t id, uint64_t value) {
+    if (recording) {
+        commandLog.push_back({type, id, value});
+    }
+}
+
+void NullRendererBackend::recordMeshUpload(uint32_t vertexCount, uint64_t bytes) {
+    frameCounters.meshBuffers++;
+    frameCounters.bytesUploaded += bytes;
+    record(NullCommandType::CREATE_MESH_BUFFER, vertexCount, bytes);
+}
+
+void NullRendererBackend::recordUniformUpload(uint64_t bytes) {
+    frameCounters.uniformUpdates++;
+    frameCounters.bytesUploaded += bytes;
+    record(NullCommandType::UNIFORM_UPDATE, 0, bytes);
+}
+
+void NullRendererBackend::recordShaderCompile() {
+    frameCounters.shaderCompiles++;
+    record(NullCommandType::COMPILE_SHADER);
+}
+
+NullRendererBackend::Counters NullRendererBackend::getTotalCounters() const {
+    Counters total = totalCounters;
+    total.add(frameCounters);
+    return total;
+}
+
+void NullRendererBackend::resetCounters() {
+    frameCounters = Counters();
+    lastFrameCounters = Counters();
+    totalCounters = Counters();
+}
+
+void NullRendererBackend::onCameraSet() {}
+
+void NullRendererBackend::bindCamera(Camera* camera) {
+    if (!camera) {
+        LOG_ERROR("Camera is null");
+        return;
+    }
+    mainCamera = camera;
+    frameCounters.cameraBinds++;
+    record(NullCommandType::BIND_CAMERA);
+}
+
+void NullRendererBackend::clear(Camera* camera) {
+    frameCounters.clears++;
+    record(NullCommandType::CLEAR);
+}
+
+void NullRendererBackend::setBufferDataImpl(const std::string& name, const void* data,
+                                            size_t size) {
+    frameCounters.uniformUpdates++;
+    frameCounters.bytesUploaded += size;
+    record(NullCommandType::SET_BUFFER_DATA, 0, size);
+}
+
+void NullRendererBackend::setUniforms(ShaderProgram* shaderProgram) {
+    if (shaderProgram && shaderProgram->isValid()) {
+        shaderProgram->use();
+    }
+}
+
+void NullRendererBackend::applyMaterial(Material* material) {
+    auto program = material ? material->getShaderProgram() : nullptr;
+    if (!program || !program->isValid()) {
+        return;
+    }
+
+    frameCounters.materialBinds++;
+    record(NullCommandType::APPLY_MATERIAL, material->getId());
+    setUniforms(program);
+}
+
+void NullRendererBackend::draw(const Mesh& mesh) {
+    uint64_t vertexCount = mesh.getVertices().size() / 3;
+    frameCounters.drawCalls++;
+    frameCounters.vertices += vertexCount;
+    record(NullCommandType::DRAW, mesh.getId(), vertexCount);
+}
+
+bool NullRendererBackend::drawInstanced(const Mesh& mesh, const glm::mat4* models,
+                                        uint32_t count) {
+    if (count == 0) {
+        return false;
+    }
+
+    frameCounters.instancedDrawCalls++;
+    frameCounters.instances += count;
+    frameCounters.vertices += mesh.getVertices().size() / 3 * count;
+    frameCounters.bytesUploaded += count * sizeof(glm::mat4);
+    record(NullCommandType::DRAW_INSTANCED, mesh.getId(), count);
+    return true;
+}
+
+void NullRendererBackend::drawSprite(const Sprite& sprite) {
+    frameCounters.spriteDraws++;
+    frameCounters.vertices += SPRITE_VERTEX_COUNT;
+    record(NullCommandType::DRAW_SPRITE, sprite.getTexture(), SPRITE_VERTEX_COUNT);
+}
+
+void NullRendererBackend::renderGameObjects(std::vector<GameObject*>* gameObjects,
+                                            std::vector<Light>* lights) {
+    renderQueue.build(*gameObjects, mainCamera);
+
+    Material* lastMaterial = nullptr;
+    for (size_t i = 0; i < renderQueue.size(); i++) {
+        const RenderItem& item = renderQueue[i];
+        if (item.material != lastMaterial) {
+            applyMaterial(item.material);
+            recordUniformUpload(MATERIAL_BLOCK_SIZE);
+            lastMaterial = item.material;
+        }
+        recordUniformUpload(MATRICES_BLOCK_SIZE);
+
+        if (item.sprite) {
+            drawSprite(*item.sprite);
+        } else {
+            draw(*item.mesh);
+        }
+    }
+}
+
+void NullRendererBackend::renderSkybox(const Mesh& mesh, unsigned int shaderProgram,
+                                       unsigned int textureID) {
+    frameCounters.skyboxDraws++;
+    frameCounters.vertices += mesh.getVertices().size() / 3;
+    record(NullCommandType::DRAW_SKYBOX, textureID);
+}
+
+void NullRendererBackend::present(SDL_Window* window) {
+    frameCounters.frames++;
+    record(NullCommandType::PRESENT);
+
+    totalCounters.add(frameCounters);
+    lastFrameCounters = frameCounters;
+    frameCounters = Counters();
+}
+
+unsigned int NullRendererBackend::loadTexture(const std::string& path, uint8_t filterType) {
+    frameCounters.textures++;
+    record(NullCommandType::LOAD_TEXTURE, nextTextureId);
+    return nextTextureId++;
+}
+
+unsigned int NullRendererBackend::createCubemapTexture(const std::vector<std::string>& faces) {
+    frameCounters.textures++;
+    record(NullCommandType::LOAD_TEXTURE, nextTextureId, faces.size());
+    return nextTextureId++;
+}
+
+const char* NullRendererBackend::getCommandName(NullCommandType type) {
+    switch (type) {
+    case NullCommandType::CLEAR:
+        return "clear";
+    case NullCommandType::BIND_CAMERA:
+        return "bindCamera";
+    case NullCommandType::APPLY_MATERIAL:
+        return "applyMaterial";
+    case NullCommandType::SET_BUFFER_DATA:
+        return "setBufferData";
+    case NullCommandType::UNIFORM_UPDATE:
+        return "uniformUpdate";
+    case NullCommandType::DRAW:
+        return "draw";
+    case NullCommandType::DRAW_INSTANCED:
+        return "drawInstanced";
+    case NullCommandType::DRAW_SPRITE:
+        return "drawSprite";
+    case NullCommandType::DRAW_SKYBOX:
+        return "drawSkybox";
+    case NullCommandType::CREATE_MESH_BUFFER:
+        return "createMeshBuffer";
+    case NullCommandType::CREATE_SHADER_PROGRAM:
+        return "createShaderProgram";
+    case NullCommandType::COMPILE_SHADER:
+        return "compileShader";
+    case NullCommandType::LOAD_TEXTURE:
+        return "loadTexture";
+    case NullCommandType::PRESENT:
+        return "present";
+    default:
+        return "unknown";
+    }
+}
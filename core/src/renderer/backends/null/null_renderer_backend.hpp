@@ -0,0 +1,125 @@
+#ifndef NULL_RENDERER_BACKEND_HPP
+#define NULL_RENDERER_BACKEND_HPP
+
+#include "../../../graphics_api.hpp"
+#include "../../render_queue.hpp"
+#include "../../renderer_backend.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class NullCommandType : uint8_t {
+    CLEAR,
+    BIND_CAMERA,
+    APPLY_MATERIAL,
+    SET_BUFFER_DATA,
+    UNIFORM_UPDATE,
+    DRAW,
+    DRAW_INSTANCED,
+    DRAW_SPRITE,
+    DRAW_SKYBOX,
+    CREATE_MESH_BUFFER,
+    CREATE_SHADER_PROGRAM,
+    COMPILE_SHADER,
+    LOAD_TEXTURE,
+    PRESENT
+};
+
+// Entrada compacta do log de comandos. id e o objeto envolvido (material, mesh,
+// textura...) e value o dado relevante (vertices, instancias, bytes).
+struct NullCommand {
+    NullCommandType type;
+    uint32_t id;
+    uint64_t value;
+};
+
+// Backend que nao desenha nada: toda chamada so e contada. Sem janela nem contexto,
+// serve para medir o custo do proprio engine (SceneLoader, Renderer::render, culling,
+// ordenacao) separado do driver. A fila de render e montada e ordenada como nos
+// backends reais.
+class NullRendererBackend : public RendererBackend {
+  public:
+    struct Counters {
+        uint64_t frames = 0;
+        uint64_t clears = 0;
+        uint64_t cameraBinds = 0;
+        uint64_t materialBinds = 0;
+        uint64_t uniformUpdates = 0;
+        uint64_t drawCalls = 0;
+        uint64_t instancedDrawCalls = 0;
+        uint64_t instances = 0;
+        uint64_t spriteDraws = 0;
+        uint64_t skyboxDraws = 0;
+        uint64_t vertices = 0;
+        uint64_t meshBuffers = 0;
+        uint64_t shaderPrograms = 0;
+        uint64_t shaderCompiles = 0;
+        uint64_t textures = 0;
+        // Tudo o que um backend real enviaria a GPU: meshes, uniforms, instancias
+        uint64_t bytesUploaded = 0;
+
+        void add(const Counters& other);
+    };
+
+  private:
+    // Por frame (zerados em present) e acumulados desde o init
+    Counters frameCounters;
+    Counters lastFrameCounters;
+    Counters totalCounters;
+
+    bool recording = false;
+    std::vector<NullCommand> commandLog;
+    RenderQueue renderQueue;
+    unsigned int nextTextureId = 1;
+
+    void record(NullCommandType type, uint32_t id = 0, uint64_t value = 0);
+
+  public:
+    unsigned int loadTexture(const std::string& path, uint8_t filterType = 0) override;
+    void drawSprite(const Sprite& sprite) override;
+    bool init() override;
+    bool init(SDL_Window* window) override;
+    bool initHeadless(int width, int height) override { return init(); }
+    void present(SDL_Window* window) override;
+    bool initWindowContext() override;
+    void bindCamera(Camera* camera) override;
+    void applyMaterial(Material* material) override;
+    void setBufferDataImpl(const std::string& name, const void* data, size_t size) override;
+    void clear(Camera* camera) override;
+    void draw(const Mesh&) override;
+    bool drawInstanced(const Mesh& mesh, const glm::mat4* models, uint32_t count) override;
+    void setUniforms(ShaderProgram* shaderProgram) override;
+    unsigned int createCubemapTexture(const std::vector<std::string>& faces) override;
+    std::unique_ptr<ShaderProgram> createShaderProgram() override;
+    std::unique_ptr<ShaderCompiler> createShaderCompiler() override;
+    std::unique_ptr<MeshBuffer> createMeshBuffer() override;
+    void onCameraSet() override;
+    GraphicsAPI getGraphicsAPI() const override;
+    std::string getShaderExtension() const override;
+    unsigned int getRequiredWindowFlags() const override;
+
+    void renderGameObjects(std::vector<GameObject*>* gameObjects,
+                           std::vector<Light>* lights) override;
+    void renderSkybox(const Mesh& mesh, unsigned int shaderProgram,
+                      unsigned int textureID) override;
+
+    // Chamados pelos mesh buffers, programas e compiladores deste backend
+    void recordMeshUpload(uint32_t vertexCount, uint64_t bytes);
+    void recordUniformUpload(uint64_t bytes);
+    void recordShaderCompile();
+
+    const Counters& getFrameCounters() const { return frameCounters; }
+    const Counters& getLastFrameCounters() const { return lastFrameCounters; }
+    // Inclui o frame em andamento
+    Counters getTotalCounters() const;
+    void resetCounters();
+
+    // Log de comandos desligado por padrao; cada entrada ocupa 16 bytes
+    void setRecording(bool value) { recording = value; }
+    bool isRecording() const { return recording; }
+    const std::vector<NullCommand>& getCommandLog() const { return commandLog; }
+    void clearCommandLog() { commandLog.clear(); }
+    static const char* getCommandName(NullCommandType type);
+};
+
+#endif // NULL_RENDERER_BACKEND_HPP
@@ -0,0 +1,13 @@
+#include "null_shader_compiler.hpp"
+#include "null_renderer_backend.hpp"
+
+bool NullShaderCompiler::compile(const std::string& source, ShaderType type, void** outHandle) {
+    // Qualquer ponteiro nao nulo serve de handle
+    static int handle = 0;
+    *outHandle = &handle;
+
+    if (backend) {
+        backend->recordShaderCompile();
+    }
+    return true;
+}
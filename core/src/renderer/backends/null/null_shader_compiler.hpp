@@ -0,0 +1,21 @@
+#ifndef NULL_SHADER_COMPILER_HPP
+#define NULL_SHADER_COMPILER_HPP
+
+#include "../../../shader_compiler.hpp"
+
+class NullRendererBackend;
+
+// Nao le o arquivo; todo shader "compila" com sucesso
+class NullShaderCompiler : public ShaderCompiler {
+  private:
+    NullRendererBackend* backend;
+
+  public:
+    explicit NullShaderCompiler(NullRendererBackend* backend) : backend(backend) {}
+
+    bool compile(const std::string& source, ShaderType type, void** outHandle) override;
+    void destroy(void* handle) override {}
+    bool isValid(void* handle) override { return handle != nullptr; }
+};
+
+#endif // NULL_SHADER_COMPILER_HPP
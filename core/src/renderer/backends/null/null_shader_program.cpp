@@ -0,0 +1,8 @@
+#include "null_shader_program.hpp"
+#include "null_renderer_backend.hpp"
+
+void NullShaderProgram::setUniformBuffer(const char* name, const void* data, size_t size) {
+    if (backend) {
+        backend->recordUniformUpload(size);
+    }
+}
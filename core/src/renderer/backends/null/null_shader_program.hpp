@@ -0,0 +1,28 @@
+#ifndef NULL_SHADER_PROGRAM_HPP
+#define NULL_SHADER_PROGRAM_HPP
+
+#include "../../../shader_program.hpp"
+
+class NullRendererBackend;
+
+class NullShaderProgram : public ShaderProgram {
+  private:
+    NullRendererBackend* backend;
+    bool linked = false;
+
+  public:
+    explicit NullShaderProgram(NullRendererBackend* backend) : backend(backend) {}
+
+    bool attachShader(const ShaderAsset& shader) override { return true; }
+    bool link() override {
+        linked = true;
+        return true;
+    }
+    void use() override {}
+    // Conta os bytes que um backend real enviaria
+    void setUniformBuffer(const char* name, const void* data, size_t size) override;
+    void* getHandle() const override { return const_cast<NullShaderProgram*>(this); }
+    bool isValid() const override { return linked; }
+};
+
+#endif // NULL_SHADER_PROGRAM_HPP
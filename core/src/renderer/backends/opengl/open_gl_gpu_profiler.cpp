@@ -0,0 +1,51 @@
+#define CLASS_NAME "OpenGLGpuProfiler"
+#include "../../../log_macros.hpp"
+
+#include "open_gl_gpu_profiler.hpp"
+
+OpenGLGpuProfiler::~OpenGLGpuProfiler() { destroy(); }
+
+bool OpenGLGpuProfiler::init() {
+    destroy();
+    if (!GLEW_VERSION_3_3 && !GLEW_ARB_timer_query) {
+        LOG_WARN("Timer queries not supported, GPU timings disabled");
+        return false;
+    }
+
+    GLint counterBits = 0;
+    glGetQueryiv(GL_TIMESTAMP, GL_QUERY_COUNTER_BITS, &counterBits);
+    if (counterBits == 0) {
+        LOG_WARN("GL_TIMESTAMP has no counter bits, GPU timings disabled");
+        return false;
+    }
+
+    glGenQueries(FRAME_LATENCY * QUERIES_PER_SLOT, queries);
+    supported = true;
+    return true;
+}
+
+void OpenGLGpuProfiler::destroy() {
+    if (!supported) {
+        return;
+    }
+    glDeleteQueries(FRAME_LATENCY * QUERIES_PER_SLOT, queries);
+    supported = false;
+}
+
+void OpenGLGpuProfiler::writeTimestamp(uint32_t slot, uint32_t query) {
+    glQueryCounter(queries[slot * QUERIES_PER_SLOT + query], GL_TIMESTAMP);
+}
+
+bool OpenGLGpuProfiler::readTimestamp(uint32_t slot, uint32_t query, uint64_t& ns) {
+    GLuint id = queries[slot * QUERIES_PER_SLOT + query];
+    GLint available = GL_FALSE;
+    glGetQueryObjectiv(id, GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) {
+        return false;
+    }
+
+    GLuint64 result = 0;
+    glGetQueryObjectui64v(id, GL_QUERY_RESULT, &result);
+    ns = result;
+    return true;
+}
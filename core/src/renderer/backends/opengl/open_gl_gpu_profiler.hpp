@@ -0,0 +1,26 @@
+#ifndef OPEN_GL_GPU_PROFILER_HPP
+#define OPEN_GL_GPU_PROFILER_HPP
+
+#include "../../gpu_profiler.hpp"
+#include <GL/glew.h>
+
+// Timestamps com glQueryCounter(GL_TIMESTAMP): diferente de GL_TIME_ELAPSED, permite
+// medir passes e o frame inteiro sem restricao de aninhamento
+class OpenGLGpuProfiler : public GpuProfiler {
+  private:
+    GLuint queries[FRAME_LATENCY * QUERIES_PER_SLOT] = {};
+
+  protected:
+    void resetQueries(uint32_t slot) override {}
+    void writeTimestamp(uint32_t slot, uint32_t query) override;
+    bool readTimestamp(uint32_t slot, uint32_t query, uint64_t& ns) override;
+
+  public:
+    ~OpenGLGpuProfiler();
+
+    // Precisa do contexto atual; sem timer queries o profiler fica desligado
+    bool init();
+    void destroy();
+};
+
+#endif // OPEN_GL_GPU_PROFILER_HPP
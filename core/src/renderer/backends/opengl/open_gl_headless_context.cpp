@@ -0,0 +1,183 @@
+#define CLASS_NAME "OpenGLHeadlessContext"
+#include "../../../log_macros.hpp"
+
+#include "open_gl_headless_context.hpp"
+
+#ifdef YUME_HAS_EGL
+#define EGL_NO_X11
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <cstring>
+#include <string>
+
+namespace {
+bool hasExtension(const char* extensions, const char* name) {
+    if (!extensions) {
+        return false;
+    }
+    size_t length = std::strlen(name);
+    for (const char* p = std::strstr(extensions, name); p; p = std::strstr(p + length, name)) {
+        bool start = p == extensions || p[-1] == ' ';
+        bool end = p[length] == ' ' || p[length] == '\0';
+        if (start && end) {
+            return true;
+        }
+    }
+    return false;
+}
+
+EGLDisplay openDisplay() {
+    const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if (hasExtension(clientExtensions, "EGL_MESA_platform_surfaceless")) {
+        auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+            eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        if (getPlatformDisplay) {
+            EGLDisplay display =
+                getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+            if (display != EGL_NO_DISPLAY) {
+                return display;
+            }
+        }
+    }
+    return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+} // namespace
+
+OpenGLHeadlessContext::~OpenGLHeadlessContext() { destroy(); }
+
+bool OpenGLHeadlessContext::create(int width, int height) {
+    EGLDisplay eglDisplay = openDisplay();
+    if (eglDisplay == EGL_NO_DISPLAY) {
+        LOG_ERROR("No EGL display available");
+        return false;
+    }
+
+    EGLint major = 0, minor = 0;
+    if (!eglInitialize(eglDisplay, &major, &minor)) {
+        LOG_ERROR("eglInitialize failed: " + std::to_string(eglGetError()));
+        return false;
+    }
+    display = eglDisplay;
+
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        LOG_ERROR("EGL display does not support desktop OpenGL");
+        destroy();
+        return false;
+    }
+
+    const char* displayExtensions = eglQueryString(eglDisplay, EGL_EXTENSIONS);
+    bool surfaceless = hasExtension(displayExtensions, "EGL_KHR_surfaceless_context");
+
+    const EGLint configAttributes[] = {EGL_SURFACE_TYPE,
+                                       surfaceless ? 0 : EGL_PBUFFER_BIT,
+                                       EGL_RENDERABLE_TYPE,
+                                       EGL_OPENGL_BIT,
+                                       EGL_RED_SIZE,
+                                       8,
+                                       EGL_GREEN_SIZE,
+                                       8,
+                                       EGL_BLUE_SIZE,
+                                       8,
+                                       EGL_ALPHA_SIZE,
+                                       8,
+                                       EGL_DEPTH_SIZE,
+                                       24,
+                                       EGL_NONE};
+    EGLConfig config = nullptr;
+    EGLint configCount = 0;
+    if (!eglChooseConfig(eglDisplay, configAttributes, &config, 1, &configCount) ||
+        configCount == 0) {
+        LOG_ERROR("No matching EGL config");
+        destroy();
+        return false;
+    }
+
+    const EGLint contextAttributes[] = {EGL_CONTEXT_MAJOR_VERSION,
+                                        3,
+                                        EGL_CONTEXT_MINOR_VERSION,
+                                        3,
+                                        EGL_CONTEXT_OPENGL_PROFILE_MASK,
+                                        EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+                                        EGL_NONE};
+    EGLContext eglContext =
+        eglCreateContext(eglDisplay, config, EGL_NO_CONTEXT, contextAttributes);
+    if (eglContext == EGL_NO_CONTEXT) {
+        LOG_ERROR("Failed to create OpenGL 3.3 core context: " +
+                  std::to_string(eglGetError()));
+        destroy();
+        return false;
+    }
+    context = eglContext;
+
+    EGLSurface eglSurface = EGL_NO_SURFACE;
+    if (!surfaceless) {
+        const EGLint pbufferAttributes[] = {EGL_WIDTH, width, EGL_HEIGHT, height, EGL_NONE};
+        eglSurface = eglCreatePbufferSurface(eglDisplay, config, pbufferAttributes);
+        if (eglSurface == EGL_NO_SURFACE) {
+            LOG_ERROR("Failed to create EGL pbuffer");
+            destroy();
+            return false;
+        }
+        surface = eglSurface;
+    }
+
+    if (!eglMakeCurrent(eglDisplay, eglSurface, eglSurface, eglContext)) {
+        LOG_ERROR("eglMakeCurrent failed: " + std::to_string(eglGetError()));
+        destroy();
+        return false;
+    }
+
+    const char* vendor = eglQueryString(eglDisplay, EGL_VENDOR);
+    LOG_INFO("EGL " + std::to_string(major) + "." + std::to_string(minor) + " (" +
+             (vendor ? vendor : "unknown") + ")" + (surfaceless ? ", surfaceless" : ", pbuffer"));
+    return true;
+}
+
+bool OpenGLHeadlessContext::makeCurrent() {
+    if (!eglMakeCurrent(display, surface ? surface : EGL_NO_SURFACE,
+                        surface ? surface : EGL_NO_SURFACE, context)) {
+        LOG_ERROR("eglMakeCurrent failed: " + std::to_string(eglGetError()));
+        return false;
+    }
+    return true;
+}
+
+void OpenGLHeadlessContext::releaseCurrent() {
+    if (display) {
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    }
+}
+
+void OpenGLHeadlessContext::destroy() {
+    if (!display) {
+        return;
+    }
+    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (surface) {
+        eglDestroySurface(display, surface);
+    }
+    if (context) {
+        eglDestroyContext(display, context);
+    }
+    eglTerminate(display);
+    display = nullptr;
+    context = nullptr;
+    surface = nullptr;
+}
+
+#else
+
+OpenGLHeadlessContext::~OpenGLHeadlessContext() {}
+
+bool OpenGLHeadlessContext::create(int width, int height) {
+    LOG_ERROR("Built without EGL, headless OpenGL is not available");
+    return false;
+}
+
+void OpenGLHeadlessContext::destroy() {}
+
+bool OpenGLHeadlessContext::makeCurrent() { return false; }
+
+void OpenGLHeadlessContext::releaseCurrent() {}
+
+#endif
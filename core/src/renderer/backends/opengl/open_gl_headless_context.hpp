@@ -0,0 +1,28 @@
+#ifndef OPEN_GL_HEADLESS_CONTEXT_HPP
+#define OPEN_GL_HEADLESS_CONTEXT_HPP
+
+// Contexto OpenGL 3.3 core sem janela via EGL. Usa a plataforma surfaceless da Mesa
+// quando existe (nao precisa de X11/Wayland, funciona em CI) e cai para o display
+// padrao; o contexto fica current sem surface (EGL_KHR_surfaceless_context) ou com um
+// pbuffer pequeno. A renderizacao em si vai para um FBO do backend.
+//
+// So existe com YUME_HAS_EGL; sem ele create() falha.
+class OpenGLHeadlessContext {
+  private:
+    // EGLDisplay, EGLContext e EGLSurface, mantidos opacos para nao puxar EGL/egl.h
+    void* display = nullptr;
+    void* context = nullptr;
+    void* surface = nullptr;
+
+  public:
+    ~OpenGLHeadlessContext();
+
+    bool create(int width, int height);
+    void destroy();
+    // Liga/solta o contexto na thread atual (thread de render)
+    bool makeCurrent();
+    void releaseCurrent();
+    bool isValid() const { return context != nullptr; }
+};
+
+#endif // OPEN_GL_HEADLESS_CONTEXT_HPP
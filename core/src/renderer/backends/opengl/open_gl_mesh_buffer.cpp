@@ -1,4 +1,10 @@
+#include "engine_stats.hpp"
 #include "open_gl_mesh_buffer.hpp"
+#include "open_gl_renderer_backend.hpp"
+#include "open_gl_state_cache.hpp"
+
+OpenGLMeshBuffer::OpenGLMeshBuffer(OpenGLRendererBackend* backend)
+    : state(&backend->getStateCache()) {}
 
 OpenGLMeshBuffer::~OpenGLMeshBuffer() { 
     destroy(); 
@@ -13,37 +19,62 @@ bool OpenGLMeshBuffer::createBuffers(const std::vector<float>& vertices, const s
     glGenBuffers(1, &positionVBO);
     glGenBuffers(1, &normalVBO);
 
-    glBindVertexArray(VAO);
+    // Sem unbind no final: o cache sabe qual VAO ficou ligado
+    state->bindVertexArray(VAO);
     
     // Position buffer
-    glBindBuffer(GL_ARRAY_BUFFER, positionVBO);
+    state->bindBuffer(GL_ARRAY_BUFFER, positionVBO);
     glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, (void*)0);
     glEnableVertexAttribArray(0);
     
     // Normal buffer
-    glBindBuffer(GL_ARRAY_BUFFER, normalVBO);
+    state->bindBuffer(GL_ARRAY_BUFFER, normalVBO);
     glBufferData(GL_ARRAY_BUFFER, normals.size() * sizeof(float), normals.data(), GL_STATIC_DRAW);
     glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, (void*)0);
     glEnableVertexAttribArray(1);
 
-    glBindVertexArray(0);
+    EngineStats::current().bytesUploaded += (vertices.size() + normals.size()) * sizeof(float);
     return true;
 }
 
+void OpenGLMeshBuffer::bindInstanceBuffer(GLuint buffer, uint32_t generation, GLintptr offset) {
+    if (buffer == instanceVBO && generation == instanceGeneration && offset == instanceOffset) {
+        return;
+    }
+
+    state->bindBuffer(GL_ARRAY_BUFFER, buffer);
+    for (GLuint column = 0; column < 4; column++) {
+        GLuint location = 2 + column;
+        glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, sizeof(float) * 16,
+                              reinterpret_cast<void*>(offset + column * sizeof(float) * 4));
+        glVertexAttribDivisor(location, 1);
+        glEnableVertexAttribArray(location);
+    }
+
+    instanceVBO = buffer;
+    instanceGeneration = generation;
+    instanceOffset = offset;
+}
+
 void OpenGLMeshBuffer::bind() {
-    glBindVertexArray(VAO);
+    state->bindVertexArray(VAO);
 }
 
 void OpenGLMeshBuffer::unbind() {
-    glBindVertexArray(0);
+    state->bindVertexArray(0);
 }
 
 void OpenGLMeshBuffer::destroy() {
     if (VAO != 0) {
+        state->forgetVertexArray(VAO);
+        state->forgetBuffer(positionVBO);
+        state->forgetBuffer(normalVBO);
         glDeleteVertexArrays(1, &VAO);
         glDeleteBuffers(1, &positionVBO);
         glDeleteBuffers(1, &normalVBO);
         VAO = positionVBO = normalVBO = 0;
+        instanceVBO = 0;
+        instanceOffset = -1;
     }
 }
@@ -3,14 +3,25 @@
 
 #include "mesh_buffer.hpp"
 #include <GL/glew.h>
+#include <cstdint>
+
+class OpenGLStateCache;
+class OpenGLRendererBackend;
 
 class OpenGLMeshBuffer : public MeshBuffer {
 private:
+    OpenGLStateCache* state;
     GLuint VAO = 0;
     GLuint positionVBO = 0;
     GLuint normalVBO = 0;
 
+    // Buffer/offset atualmente ligados aos atributos por instancia (2..5)
+    GLuint instanceVBO = 0;
+    uint32_t instanceGeneration = 0;
+    GLintptr instanceOffset = -1;
+
 public:
+    explicit OpenGLMeshBuffer(OpenGLRendererBackend* backend);
     ~OpenGLMeshBuffer() override;
     
     bool createBuffers(const std::vector<float>& vertices, const std::vector<float>& normals) override;
@@ -18,6 +29,11 @@ public:
     void unbind() override;
     void destroy() override;
     void* getHandle() const override;
+
+    // Aponta os atributos 2..5 (colunas da matriz model, divisor 1) para buffer+offset.
+    // O VAO deve estar ligado. Chamadas repetidas com os mesmos valores sao ignoradas.
+    // generation distingue buffers recriados que reutilizam o mesmo nome GL.
+    void bindInstanceBuffer(GLuint buffer, uint32_t generation, GLintptr offset);
 };
 
 #endif // OPENGLMESHBUFFER_HPP
@@ -6,7 +6,11 @@
 #include "../../../material.hpp"
 #include "../../../mesh_renderer.hpp"
 #include "../../../stb_image.h"
+#include "../../../engine_stats.hpp"
+#include "../../../memory_tracker.hpp"
+#include "../../../trace.hpp"
 #include "mesh_buffer_factory.hpp"
+#include "open_gl_mesh_buffer.hpp"
 #include "open_gl_renderer_backend.hpp"
 #include "shader_compiler_factory.hpp"
 #include "shader_program_factory.hpp"
@@ -15,28 +19,49 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+// Abaixo disso o draw instanciado nao compensa o upload extra
+constexpr size_t MIN_INSTANCED_BATCH = 2;
+constexpr GLsizeiptr INITIAL_RING_SIZE = 1024 * 1024;
+
+// Tamanhos dos blocos std140 dos shaders (Matrices, MaterialData, LightData)
+constexpr GLsizeiptr MATRICES_BLOCK_SIZE = 3 * sizeof(glm::mat4);
+constexpr GLsizeiptr MATERIAL_BLOCK_SIZE = sizeof(glm::vec4);
+constexpr GLsizeiptr LIGHT_BLOCK_SIZE = sizeof(glm::vec4);
+
+constexpr GLuint MATRICES_BINDING = 0;
+constexpr GLuint MATERIAL_BINDING = 1;
+constexpr GLuint LIGHT_BINDING = 2;
+
+GLsizeiptr alignUp(GLsizeiptr value, GLsizeiptr alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+} // namespace
 
 GraphicsAPI OpenGLRendererBackend::getGraphicsAPI() const { return GraphicsAPI::OPENGL; }
 
 std::string OpenGLRendererBackend::getShaderExtension() const { return ".glsl"; }
 
 OpenGLRendererBackend::~OpenGLRendererBackend() {
-    if (matricesUBO)
-        glDeleteBuffers(1, &matricesUBO);
-    if (materialDataUBO)
-        glDeleteBuffers(1, &materialDataUBO);
-    if (lightDataUBO)
-        glDeleteBuffers(1, &lightDataUBO);
+    if (offscreenFramebuffer) {
+        glDeleteFramebuffers(1, &offscreenFramebuffer);
+        glDeleteRenderbuffers(1, &offscreenColor);
+        glDeleteRenderbuffers(1, &offscreenDepth);
+    }
 }
 
 unsigned int OpenGLRendererBackend::getRequiredWindowFlags() const { return SDL_WINDOW_OPENGL; };
 
 std::unique_ptr<ShaderProgram> OpenGLRendererBackend::createShaderProgram() {
-    return ShaderProgramFactory::create(getGraphicsAPI());
+    return ShaderProgramFactory::create(getGraphicsAPI(), this);
 }
 
 std::unique_ptr<MeshBuffer> OpenGLRendererBackend::createMeshBuffer() {
-    return MeshBufferFactory::create(getGraphicsAPI());
+    return MeshBufferFactory::create(getGraphicsAPI(), this);
 }
 
 std::unique_ptr<ShaderCompiler> OpenGLRendererBackend::createShaderCompiler() {
@@ -54,44 +79,147 @@ bool OpenGLRendererBackend::init(SDL_Window* window) {
         LOG_ERROR("Failed to create OpenGL context!");
         return false;
     }
+    this->window = window;
+    windowContext = glContext;
 
     return init();
 };
 
+bool OpenGLRendererBackend::makeCurrent() {
+    if (headless) {
+        return headlessContext.makeCurrent();
+    }
+    if (windowContext && SDL_GL_MakeCurrent(window, windowContext) != 0) {
+        LOG_ERROR(std::string("SDL_GL_MakeCurrent failed: ") + SDL_GetError());
+        return false;
+    }
+    return true;
+}
+
+void OpenGLRendererBackend::releaseCurrent() {
+    // Termina os comandos pendentes antes de outra thread assumir o contexto
+    glFlush();
+    if (headless) {
+        headlessContext.releaseCurrent();
+    } else if (windowContext) {
+        SDL_GL_MakeCurrent(window, nullptr);
+    }
+}
+
+bool OpenGLRendererBackend::initHeadless(int width, int height) {
+    if (!headlessContext.create(width, height)) {
+        LOG_ERROR("Failed to create headless OpenGL context!");
+        return false;
+    }
+    headless = true;
+
+    return init() && createOffscreenTarget(width, height);
+}
+
+bool OpenGLRendererBackend::createOffscreenTarget(int width, int height) {
+    glGenRenderbuffers(1, &offscreenColor);
+    glBindRenderbuffer(GL_RENDERBUFFER, offscreenColor);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+
+    glGenRenderbuffers(1, &offscreenDepth);
+    glBindRenderbuffer(GL_RENDERBUFFER, offscreenDepth);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &offscreenFramebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, offscreenFramebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER,
+                              offscreenColor);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER,
+                              offscreenDepth);
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        LOG_ERROR("Offscreen framebuffer is incomplete");
+        return false;
+    }
+
+    // Fica ligado para sempre: nada mais no backend troca de framebuffer
+    glViewport(0, 0, width, height);
+    offscreenWidth = width;
+    offscreenHeight = height;
+    return true;
+}
+
+bool OpenGLRendererBackend::readPixels(std::vector<uint8_t>& rgba, int& width, int& height) {
+    // Com janela o back buffer e indefinido depois do swap
+    if (!headless) {
+        return false;
+    }
+
+    width = offscreenWidth;
+    height = offscreenHeight;
+    size_t rowBytes = static_cast<size_t>(width) * 4;
+    rgba.resize(rowBytes * height);
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, rgba.data());
+
+    // OpenGL le de baixo para cima
+    std::vector<uint8_t> row(rowBytes);
+    for (int y = 0; y < height / 2; y++) {
+        uint8_t* top = rgba.data() + y * rowBytes;
+        uint8_t* bottom = rgba.data() + (height - 1 - y) * rowBytes;
+        std::memcpy(row.data(), top, rowBytes);
+        std::memcpy(top, bottom, rowBytes);
+        std::memcpy(bottom, row.data(), rowBytes);
+    }
+    return true;
+}
+
 bool OpenGLRendererBackend::init() {
     GLenum err = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+    // GLEW compilado com GLX reclama da falta de display X no contexto EGL, mas as
+    // funcoes do core ja foram carregadas nesse ponto
+    if (headless && err == GLEW_ERROR_NO_GLX_DISPLAY) {
+        err = GLEW_OK;
+    }
+#endif
     if (GLEW_OK != err) {
         std::string glewErr = reinterpret_cast<const char*>(glewGetErrorString(err));
         LOG_ERROR("GLEW initialization failed: " + glewErr);
         return false;
     }
 
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    // Deixa o driver usar quantas threads de compilacao quiser
+    if (GLEW_KHR_parallel_shader_compile) {
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+        LOG_INFO("Using KHR_parallel_shader_compile");
+    } else if (GLEW_ARB_parallel_shader_compile) {
+        glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+        LOG_INFO("Using ARB_parallel_shader_compile");
+    }
 
-    glGenBuffers(1, &matricesUBO);
-    glBindBuffer(GL_UNIFORM_BUFFER, matricesUBO);
-    glBufferData(GL_UNIFORM_BUFFER, 4 * sizeof(glm::mat4), nullptr, GL_DYNAMIC_DRAW);
-    glBindBufferBase(GL_UNIFORM_BUFFER, 0, matricesUBO);
+    stateCache.reset();
+    // YUME_GL_STATE_STATS=1 loga por frame quantas trocas de estado foram puladas
+    const char* stateStats = std::getenv("YUME_GL_STATE_STATS");
+    stateCache.setDebugCounters(stateStats && std::string(stateStats) == "1");
 
-    glGenBuffers(1, &materialDataUBO);
-    glBindBuffer(GL_UNIFORM_BUFFER, materialDataUBO);
-    glBufferData(GL_UNIFORM_BUFFER, sizeof(glm::vec4), nullptr, GL_DYNAMIC_DRAW);
-    glBindBufferBase(GL_UNIFORM_BUFFER, 1, materialDataUBO);
+    stateCache.setDepthTest(true);
+    stateCache.setBlend(true);
+    stateCache.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-    glGenBuffers(1, &lightDataUBO);
-    glBindBuffer(GL_UNIFORM_BUFFER, lightDataUBO);
-    glBufferData(GL_UNIFORM_BUFFER, 256, nullptr, GL_DYNAMIC_DRAW);
-    glBindBufferBase(GL_UNIFORM_BUFFER, 2, lightDataUBO);
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniformAlignment);
+    // Matrizes por instancia precisam de offset multiplo de 64 para o baseInstance
+    uniformAlignment = std::max<GLint>(uniformAlignment, sizeof(glm::mat4));
+    if (!frameRing.init(&stateCache, INITIAL_RING_SIZE)) {
+        LOG_ERROR("Failed to create per-frame ring buffer");
+        return false;
+    }
 
-    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    hasBaseInstance = GLEW_ARB_base_instance;
 
-    uniformBindings["ModelViewProjection"] = matricesUBO;
-    uniformBindings["MaterialData"] = materialDataUBO;
-    uniformBindings["LightData"] = lightDataUBO;
+    uniformBindings["ModelViewProjection"] = MATRICES_BINDING;
+    uniformBindings["MaterialData"] = MATERIAL_BINDING;
+    uniformBindings["LightData"] = LIGHT_BINDING;
 
     initSpriteQuad();
+    gpuProfiler.init();
 
     return true;
 }
@@ -101,8 +229,11 @@ void OpenGLRendererBackend::onCameraSet() {}
 void OpenGLRendererBackend::clear(Camera* camera) {
     ColorRGBA bgColor = camera ? camera->getBackgroundColor() : COLOR::BLACK;
 
+    gpuProfiler.beginFrame();
+    gpuProfiler.beginPass(GpuPass::CLEAR);
     glClearColor(bgColor.r, bgColor.g, bgColor.b, bgColor.a);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    gpuProfiler.endPass(GpuPass::CLEAR);
 }
 
 bool OpenGLRendererBackend::initWindowContext() {
@@ -115,9 +246,55 @@ bool OpenGLRendererBackend::initWindowContext() {
 
 void OpenGLRendererBackend::draw(const Mesh& mesh) {
     auto vao = static_cast<GLuint>(reinterpret_cast<uintptr_t>(mesh.getMeshBufferHandle()));
-    glBindVertexArray(vao);
-    glDrawArrays(GL_TRIANGLES, 0, mesh.getVertices().size() / 3);
-    glBindVertexArray(0);
+    stateCache.bindVertexArray(vao);
+    GLsizei vertexCount = mesh.getVertices().size() / 3;
+    glDrawArrays(GL_TRIANGLES, 0, vertexCount);
+
+    FrameStats& stats = EngineStats::current();
+    stats.drawCalls++;
+    stats.triangles += vertexCount / 3;
+}
+
+bool OpenGLRendererBackend::drawInstanced(const Mesh& mesh, const glm::mat4* models,
+                                          uint32_t count) {
+    if (!mesh.getMeshBuffer() || count == 0) {
+        return false;
+    }
+
+    // Fora de renderGameObjects nao ha regiao de frame aberta
+    GLintptr offset = frameRing.write(models, count * sizeof(glm::mat4), uniformAlignment);
+    if (offset < 0) {
+        return false;
+    }
+    frameRing.flush();
+
+    drawInstancedRange(mesh, offset, count);
+    return true;
+}
+
+void OpenGLRendererBackend::drawInstancedRange(const Mesh& mesh, GLintptr offset,
+                                               uint32_t count) {
+    auto meshBuffer = static_cast<OpenGLMeshBuffer*>(mesh.getMeshBuffer());
+    stateCache.bindVertexArray(
+        static_cast<GLuint>(reinterpret_cast<uintptr_t>(meshBuffer->getHandle())));
+    GLsizei vertexCount = mesh.getVertices().size() / 3;
+    GLuint buffer = frameRing.getBuffer();
+    uint32_t generation = frameRing.getGeneration();
+
+    if (hasBaseInstance) {
+        // Atributos fixos no offset 0; a primeira instancia vem do baseInstance
+        meshBuffer->bindInstanceBuffer(buffer, generation, 0);
+        glDrawArraysInstancedBaseInstance(GL_TRIANGLES, 0, vertexCount, count,
+                                          offset / sizeof(glm::mat4));
+    } else {
+        // GL 3.3 puro: reaponta os atributos para o inicio do lote
+        meshBuffer->bindInstanceBuffer(buffer, generation, offset);
+        glDrawArraysInstanced(GL_TRIANGLES, 0, vertexCount, count);
+    }
+
+    FrameStats& stats = EngineStats::current();
+    stats.drawCalls++;
+    stats.triangles += static_cast<uint64_t>(vertexCount / 3) * count;
 }
 
 void OpenGLRendererBackend::setUniforms(ShaderProgram* shaderProgram) {
@@ -132,42 +309,22 @@ void OpenGLRendererBackend::bindCamera(Camera* camera) {
         LOG_ERROR("Camera is null");
         return;
     }
+    mainCamera = camera;
 
-    glm::mat4 model = glm::mat4(1.0f);
-
-    auto& camPos = camera->getPosition();
-    glm::mat4 view = glm::lookAt({camPos.x, camPos.y, camPos.z}, glm::vec3(0.0f, 0.0f, 0.0f),
-                                 glm::vec3(0.0f, 1.0f, 0.0f));
-
-    glm::mat4 projection;
-    if (camera->isOrthographic()) {
-        float orthoSize = camera->getOrthoSize();
-        float aspect = camera->getAspectRatio();
-        LOG_INFO("Ortho projection - size: " + std::to_string(orthoSize) +
-                 " aspect: " + std::to_string(aspect));
-        projection = glm::ortho(-orthoSize * aspect, orthoSize * aspect, -orthoSize, orthoSize,
-                                camera->getNearDistance(), camera->getFarDistance());
-    } else {
-        projection = glm::perspective(glm::radians(camera->getFov()), camera->getAspectRatio(),
-                                      camera->getNearDistance(), camera->getFarDistance());
-    }
-
-    glBindBuffer(GL_UNIFORM_BUFFER, matricesUBO);
-    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(glm::mat4), glm::value_ptr(model));
-    glBufferSubData(GL_UNIFORM_BUFFER, sizeof(glm::mat4), sizeof(glm::mat4), glm::value_ptr(view));
-    glBufferSubData(GL_UNIFORM_BUFFER, 2 * sizeof(glm::mat4), sizeof(glm::mat4),
-                    glm::value_ptr(projection));
-    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    // Copiadas para o bloco de matrizes de cada objeto em renderGameObjects
+    frameView = camera->getViewMatrix();
+    frameProjection = camera->getProjectionMatrix();
 }
 
 void OpenGLRendererBackend::setBufferDataImpl(const std::string& name, const void* data,
                                               size_t size) {
-    auto it = uniformBindings.find(name);
-    if (it != uniformBindings.end()) {
-        glBindBuffer(GL_UNIFORM_BUFFER, it->second);
-        glBufferSubData(GL_UNIFORM_BUFFER, 0, size, data);
-        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    if (uniformBindings.find(name) == uniformBindings.end()) {
+        LOG_WARN("Unknown uniform block: " + name);
+        return;
     }
+
+    auto bytes = static_cast<const uint8_t*>(data);
+    sharedBlocks[name].assign(bytes, bytes + size);
 }
 
 void OpenGLRendererBackend::applyMaterial(Material* material) {
@@ -179,50 +336,167 @@ void OpenGLRendererBackend::applyMaterial(Material* material) {
     setUniforms(program);
 }
 
+GLsizeiptr OpenGLRendererBackend::estimateFrameBytes() const {
+    // Limite superior: cada item pode precisar de matrizes, material e matriz de instancia
+    GLsizeiptr perItem = alignUp(MATRICES_BLOCK_SIZE, uniformAlignment) +
+                         alignUp(MATERIAL_BLOCK_SIZE, uniformAlignment) +
+                         alignUp(sizeof(glm::mat4), uniformAlignment);
+    GLsizeiptr bytes = perItem * (renderQueue.size() + 1);
+
+    for (const auto& block : sharedBlocks) {
+        bytes += alignUp(block.second.size(), uniformAlignment);
+    }
+    return bytes + alignUp(LIGHT_BLOCK_SIZE, uniformAlignment);
+}
+
+GLintptr OpenGLRendererBackend::writeMatrices(const glm::mat4& model) {
+    OpenGLRingBuffer::Allocation allocation;
+    if (!frameRing.allocate(MATRICES_BLOCK_SIZE, uniformAlignment, allocation)) {
+        return -1;
+    }
+
+    auto matrices = static_cast<glm::mat4*>(allocation.data);
+    matrices[0] = model;
+    matrices[1] = frameView;
+    matrices[2] = frameProjection;
+    return allocation.offset;
+}
+
+void OpenGLRendererBackend::bindUniformRange(GLuint binding, GLintptr offset, GLsizeiptr size) {
+    stateCache.bindBufferRange(GL_UNIFORM_BUFFER, binding, frameRing.getBuffer(), offset, size);
+}
+
 void OpenGLRendererBackend::renderGameObjects(std::vector<GameObject*>* gameObjects,
                                               std::vector<Light>* lights) {
-    for (const auto go : *gameObjects) {
+    renderQueue.build(*gameObjects, mainCamera);
+    if (renderQueue.empty()) {
+        return;
+    }
+
+    frameRing.beginFrame(estimateFrameBytes());
+
+    // 1) Escreve todos os dados do frame no ring, em ordem de desenho
+    for (const auto& block : sharedBlocks) {
+        GLintptr offset =
+            frameRing.write(block.second.data(), block.second.size(), uniformAlignment);
+        if (offset >= 0) {
+            bindUniformRange(uniformBindings[block.first], offset, block.second.size());
+        }
+    }
+
+    if (lights && !lights->empty() && (*lights)[0].type == LightType::DIRECTIONAL) {
+        glm::vec4 lightData(0.0f);
+        memcpy(&lightData, &(*lights)[0].direction, sizeof(Vector3));
+        GLintptr offset = frameRing.write(&lightData, LIGHT_BLOCK_SIZE, uniformAlignment);
+        if (offset >= 0) {
+            bindUniformRange(LIGHT_BINDING, offset, LIGHT_BLOCK_SIZE);
+        }
+    }
 
-        glm::mat4 model = glm::mat4(1.0f);
-        if (go->getTransform()) {
-            model = go->getTransform()->getModelMatrix();
+    drawCommands.clear();
+    Material* lastMaterial = nullptr;
+    GLintptr materialOffset = -1;
+    // Draws instanciados leem model por atributo; todos compartilham um bloco de matrizes
+    GLintptr instancedMatricesOffset = -1;
+
+    for (size_t i = 0; i < renderQueue.size();) {
+        const RenderItem& item = renderQueue[i];
+
+        // Itens consecutivos com a mesma mesh e material viram um unico draw instanciado
+        size_t runEnd = i + 1;
+        ShaderProgram* instancedProgram =
+            item.mesh ? item.material->getInstancedShaderProgram() : nullptr;
+        if (instancedProgram) {
+            while (runEnd < renderQueue.size() && renderQueue[runEnd].mesh == item.mesh &&
+                   renderQueue[runEnd].material == item.material) {
+                runEnd++;
+            }
+        }
+        bool instanced = runEnd - i >= MIN_INSTANCED_BATCH;
+        if (!instanced) {
+            runEnd = i + 1;
         }
 
-        glBindBuffer(GL_UNIFORM_BUFFER, matricesUBO);
-        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(glm::mat4), glm::value_ptr(model));
-        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        if (item.material != lastMaterial) {
+            materialOffset = frameRing.write(&item.material->getBaseColor(),
+                                             MATERIAL_BLOCK_SIZE, uniformAlignment);
+            lastMaterial = item.material;
+        }
 
-        if (go->hasSprite() && go->hasSpriteRenderer()) {
-            auto sprite = go->getSprite();
-            auto spriteRenderer = go->getSpriteRenderer();
-            auto mat = spriteRenderer->getMaterial();
+        DrawCommand command;
+        command.begin = i;
+        command.end = runEnd;
+        command.program = instanced ? instancedProgram : item.material->getShaderProgram();
+        command.materialOffset = materialOffset;
+        command.instanceOffset = -1;
 
-            if (mat) {
-                mat->use();
-                applyMaterial(mat);
-                drawSprite(*sprite);
+        if (instanced) {
+            if (instancedMatricesOffset < 0) {
+                instancedMatricesOffset = writeMatrices(glm::mat4(1.0f));
             }
-        } else if (go->hasMesh() && go->hasMeshRenderer()) {
-            auto mesh = go->getMesh();
-            auto meshRenderer = go->getMeshRenderer();
-            auto mat = meshRenderer->getMaterial();
-
-            if (mat) {
-                mat->use();
-                applyMaterial(mat);
-                if (lights && !lights->empty()) {
-                    mat->applyLight((*lights)[0]);
+            command.matricesOffset = instancedMatricesOffset;
+
+            OpenGLRingBuffer::Allocation allocation;
+            if (frameRing.allocate((runEnd - i) * sizeof(glm::mat4), uniformAlignment,
+                                   allocation)) {
+                auto models = static_cast<glm::mat4*>(allocation.data);
+                for (size_t j = i; j < runEnd; j++) {
+                    *models++ = renderQueue[j].model;
                 }
-                draw(*mesh);
+                command.instanceOffset = allocation.offset;
             }
+        } else {
+            command.matricesOffset = writeMatrices(item.model);
+        }
+
+        // estimateFrameBytes garante espaco; um offset invalido aqui e erro de contagem
+        if (command.matricesOffset < 0 || command.materialOffset < 0 ||
+            (instanced && command.instanceOffset < 0)) {
+            LOG_ERROR("Frame ring buffer overflow, skipping remaining draws");
+            break;
+        }
+
+        drawCommands.push_back(command);
+        i = runEnd;
+    }
+
+    // 2) Um unico envio no caminho sem buffer persistente
+    frameRing.flush();
+
+    // 3) Desenha trocando apenas os offsets dos blocos; binds repetidos morrem no cache.
+    // Translucidos (sprites inclusive) vem depois dos opacos na fila e formam o pass SPRITES.
+    GpuPass pass = GpuPass::OPAQUE;
+    gpuProfiler.beginPass(pass);
+    for (const auto& command : drawCommands) {
+        const RenderItem& item = renderQueue[command.begin];
+        if (pass == GpuPass::OPAQUE && (item.sprite || item.material->isTranslucent())) {
+            gpuProfiler.endPass(pass);
+            pass = GpuPass::SPRITES;
+            gpuProfiler.beginPass(pass);
+        }
+
+        command.program->use();
+        bindUniformRange(MATRICES_BINDING, command.matricesOffset, MATRICES_BLOCK_SIZE);
+        bindUniformRange(MATERIAL_BINDING, command.materialOffset, MATERIAL_BLOCK_SIZE);
+
+        if (command.instanceOffset >= 0) {
+            drawInstancedRange(*item.mesh, command.instanceOffset,
+                               static_cast<uint32_t>(command.end - command.begin));
+        } else if (item.sprite) {
+            drawSprite(*item.sprite);
+        } else {
+            draw(*item.mesh);
         }
     }
+    gpuProfiler.endPass(pass);
 }
 
 unsigned int OpenGLRendererBackend::createCubemapTexture(const std::vector<std::string>& faces) {
+    TRACE_ZONE("OpenGLRendererBackend::createCubemapTexture");
+    MEMORY_SCOPE(MemoryTag::ASSETS);
     unsigned int textureID;
     glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
+    stateCache.bindTexture(0, GL_TEXTURE_CUBE_MAP, textureID);
 
     int width, height, nrChannels;
     for (unsigned int i = 0; i < faces.size(); i++) {
@@ -232,6 +506,8 @@ unsigned int OpenGLRendererBackend::createCubemapTexture(const std::vector<std::
             GLenum format = (nrChannels == 4) ? GL_RGBA : GL_RGB;
             glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, format, width, height, 0, format,
                          GL_UNSIGNED_BYTE, data);
+            EngineStats::current().bytesUploaded +=
+                static_cast<uint64_t>(width) * height * nrChannels;
             stbi_image_free(data);
         } else {
             LOG_WARN("Cubemap texture failed to load at path: " + faces[i].c_str());
@@ -246,11 +522,14 @@ unsigned int OpenGLRendererBackend::createCubemapTexture(const std::vector<std::
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
 
+    EngineStats::countAsset(AssetType::TEXTURE, 1);
     return textureID;
 }
 
 void OpenGLRendererBackend::deleteCubemapTexture(unsigned int textureID) {
+    stateCache.forgetTexture(textureID);
     glDeleteTextures(1, &textureID);
+    EngineStats::countAsset(AssetType::TEXTURE, -1);
 }
 
 void OpenGLRendererBackend::renderSkybox(const Mesh& mesh, unsigned int shaderProgram,
@@ -258,7 +537,8 @@ void OpenGLRendererBackend::renderSkybox(const Mesh& mesh, unsigned int shaderPr
     if (!mainCamera)
         return;
 
-    glDepthFunc(GL_LEQUAL);
+    gpuProfiler.beginPass(GpuPass::SKYBOX);
+    stateCache.setDepthFunc(GL_LEQUAL);
 
     auto& camPos = mainCamera->getPosition();
     glm::mat4 camView = glm::lookAt({camPos.x, camPos.y, camPos.z}, glm::vec3(0.0f, 0.0f, 0.0f),
@@ -275,18 +555,29 @@ void OpenGLRendererBackend::renderSkybox(const Mesh& mesh, unsigned int shaderPr
                        glm::value_ptr(projection));
     glUniform1i(glGetUniformLocation(shaderProgram, "skybox"), 0);
 
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
+    stateCache.bindTexture(0, GL_TEXTURE_CUBE_MAP, textureID);
 
     auto vao = static_cast<GLuint>(reinterpret_cast<uintptr_t>(mesh.getMeshBufferHandle()));
-    glBindVertexArray(vao);
+    stateCache.bindVertexArray(vao);
     glDrawArrays(GL_TRIANGLES, 0, 36);
-    glBindVertexArray(0);
+    EngineStats::current().drawCalls++;
+    EngineStats::current().triangles += 12;
 
-    glDepthFunc(GL_LESS);
+    stateCache.setDepthFunc(GL_LESS);
+    gpuProfiler.endPass(GpuPass::SKYBOX);
 }
 
-void OpenGLRendererBackend::present(SDL_Window* window) { SDL_GL_SwapWindow(window); }
+void OpenGLRendererBackend::present(SDL_Window* window) {
+    // Fecha a regiao do frame: so volta a ser escrita depois que a GPU passar deste fence
+    frameRing.endFrame();
+    stateCache.endFrame();
+    gpuProfiler.endFrame();
+    if (headless || !window) {
+        glFlush();
+        return;
+    }
+    SDL_GL_SwapWindow(window);
+}
 
 void OpenGLRendererBackend::initSpriteQuad() {
     float vertices[] = {-0.5f, -0.5f, 0.0f, 0.0f, 0.0f, 0.5f,  -0.5f, 0.0f, 1.0f, 0.0f,
@@ -296,19 +587,19 @@ void OpenGLRendererBackend::initSpriteQuad() {
     glGenVertexArrays(1, &spriteVAO);
     glGenBuffers(1, &spriteVBO);
 
-    glBindVertexArray(spriteVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, spriteVBO);
+    stateCache.bindVertexArray(spriteVAO);
+    stateCache.bindBuffer(GL_ARRAY_BUFFER, spriteVBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
 
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
     glEnableVertexAttribArray(1);
-
-    glBindVertexArray(0);
 }
 
 unsigned int OpenGLRendererBackend::loadTexture(const std::string& path, uint8_t filterType) {
+    TRACE_ZONE("OpenGLRendererBackend::loadTexture");
+    MEMORY_SCOPE(MemoryTag::ASSETS);
     unsigned int textureID;
     glGenTextures(1, &textureID);
 
@@ -320,8 +611,10 @@ unsigned int OpenGLRendererBackend::loadTexture(const std::string& path, uint8_t
                  std::to_string(height) + ", " + std::to_string(nrChannels) + " channels)");
 
         GLenum format = (nrChannels == 4) ? GL_RGBA : GL_RGB;
-        glBindTexture(GL_TEXTURE_2D, textureID);
+        stateCache.bindTexture(0, GL_TEXTURE_2D, textureID);
         glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
+        EngineStats::current().bytesUploaded += static_cast<uint64_t>(width) * height * nrChannels;
+        EngineStats::countAsset(AssetType::TEXTURE, 1);
 
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
@@ -339,39 +632,20 @@ unsigned int OpenGLRendererBackend::loadTexture(const std::string& path, uint8_t
 }
 
 void OpenGLRendererBackend::drawSprite(const Sprite& sprite) {
-    LOG_INFO("Drawing sprite - TextureID: " + std::to_string(sprite.getTexture()) + " Width: " +
-             std::to_string(sprite.getWidth()) + " Height: " + std::to_string(sprite.getHeight()));
-
-    // Não sobrescrever a matriz model, apenas aplicar a escala do sprite
-    // A matriz model já foi configurada em renderGameObjects com o Transform
-    glm::mat4 spriteScale =
-        glm::scale(glm::mat4(1.0f), glm::vec3(sprite.getWidth(), sprite.getHeight(), 1.0f));
-
-    glm::mat4 currentModel;
-    glBindBuffer(GL_UNIFORM_BUFFER, matricesUBO);
-    glGetBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(glm::mat4), glm::value_ptr(currentModel));
-
-    // Multiplicar: transform * escala do sprite
-    glm::mat4 finalModel = currentModel * spriteScale;
-
-    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(glm::mat4), glm::value_ptr(finalModel));
-    glBindBuffer(GL_UNIFORM_BUFFER, 0);
-
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, sprite.getTexture());
+    // A escala do sprite ja foi aplicada na matriz model ao montar a fila de render
+    stateCache.bindTexture(0, GL_TEXTURE_2D, sprite.getTexture());
 
-    GLint currentProgram;
-    glGetIntegerv(GL_CURRENT_PROGRAM, &currentProgram);
-    GLint texLoc =
-        glGetUniformLocation(currentProgram, "SPIRV_Cross_CombinedspriteTexturespriteSampler");
-    LOG_INFO("Texture uniform location: " + std::to_string(texLoc));
+    // O cache ja sabe o program atual; evita o glGetIntegerv (round-trip ao driver)
+    GLint texLoc = glGetUniformLocation(stateCache.getProgram(),
+                                        "SPIRV_Cross_CombinedspriteTexturespriteSampler");
     if (texLoc != -1) {
         glUniform1i(texLoc, 0);
     }
 
-    glBindVertexArray(spriteVAO);
+    stateCache.bindVertexArray(spriteVAO);
     glDrawArrays(GL_TRIANGLES, 0, 6);
-    glBindVertexArray(0);
+    EngineStats::current().drawCalls++;
+    EngineStats::current().triangles += 2;
 
     GLenum err = glGetError();
     if (err != GL_NO_ERROR) {
@@ -3,8 +3,16 @@
 
 #include "../../../graphics_api.hpp"
 #include "../../../mesh.hpp"
+#include "../../render_queue.hpp"
 #include "../../renderer_backend.hpp"
+#include "open_gl_gpu_profiler.hpp"
+#include "open_gl_headless_context.hpp"
+#include "open_gl_ring_buffer.hpp"
+#include "open_gl_state_cache.hpp"
 #include <GL/glew.h>
+#include <SDL2/SDL.h>
+#include <glm/glm.hpp>
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -12,14 +20,54 @@
 
 class OpenGLRendererBackend : public RendererBackend {
   private:
+    // Primeiro membro: o contexto headless e destruido por ultimo
+    OpenGLHeadlessContext headlessContext;
+    bool headless = false;
+    // Contexto da janela, para trocar de thread (makeCurrent/releaseCurrent)
+    SDL_Window* window = nullptr;
+    SDL_GLContext windowContext = nullptr;
+    // Alvo offscreen do modo headless
+    GLuint offscreenFramebuffer = 0;
+    GLuint offscreenColor = 0;
+    GLuint offscreenDepth = 0;
+    int offscreenWidth = 0;
+    int offscreenHeight = 0;
+
     GLuint spriteVAO = 0;
     GLuint spriteVBO = 0;
-    GLuint matricesUBO = 0;
-    GLuint materialDataUBO = 0;
-    GLuint lightDataUBO = 0;
+    // Declarado antes de tudo que faz binds no destrutor
+    OpenGLStateCache stateCache;
+    // Dados por objeto/material/frame sao escritos linearmente no ring e ligados
+    // com glBindBufferRange; nenhum UBO compartilhado e reescrito entre draws
+    OpenGLRingBuffer frameRing;
+    OpenGLGpuProfiler gpuProfiler;
+    GLint uniformAlignment = 256;
     std::unordered_map<std::string, GLuint> uniformBindings;
+    // Conteudo de setBufferData, enviado para o ring no proximo frame
+    std::unordered_map<std::string, std::vector<uint8_t>> sharedBlocks;
+    glm::mat4 frameView = glm::mat4(1.0f);
+    glm::mat4 frameProjection = glm::mat4(1.0f);
+
+    RenderQueue renderQueue;
+    bool hasBaseInstance = false;
+
+    struct DrawCommand {
+        size_t begin;
+        size_t end;
+        ShaderProgram* program;
+        GLintptr matricesOffset;
+        GLintptr materialOffset;
+        // -1 para draws nao instanciados
+        GLintptr instanceOffset;
+    };
+    std::vector<DrawCommand> drawCommands;
 
     void initSpriteQuad();
+    bool createOffscreenTarget(int width, int height);
+    GLsizeiptr estimateFrameBytes() const;
+    GLintptr writeMatrices(const glm::mat4& model);
+    void bindUniformRange(GLuint binding, GLintptr offset, GLsizeiptr size);
+    void drawInstancedRange(const Mesh& mesh, GLintptr offset, uint32_t count);
 
   public:
     ~OpenGLRendererBackend();
@@ -29,11 +77,14 @@ class OpenGLRendererBackend : public RendererBackend {
     bool init() override;
     void present(SDL_Window* window) override;
     bool initWindowContext() override;
+    bool makeCurrent() override;
+    void releaseCurrent() override;
     void bindCamera(Camera* camera) override;
     void applyMaterial(Material* material) override;    
     void setBufferDataImpl(const std::string& name, const void* data, size_t size) override;
     void clear(Camera* camera) override;
     void draw(const Mesh&) override;
+    bool drawInstanced(const Mesh& mesh, const glm::mat4* models, uint32_t count) override;
     void setUniforms(ShaderProgram* shaderProgram) override;
     unsigned int createCubemapTexture(const std::vector<std::string>& faces) override;
     std::unique_ptr<ShaderProgram> createShaderProgram() override;
@@ -53,6 +104,10 @@ class OpenGLRendererBackend : public RendererBackend {
 
     unsigned int getRequiredWindowFlags() const override;
     bool init(SDL_Window* window) override;
+    bool initHeadless(int width, int height) override;
+    bool readPixels(std::vector<uint8_t>& rgba, int& width, int& height) override;
+
+    OpenGLStateCache& getStateCache() { return stateCache; }
 };
 
 #endif // OPENGLRENDERERBACKEND_HPP
@@ -0,0 +1,158 @@
+#define CLASS_NAME "OpenGLRingBuffer"
+#include "../../../log_macros.hpp"
+
+#include "../../../engine_stats.hpp"
+#include "open_gl_ring_buffer.hpp"
+#include "open_gl_state_cache.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+constexpr GLuint64 FENCE_TIMEOUT_NS = 1000000000; // 1s
+
+GLintptr alignUp(GLintptr value, GLsizeiptr alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+} // namespace
+
+OpenGLRingBuffer::~OpenGLRingBuffer() { destroy(); }
+
+bool OpenGLRingBuffer::init(OpenGLStateCache* stateCache, GLsizeiptr bytesPerFrame) {
+    state = stateCache;
+    persistent = GLEW_ARB_buffer_storage;
+    if (!create(bytesPerFrame)) {
+        return false;
+    }
+
+    LOG_INFO(std::string(persistent ? "Persistent mapped" : "glBufferSubData fallback") +
+             " ring buffer, " + std::to_string(regionSize) + " bytes per frame");
+    return true;
+}
+
+bool OpenGLRingBuffer::create(GLsizeiptr size) {
+    regionSize = size;
+    GLsizeiptr totalSize = regionSize * FRAME_COUNT;
+
+    glGenBuffers(1, &buffer);
+    generation++;
+    // GL_COPY_WRITE_BUFFER para nao mexer nos bindings de uniform/array em uso
+    state->bindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+
+    if (persistent) {
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_COPY_WRITE_BUFFER, totalSize, nullptr, flags);
+        mapped =
+            static_cast<uint8_t*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, totalSize, flags));
+        if (!mapped) {
+            LOG_ERROR("Failed to persistently map ring buffer");
+            state->forgetBuffer(buffer);
+            glDeleteBuffers(1, &buffer);
+            buffer = 0;
+            regionSize = 0;
+            return false;
+        }
+    } else {
+        glBufferData(GL_COPY_WRITE_BUFFER, totalSize, nullptr, GL_STREAM_DRAW);
+        staging.resize(regionSize);
+    }
+
+    return true;
+}
+
+void OpenGLRingBuffer::destroy() {
+    for (int i = 0; i < FRAME_COUNT; i++) {
+        waitFence(i);
+    }
+
+    if (buffer) {
+        if (mapped) {
+            state->bindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+            glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+            mapped = nullptr;
+        }
+        state->forgetBuffer(buffer);
+        glDeleteBuffers(1, &buffer);
+        buffer = 0;
+    }
+}
+
+void OpenGLRingBuffer::waitFence(int index) {
+    if (!fences[index]) {
+        return;
+    }
+
+    GLenum result = glClientWaitSync(fences[index], GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT_NS);
+    while (result == GL_TIMEOUT_EXPIRED) {
+        LOG_WARN("GPU is more than a second behind, still waiting on ring buffer fence");
+        result = glClientWaitSync(fences[index], GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT_NS);
+    }
+    glDeleteSync(fences[index]);
+    fences[index] = nullptr;
+}
+
+void OpenGLRingBuffer::beginFrame(GLsizeiptr bytesNeeded) {
+    if (bytesNeeded > regionSize) {
+        GLsizeiptr newSize = std::max(regionSize * 2, bytesNeeded);
+        LOG_INFO("Growing ring buffer to " + std::to_string(newSize) + " bytes per frame");
+        GLsizeiptr oldSize = regionSize;
+        destroy();
+        if (!create(newSize)) {
+            // Sem mapeamento persistente, segue pelo caminho com glBufferSubData
+            LOG_WARN("Falling back to glBufferSubData ring buffer");
+            persistent = false;
+            if (!create(newSize) && !create(oldSize)) {
+                LOG_ERROR("Failed to recreate ring buffer");
+            }
+        }
+        frameIndex = 0;
+    }
+
+    waitFence(frameIndex);
+    writeOffset = 0;
+    flushedOffset = 0;
+    inFrame = true;
+}
+
+void OpenGLRingBuffer::endFrame() {
+    if (!inFrame) {
+        return;
+    }
+
+    fences[frameIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    frameIndex = (frameIndex + 1) % FRAME_COUNT;
+    inFrame = false;
+}
+
+bool OpenGLRingBuffer::allocate(GLsizeiptr size, GLsizeiptr alignment, Allocation& out) {
+    GLintptr offset = alignUp(writeOffset, alignment);
+    if (!inFrame || !buffer || (persistent && !mapped) || offset + size > regionSize) {
+        return false;
+    }
+
+    writeOffset = offset + size;
+    EngineStats::current().bytesUploaded += size;
+    out.offset = frameIndex * regionSize + offset;
+    out.data = persistent ? mapped + out.offset : staging.data() + offset;
+    return true;
+}
+
+GLintptr OpenGLRingBuffer::write(const void* data, GLsizeiptr size, GLsizeiptr alignment) {
+    Allocation allocation;
+    if (!allocate(size, alignment, allocation)) {
+        return -1;
+    }
+    memcpy(allocation.data, data, size);
+    return allocation.offset;
+}
+
+void OpenGLRingBuffer::flush() {
+    if (persistent || writeOffset == flushedOffset) {
+        return;
+    }
+
+    // A regiao esta protegida por fence, entao o driver nao precisa sincronizar aqui
+    state->bindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, frameIndex * regionSize + flushedOffset,
+                    writeOffset - flushedOffset, staging.data() + flushedOffset);
+    flushedOffset = writeOffset;
+}
@@ -0,0 +1,73 @@
+#ifndef OPEN_GL_RING_BUFFER_HPP
+#define OPEN_GL_RING_BUFFER_HPP
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class OpenGLStateCache;
+
+// Buffer dividido em FRAME_COUNT regioes, uma por frame em voo. Cada frame escreve
+// linearmente na sua regiao e a protege com um fence; a regiao so e reutilizada
+// quando a GPU terminou de le-la, entao nenhuma escrita causa sincronizacao implicita.
+//
+// Com ARB_buffer_storage o buffer fica mapeado (persistente + coerente) e allocate()
+// devolve um ponteiro direto para a memoria do buffer. Sem a extensao, as escritas vao
+// para uma copia em CPU que flush() envia com um unico glBufferSubData por frame.
+class OpenGLRingBuffer {
+  public:
+    static constexpr int FRAME_COUNT = 3;
+
+    struct Allocation {
+        void* data = nullptr;
+        GLintptr offset = 0;
+    };
+
+  private:
+    OpenGLStateCache* state = nullptr;
+    GLuint buffer = 0;
+    // Incrementado quando o buffer e recriado (o nome GL pode ser reciclado)
+    uint32_t generation = 0;
+    GLsizeiptr regionSize = 0;
+    uint8_t* mapped = nullptr;
+    bool persistent = false;
+    std::vector<uint8_t> staging;
+
+    GLsync fences[FRAME_COUNT] = {};
+    int frameIndex = 0;
+    bool inFrame = false;
+    GLintptr writeOffset = 0;
+    GLintptr flushedOffset = 0;
+
+    bool create(GLsizeiptr size);
+    void destroy();
+    void waitFence(int index);
+
+  public:
+    ~OpenGLRingBuffer();
+
+    bool init(OpenGLStateCache* stateCache, GLsizeiptr bytesPerFrame);
+
+    // Espera a regiao do frame ficar livre. Se bytesNeeded nao couber, o buffer
+    // e recriado maior (espera todos os frames em voo).
+    void beginFrame(GLsizeiptr bytesNeeded);
+    // Cria o fence da regiao atual e avanca para a proxima
+    void endFrame();
+
+    // Reserva size bytes alinhados; falha se a regiao do frame estiver cheia
+    bool allocate(GLsizeiptr size, GLsizeiptr alignment, Allocation& out);
+    GLintptr write(const void* data, GLsizeiptr size, GLsizeiptr alignment);
+
+    // Necessario antes de desenhar com dados escritos desde o ultimo flush
+    // (no-op no caminho persistente)
+    void flush();
+
+    GLuint getBuffer() const { return buffer; }
+    uint32_t getGeneration() const { return generation; }
+    bool isPersistent() const { return persistent; }
+    GLsizeiptr getRegionSize() const { return regionSize; }
+    GLintptr getBytesUsed() const { return writeOffset; }
+};
+
+#endif // OPEN_GL_RING_BUFFER_HPP
@@ -26,18 +26,31 @@ bool OpenGLShaderCompiler::compile(const std::string& source, ShaderType type, v
     const char* sourcePtr = shaderSource.c_str();
     glShaderSource(shader, 1, &sourcePtr, nullptr);
     glCompileShader(shader);
-    
+
+    // Com compilacao paralela o status so e verificado no link do programa,
+    // para que todos os shaders da cena sejam submetidos antes de qualquer espera
+    if (!hasParallelCompile() && !logCompileErrors(shader)) {
+        glDeleteShader(shader);
+        return false;
+    }
+
+    *outHandle = reinterpret_cast<void*>(shader);
+    return true;
+}
+
+bool OpenGLShaderCompiler::hasParallelCompile() {
+    return GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile;
+}
+
+bool OpenGLShaderCompiler::logCompileErrors(GLuint shader) {
     GLint success;
     glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
     if (!success) {
         GLchar infoLog[512];
         glGetShaderInfoLog(shader, 512, nullptr, infoLog);
         LOG_ERROR("Shader compilation error: " + infoLog);
-        glDeleteShader(shader);
         return false;
-    } 
-    
-    *outHandle = reinterpret_cast<void*>(shader);
+    }
     return true;
 }
 
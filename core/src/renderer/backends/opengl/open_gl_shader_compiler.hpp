@@ -10,6 +10,11 @@ public:
     void destroy(void* handle) override;
     bool isValid(void* handle) override;
 
+    // KHR/ARB_parallel_shader_compile: o driver compila em threads proprias e
+    // GL_COMPLETION_STATUS_KHR pode ser consultado sem bloquear
+    static bool hasParallelCompile();
+    static bool logCompileErrors(GLuint shader);
+
 private:
     GLenum toGLShaderType(ShaderType type);
 };
@@ -1,15 +1,23 @@
 #define CLASS_NAME "OpenGLShaderProgram"
 #include "open_gl_shader_program.hpp"
 #include "log_macros.hpp"
+#include "engine_stats.hpp"
+#include "open_gl_renderer_backend.hpp"
+#include "open_gl_shader_compiler.hpp"
+#include "open_gl_state_cache.hpp"
 #include "shader_asset.hpp"
 #include <cstdint>
 
+OpenGLShaderProgram::OpenGLShaderProgram(OpenGLRendererBackend* backend)
+    : state(&backend->getStateCache()) {}
 
 OpenGLShaderProgram::~OpenGLShaderProgram() {
     for (auto& pair : uniformBuffers) {
+        state->forgetBuffer(pair.second);
         glDeleteBuffers(1, &pair.second);
     }
     if (programID != 0) {
+        state->forgetProgram(programID);
         glDeleteProgram(programID);
     }
 }
@@ -22,18 +30,48 @@ bool OpenGLShaderProgram::attachShader(const ShaderAsset& shader) {
     auto value = reinterpret_cast<std::uintptr_t>(shader.getHandle());
     GLuint shaderID = static_cast<GLuint>(value);
     glAttachShader(programID, shaderID);
+    attachedShaders.push_back(shaderID);
     return true;
 }
 
 bool OpenGLShaderProgram::link() {
     glLinkProgram(programID);
 
+    if (OpenGLShaderCompiler::hasParallelCompile()) {
+        // Status consultado depois via isReady(), sem bloquear a thread
+        linkState = LinkState::PENDING;
+        return true;
+    }
+
+    return finishLink();
+}
+
+bool OpenGLShaderProgram::isReady() {
+    if (linkState == LinkState::PENDING) {
+        GLint completed = GL_FALSE;
+        glGetProgramiv(programID, GL_COMPLETION_STATUS_KHR, &completed);
+        if (completed != GL_TRUE) {
+            return false;
+        }
+        finishLink();
+    }
+
+    return linkState != LinkState::NONE;
+}
+
+bool OpenGLShaderProgram::finishLink() {
     GLint success;
     glGetProgramiv(programID, GL_LINK_STATUS, &success);
     if (success != GL_TRUE) {
+        // Na compilacao paralela os erros de compilacao so aparecem aqui
+        for (GLuint shader : attachedShaders) {
+            OpenGLShaderCompiler::logCompileErrors(shader);
+        }
+
         GLchar infoLog[512];
         glGetProgramInfoLog(programID, 512, nullptr, infoLog);
         LOG_ERROR("Shader program link error: " + infoLog);
+        linkState = LinkState::FAILED;
         return false;
     }
 
@@ -41,10 +79,20 @@ bool OpenGLShaderProgram::link() {
     uniformBindings["MaterialData"] = 1;
     uniformBindings["LightData"] = 2;
 
+    // Bindings dos blocos sao fixos; feito uma vez aqui em vez de a cada upload
+    for (const auto& binding : uniformBindings) {
+        GLuint blockIndex =
+            glGetUniformBlockIndex(programID, ("type_" + binding.first).c_str());
+        if (blockIndex != GL_INVALID_INDEX) {
+            glUniformBlockBinding(programID, blockIndex, binding.second);
+        }
+    }
+
+    linkState = LinkState::LINKED;
     return true;
 }
 
-void OpenGLShaderProgram::use() { glUseProgram(programID); }
+void OpenGLShaderProgram::use() { state->useProgram(programID); }
 
 void OpenGLShaderProgram::setUniformBuffer(const char* name, const void* data, size_t size) {
     auto it = uniformBindings.find(name);
@@ -53,15 +101,8 @@ void OpenGLShaderProgram::setUniformBuffer(const char* name, const void* data, s
         return;
     }
 
-    //Spirv-cross prefixes uniforms with 'type_'
-    GLuint blockIndex = glGetUniformBlockIndex(programID, ("type_" + std::string(name)).c_str());
-    if (blockIndex == GL_INVALID_INDEX) {
-        LOG_WARN("Uniform block index for " + std::string(name) + " not found!");
-        return;
-    }
-
+    // O glUniformBlockBinding ja foi feito em finishLink()
     int binding = it->second;
-    glUniformBlockBinding(programID, blockIndex, binding);
 
     // Se name não existe no mapa, cria uma entrada com valor 0
     // Se já existe, retorna referência ao GLuint existente
@@ -71,10 +112,17 @@ void OpenGLShaderProgram::setUniformBuffer(const char* name, const void* data, s
         //O ID gerado é armazenado no mapa para reutilização
         glGenBuffers(1, &ubo);
     }
-    
-    glBindBuffer(GL_UNIFORM_BUFFER, ubo);
-    glBufferData(GL_UNIFORM_BUFFER, size, data, GL_DYNAMIC_DRAW);
-    glBindBufferBase(GL_UNIFORM_BUFFER, binding, ubo);
-    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    // Storage so e (re)especificado quando cresce; depois disso so atualiza o conteudo
+    size_t& capacity = uniformBufferSizes[name];
+    state->bindBuffer(GL_UNIFORM_BUFFER, ubo);
+    EngineStats::current().bytesUploaded += size;
+    if (size > capacity) {
+        glBufferData(GL_UNIFORM_BUFFER, size, data, GL_DYNAMIC_DRAW);
+        capacity = size;
+    } else {
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, size, data);
+    }
+    state->bindBufferRange(GL_UNIFORM_BUFFER, binding, ubo, 0, capacity);
 }
 
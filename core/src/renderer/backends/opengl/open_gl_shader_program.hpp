@@ -5,21 +5,35 @@
 #include <GL/glew.h>
 #include <unordered_map>
 #include <string>
+#include <vector>
+
+class OpenGLStateCache;
+class OpenGLRendererBackend;
 
 class OpenGLShaderProgram : public ShaderProgram {
 private:
+    enum class LinkState { NONE, PENDING, LINKED, FAILED };
+
+    OpenGLStateCache* state;
     GLuint programID = 0;
+    LinkState linkState = LinkState::NONE;
+    std::vector<GLuint> attachedShaders;
     std::unordered_map<std::string, int> uniformBindings;
     std::unordered_map<std::string, GLuint> uniformBuffers;
+    std::unordered_map<std::string, size_t> uniformBufferSizes;
+
+    bool finishLink();
 
 public:
+    explicit OpenGLShaderProgram(OpenGLRendererBackend* backend);
     ~OpenGLShaderProgram() override;
     bool attachShader(const ShaderAsset& shader) override;
     bool link() override;
     void use() override;
     void setUniformBuffer(const char* name, const void* data, size_t size) override;
     void* getHandle() const override { return reinterpret_cast<void*>(programID); }
-    bool isValid() const override { return programID != 0; }
+    bool isValid() const override { return programID != 0 && linkState == LinkState::LINKED; }
+    bool isReady() override;
 };
 
 #endif // OPENGLSHADERPROGRAM_HPP
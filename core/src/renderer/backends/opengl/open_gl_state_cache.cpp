@@ -0,0 +1,215 @@
+#define CLASS_NAME "OpenGLStateCache"
+#include "../../../log_macros.hpp"
+
+#include "../../../engine_stats.hpp"
+#include "open_gl_state_cache.hpp"
+
+int OpenGLStateCache::bufferSlot(GLenum target) {
+    switch (target) {
+    case GL_ARRAY_BUFFER:
+        return ARRAY_SLOT;
+    case GL_UNIFORM_BUFFER:
+        return UNIFORM_SLOT;
+    case GL_COPY_WRITE_BUFFER:
+        return COPY_WRITE_SLOT;
+    default:
+        return -1;
+    }
+}
+
+bool OpenGLStateCache::changed(bool isDifferent) {
+    if (isDifferent) {
+        frameCounters.issued++;
+    } else {
+        frameCounters.skipped++;
+    }
+    return isDifferent;
+}
+
+void OpenGLStateCache::reset() {
+    GLint value = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &value);
+    program = value;
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &value);
+    vertexArray = value;
+    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &value);
+    buffers[ARRAY_SLOT] = value;
+    glGetIntegerv(GL_UNIFORM_BUFFER_BINDING, &value);
+    buffers[UNIFORM_SLOT] = value;
+    glGetIntegerv(GL_COPY_WRITE_BUFFER_BINDING, &value);
+    buffers[COPY_WRITE_SLOT] = value;
+
+    // Ranges e texturas por unidade nao valem a consulta; forca o proximo bind
+    for (auto& range : uniformRanges) {
+        range = UniformRange();
+        range.buffer = static_cast<GLuint>(-1);
+    }
+    for (auto& unit : textureUnits) {
+        unit.texture2D = unit.cubeMap = static_cast<GLuint>(-1);
+    }
+
+    glGetIntegerv(GL_ACTIVE_TEXTURE, &value);
+    activeUnit = value;
+    glGetIntegerv(GL_DEPTH_FUNC, &value);
+    depthFunc = value;
+    depthTest = glIsEnabled(GL_DEPTH_TEST);
+    blend = glIsEnabled(GL_BLEND);
+    glGetIntegerv(GL_BLEND_SRC_RGB, &value);
+    blendSrc = value;
+    glGetIntegerv(GL_BLEND_DST_RGB, &value);
+    blendDst = value;
+}
+
+void OpenGLStateCache::useProgram(GLuint id) {
+    if (changed(id != program)) {
+        EngineStats::current().programBinds++;
+        glUseProgram(id);
+        program = id;
+    }
+}
+
+void OpenGLStateCache::bindVertexArray(GLuint id) {
+    if (changed(id != vertexArray)) {
+        EngineStats::current().vertexArrayBinds++;
+        glBindVertexArray(id);
+        vertexArray = id;
+    }
+}
+
+void OpenGLStateCache::bindBuffer(GLenum target, GLuint id) {
+    int slot = bufferSlot(target);
+    if (slot < 0) {
+        frameCounters.issued++;
+        glBindBuffer(target, id);
+        return;
+    }
+
+    if (changed(id != buffers[slot])) {
+        glBindBuffer(target, id);
+        buffers[slot] = id;
+    }
+}
+
+void OpenGLStateCache::bindBufferRange(GLenum target, GLuint index, GLuint id, GLintptr offset,
+                                       GLsizeiptr size) {
+    if (target != GL_UNIFORM_BUFFER || index >= MAX_UNIFORM_BINDINGS) {
+        frameCounters.issued++;
+        glBindBufferRange(target, index, id, offset, size);
+        return;
+    }
+
+    UniformRange& range = uniformRanges[index];
+    if (changed(range.buffer != id || range.offset != offset || range.size != size)) {
+        glBindBufferRange(target, index, id, offset, size);
+        range.buffer = id;
+        range.offset = offset;
+        range.size = size;
+        // O bind indexado tambem troca o binding generico do alvo
+        buffers[UNIFORM_SLOT] = id;
+    }
+}
+
+void OpenGLStateCache::bindTexture(GLuint unit, GLenum target, GLuint id) {
+    if (unit >= MAX_TEXTURE_UNITS ||
+        (target != GL_TEXTURE_2D && target != GL_TEXTURE_CUBE_MAP)) {
+        frameCounters.issued += 2;
+        EngineStats::current().textureBinds++;
+        glActiveTexture(GL_TEXTURE0 + unit);
+        glBindTexture(target, id);
+        activeUnit = GL_TEXTURE0 + unit;
+        return;
+    }
+
+    GLuint& bound = target == GL_TEXTURE_2D ? textureUnits[unit].texture2D
+                                            : textureUnits[unit].cubeMap;
+    if (!changed(bound != id)) {
+        return;
+    }
+
+    if (changed(activeUnit != GL_TEXTURE0 + unit)) {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        activeUnit = GL_TEXTURE0 + unit;
+    }
+    EngineStats::current().textureBinds++;
+    glBindTexture(target, id);
+    bound = id;
+}
+
+void OpenGLStateCache::setDepthFunc(GLenum func) {
+    if (changed(func != depthFunc)) {
+        glDepthFunc(func);
+        depthFunc = func;
+    }
+}
+
+void OpenGLStateCache::setDepthTest(bool enabled) {
+    if (changed(enabled != depthTest)) {
+        enabled ? glEnable(GL_DEPTH_TEST) : glDisable(GL_DEPTH_TEST);
+        depthTest = enabled;
+    }
+}
+
+void OpenGLStateCache::setBlend(bool enabled) {
+    if (changed(enabled != blend)) {
+        enabled ? glEnable(GL_BLEND) : glDisable(GL_BLEND);
+        blend = enabled;
+    }
+}
+
+void OpenGLStateCache::setBlendFunc(GLenum src, GLenum dst) {
+    if (changed(src != blendSrc || dst != blendDst)) {
+        glBlendFunc(src, dst);
+        blendSrc = src;
+        blendDst = dst;
+    }
+}
+
+void OpenGLStateCache::forgetProgram(GLuint id) {
+    // glDeleteProgram do program em uso so o libera quando outro for usado
+    if (program == id) {
+        program = static_cast<GLuint>(-1);
+    }
+}
+
+void OpenGLStateCache::forgetVertexArray(GLuint id) {
+    // Deletar o VAO ligado volta o binding para 0
+    if (vertexArray == id) {
+        vertexArray = 0;
+    }
+}
+
+void OpenGLStateCache::forgetBuffer(GLuint id) {
+    for (auto& buffer : buffers) {
+        if (buffer == id) {
+            buffer = 0;
+        }
+    }
+    for (auto& range : uniformRanges) {
+        if (range.buffer == id) {
+            range = UniformRange();
+        }
+    }
+}
+
+void OpenGLStateCache::forgetTexture(GLuint id) {
+    for (auto& unit : textureUnits) {
+        if (unit.texture2D == id) {
+            unit.texture2D = 0;
+        }
+        if (unit.cubeMap == id) {
+            unit.cubeMap = 0;
+        }
+    }
+}
+
+void OpenGLStateCache::endFrame() {
+    lastFrameCounters = frameCounters;
+    frameCounters = Counters();
+
+    if (debugCounters) {
+        uint32_t total = lastFrameCounters.issued + lastFrameCounters.skipped;
+        LOG_INFO("GL state calls: " + std::to_string(lastFrameCounters.issued) + " issued, " +
+                 std::to_string(lastFrameCounters.skipped) + " skipped of " +
+                 std::to_string(total));
+    }
+}
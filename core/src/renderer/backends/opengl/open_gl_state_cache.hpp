@@ -0,0 +1,85 @@
+#ifndef OPEN_GL_STATE_CACHE_HPP
+#define OPEN_GL_STATE_CACHE_HPP
+
+#include <GL/glew.h>
+#include <cstdint>
+
+// Sombra do estado GL do contexto. Toda troca de program, VAO, buffer, textura,
+// depth func e blend do backend passa por aqui, e chamadas que nao mudam nada sao
+// puladas. Quem deleta um objeto GL deve avisar (forget*) para que um nome
+// reciclado pelo driver nao seja confundido com o objeto antigo.
+class OpenGLStateCache {
+  public:
+    static constexpr int MAX_UNIFORM_BINDINGS = 16;
+    static constexpr int MAX_TEXTURE_UNITS = 16;
+
+    struct Counters {
+        uint32_t issued = 0;
+        uint32_t skipped = 0;
+    };
+
+  private:
+    enum BufferSlot { ARRAY_SLOT, UNIFORM_SLOT, COPY_WRITE_SLOT, BUFFER_SLOT_COUNT };
+
+    struct UniformRange {
+        GLuint buffer = 0;
+        GLintptr offset = -1;
+        GLsizeiptr size = -1;
+    };
+
+    struct TextureUnit {
+        GLuint texture2D = 0;
+        GLuint cubeMap = 0;
+    };
+
+    GLuint program = 0;
+    GLuint vertexArray = 0;
+    GLuint buffers[BUFFER_SLOT_COUNT] = {};
+    UniformRange uniformRanges[MAX_UNIFORM_BINDINGS];
+    GLenum activeUnit = 0;
+    TextureUnit textureUnits[MAX_TEXTURE_UNITS];
+    GLenum depthFunc = GL_LESS;
+    bool depthTest = false;
+    bool blend = false;
+    GLenum blendSrc = GL_ONE;
+    GLenum blendDst = GL_ZERO;
+
+    bool debugCounters = false;
+    Counters frameCounters;
+    Counters lastFrameCounters;
+
+    static int bufferSlot(GLenum target);
+    bool changed(bool isDifferent);
+
+  public:
+    // Le o estado atual do contexto; chamar depois do contexto criado e sempre que
+    // codigo fora do cache puder ter mexido no estado
+    void reset();
+
+    void useProgram(GLuint id);
+    void bindVertexArray(GLuint id);
+    void bindBuffer(GLenum target, GLuint id);
+    void bindBufferRange(GLenum target, GLuint index, GLuint id, GLintptr offset,
+                         GLsizeiptr size);
+    void bindTexture(GLuint unit, GLenum target, GLuint id);
+    void setDepthFunc(GLenum func);
+    void setDepthTest(bool enabled);
+    void setBlend(bool enabled);
+    void setBlendFunc(GLenum src, GLenum dst);
+
+    void forgetProgram(GLuint id);
+    void forgetVertexArray(GLuint id);
+    void forgetBuffer(GLuint id);
+    void forgetTexture(GLuint id);
+
+    GLuint getProgram() const { return program; }
+    GLuint getVertexArray() const { return vertexArray; }
+
+    // Com o modo de debug ligado, endFrame() loga chamadas emitidas vs puladas
+    void setDebugCounters(bool enabled) { debugCounters = enabled; }
+    bool hasDebugCounters() const { return debugCounters; }
+    void endFrame();
+    const Counters& getLastFrameCounters() const { return lastFrameCounters; }
+};
+
+#endif // OPEN_GL_STATE_CACHE_HPP
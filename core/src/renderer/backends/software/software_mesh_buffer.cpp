@@ -0,0 +1,47 @@
+#define CLASS_NAME "SoftwareMeshBuffer"
+#include "../../../log_macros.hpp"
+
+#include "software_mesh_buffer.hpp"
+
+SoftwareMeshBuffer::SoftwareMeshBuffer(SoftwareRendererBackend* backend) {}
+
+bool SoftwareMeshBuffer::createBuffers(const std::vector<float>& vertices,
+                                       const std::vector<float>& normals) {
+    if (vertices.empty() || vertices.size() % 3 != 0) {
+        LOG_ERROR("Invalid vertex data");
+        return false;
+    }
+
+    destroy();
+    size_t count = vertices.size() / 3;
+    positionX.reserve(count);
+    positionY.reserve(count);
+    positionZ.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        positionX.push_back(vertices[i * 3 + 0]);
+        positionY.push_back(vertices[i * 3 + 1]);
+        positionZ.push_back(vertices[i * 3 + 2]);
+    }
+
+    // Normais incompletas sao ignoradas; o modelo flat cai no termo ambiente
+    if (normals.size() == vertices.size()) {
+        normalX.reserve(count);
+        normalY.reserve(count);
+        normalZ.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            normalX.push_back(normals[i * 3 + 0]);
+            normalY.push_back(normals[i * 3 + 1]);
+            normalZ.push_back(normals[i * 3 + 2]);
+        }
+    }
+    return true;
+}
+
+void SoftwareMeshBuffer::destroy() {
+    positionX.clear();
+    positionY.clear();
+    positionZ.clear();
+    normalX.clear();
+    normalY.clear();
+    normalZ.clear();
+}
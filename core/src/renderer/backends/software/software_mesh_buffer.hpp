@@ -0,0 +1,35 @@
+#ifndef SOFTWARE_MESH_BUFFER_HPP
+#define SOFTWARE_MESH_BUFFER_HPP
+
+#include "../../../mesh_buffer.hpp"
+#include <vector>
+
+class SoftwareRendererBackend;
+
+// Copia posicoes e normais em SoA, o layout que a transformacao SIMD le
+class SoftwareMeshBuffer : public MeshBuffer {
+  private:
+    std::vector<float> positionX, positionY, positionZ;
+    std::vector<float> normalX, normalY, normalZ;
+
+  public:
+    explicit SoftwareMeshBuffer(SoftwareRendererBackend* backend);
+
+    bool createBuffers(const std::vector<float>& vertices,
+                       const std::vector<float>& normals) override;
+    void bind() override {}
+    void unbind() override {}
+    void destroy() override;
+    void* getHandle() const override { return const_cast<SoftwareMeshBuffer*>(this); }
+
+    size_t getVertexCount() const { return positionX.size(); }
+    bool hasNormals() const { return !normalX.empty(); }
+    const float* getPositionX() const { return positionX.data(); }
+    const float* getPositionY() const { return positionY.data(); }
+    const float* getPositionZ() const { return positionZ.data(); }
+    const float* getNormalX() const { return normalX.data(); }
+    const float* getNormalY() const { return normalY.data(); }
+    const float* getNormalZ() const { return normalZ.data(); }
+};
+
+#endif // SOFTWARE_MESH_BUFFER_HPP
@@ -0,0 +1,522 @@
+#include "software_rasterizer.hpp"
+#include "../../../job_system.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SOFTWARE_RASTERIZER_SSE
+#include <emmintrin.h>
+#endif
+
+namespace {
+// Vertices ficam numa grade de 1/16 de pixel, como em rasterizadores de hardware
+constexpr float SUBPIXEL_STEPS = 16.0f;
+constexpr float MIN_AREA = 1.0f / (SUBPIXEL_STEPS * SUBPIXEL_STEPS);
+constexpr float AMBIENT = 0.4f;
+
+uint32_t toByte(float value) {
+    value = std::min(std::max(value, 0.0f), 1.0f);
+    return static_cast<uint32_t>(value * 255.0f + 0.5f);
+}
+
+uint32_t packColor(const glm::vec4& c) {
+    return (toByte(c.a) << 24) | (toByte(c.r) << 16) | (toByte(c.g) << 8) | toByte(c.b);
+}
+
+glm::vec4 unpackColor(uint32_t c) {
+    constexpr float scale = 1.0f / 255.0f;
+    return glm::vec4(((c >> 16) & 0xFF) * scale, ((c >> 8) & 0xFF) * scale, (c & 0xFF) * scale,
+                     ((c >> 24) & 0xFF) * scale);
+}
+
+glm::vec4 fetchTexel(const SoftwareTexture& texture, int x, int y) {
+    // GL_REPEAT
+    x %= texture.width;
+    y %= texture.height;
+    if (x < 0) {
+        x += texture.width;
+    }
+    if (y < 0) {
+        y += texture.height;
+    }
+
+    const uint8_t* p = &texture.pixels[(static_cast<size_t>(y) * texture.width + x) * 4];
+    constexpr float scale = 1.0f / 255.0f;
+    return glm::vec4(p[0] * scale, p[1] * scale, p[2] * scale, p[3] * scale);
+}
+
+glm::vec4 sampleTexture(const SoftwareTexture& texture, float u, float v) {
+    float x = u * texture.width - 0.5f;
+    float y = v * texture.height - 0.5f;
+    if (!texture.linear) {
+        return fetchTexel(texture, static_cast<int>(std::floor(x + 0.5f)),
+                          static_cast<int>(std::floor(y + 0.5f)));
+    }
+
+    float fx = std::floor(x);
+    float fy = std::floor(y);
+    int x0 = static_cast<int>(fx);
+    int y0 = static_cast<int>(fy);
+    float tx = x - fx;
+    float ty = y - fy;
+    glm::vec4 top = glm::mix(fetchTexel(texture, x0, y0), fetchTexel(texture, x0 + 1, y0), tx);
+    glm::vec4 bottom =
+        glm::mix(fetchTexel(texture, x0, y0 + 1), fetchTexel(texture, x0 + 1, y0 + 1), tx);
+    return glm::mix(top, bottom, ty);
+}
+
+bool lexicographicLess(const glm::vec2& a, const glm::vec2& b) {
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+} // namespace
+
+SoftwareRasterizer::SoftwareRasterizer() {}
+
+SoftwareRasterizer::~SoftwareRasterizer() {}
+
+void SoftwareRasterizer::setThreadCount(size_t threads) { threadCount = threads; }
+
+void SoftwareRasterizer::resize(int newWidth, int newHeight) {
+    width = std::max(newWidth, 1);
+    height = std::max(newHeight, 1);
+    tilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+    tilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
+    stride = tilesX * TILE_SIZE;
+
+    size_t pixels = static_cast<size_t>(stride) * tilesY * TILE_SIZE;
+    color.assign(pixels, clearColor);
+    depth.assign(pixels, clearDepth);
+    tileBins.assign(tilesX * tilesY, {});
+    triangles.clear();
+    draws.clear();
+}
+
+void SoftwareRasterizer::setClear(const glm::vec4& rgba, float depthValue) {
+    clearColor = packColor(rgba);
+    clearDepth = depthValue;
+    clearPending = true;
+}
+
+uint32_t SoftwareRasterizer::addDrawState(const SoftwareDrawState& state) {
+    draws.push_back(state);
+    return static_cast<uint32_t>(draws.size() - 1);
+}
+
+void SoftwareRasterizer::transformVertices(const float* x, const float* y, const float* z,
+                                           size_t count, const glm::mat4& m, float w,
+                                           float* outX, float* outY, float* outZ,
+                                           float* outW) {
+    size_t i = 0;
+#ifdef SOFTWARE_RASTERIZER_SSE
+    __m128 row[4][4];
+    for (int r = 0; r < 4; r++) {
+        for (int c = 0; c < 4; c++) {
+            row[r][c] = _mm_set1_ps(m[c][r]);
+        }
+    }
+    __m128 w4 = _mm_set1_ps(w);
+    float* out[4] = {outX, outY, outZ, outW};
+
+    for (; i + 4 <= count; i += 4) {
+        __m128 vx = _mm_loadu_ps(x + i);
+        __m128 vy = _mm_loadu_ps(y + i);
+        __m128 vz = _mm_loadu_ps(z + i);
+        for (int r = 0; r < 4; r++) {
+            if (!out[r]) {
+                continue;
+            }
+            __m128 sum = _mm_add_ps(_mm_mul_ps(row[r][0], vx), _mm_mul_ps(row[r][1], vy));
+            sum = _mm_add_ps(sum, _mm_mul_ps(row[r][2], vz));
+            sum = _mm_add_ps(sum, _mm_mul_ps(row[r][3], w4));
+            _mm_storeu_ps(out[r] + i, sum);
+        }
+    }
+#endif
+    for (; i < count; i++) {
+        glm::vec4 p = m * glm::vec4(x[i], y[i], z[i], w);
+        outX[i] = p.x;
+        outY[i] = p.y;
+        outZ[i] = p.z;
+        if (outW) {
+            outW[i] = p.w;
+        }
+    }
+}
+
+void SoftwareRasterizer::drawTriangles(const float* x, const float* y, const float* z,
+                                       const float* ax, const float* ay, const float* az,
+                                       size_t vertexCount, const glm::mat4& modelViewProjection,
+                                       const glm::mat4& attributeMatrix, uint32_t draw) {
+    vertexCount -= vertexCount % 3;
+    if (vertexCount == 0) {
+        return;
+    }
+
+    clipX.resize(vertexCount);
+    clipY.resize(vertexCount);
+    clipZ.resize(vertexCount);
+    clipW.resize(vertexCount);
+    transformVertices(x, y, z, vertexCount, modelViewProjection, 1.0f, clipX.data(),
+                      clipY.data(), clipZ.data(), clipW.data());
+
+    bool hasAttributes = ax && ay && az;
+    if (hasAttributes) {
+        attributeX.resize(vertexCount);
+        attributeY.resize(vertexCount);
+        attributeZ.resize(vertexCount);
+        transformVertices(ax, ay, az, vertexCount, attributeMatrix, 0.0f, attributeX.data(),
+                          attributeY.data(), attributeZ.data(), nullptr);
+    }
+
+    ClipVertex vertices[3];
+    for (size_t i = 0; i < vertexCount; i += 3) {
+        for (int k = 0; k < 3; k++) {
+            size_t v = i + k;
+            vertices[k].position = glm::vec4(clipX[v], clipY[v], clipZ[v], clipW[v]);
+            vertices[k].attribute = hasAttributes
+                                        ? glm::vec3(attributeX[v], attributeY[v], attributeZ[v])
+                                        : glm::vec3(0.0f);
+        }
+        submitClipped(vertices, draw);
+    }
+}
+
+void SoftwareRasterizer::drawTriangle(const glm::vec4 positions[3],
+                                      const glm::vec3 attributes[3], uint32_t draw) {
+    ClipVertex vertices[3];
+    for (int k = 0; k < 3; k++) {
+        vertices[k].position = positions[k];
+        vertices[k].attribute = attributes ? attributes[k] : glm::vec3(0.0f);
+    }
+    submitClipped(vertices, draw);
+}
+
+void SoftwareRasterizer::submitClipped(const ClipVertex vertices[3], uint32_t draw) {
+    // Descarte trivial: os tres vertices fora do mesmo plano do frustum
+    const glm::vec4& a = vertices[0].position;
+    const glm::vec4& b = vertices[1].position;
+    const glm::vec4& c = vertices[2].position;
+    if ((a.x > a.w && b.x > b.w && c.x > c.w) || (a.x < -a.w && b.x < -b.w && c.x < -c.w) ||
+        (a.y > a.w && b.y > b.w && c.y > c.w) || (a.y < -a.w && b.y < -b.w && c.y < -c.w) ||
+        (a.z > a.w && b.z > b.w && c.z > c.w)) {
+        return;
+    }
+
+    float distance[3];
+    int inside = 0;
+    for (int k = 0; k < 3; k++) {
+        distance[k] = vertices[k].position.z + vertices[k].position.w;
+        inside += distance[k] >= 0.0f;
+    }
+
+    if (inside == 3) {
+        setupTriangle(vertices, draw);
+        return;
+    }
+    if (inside == 0) {
+        return;
+    }
+
+    // Sutherland-Hodgman contra o plano near (z = -w); gera ate 4 vertices
+    ClipVertex polygon[4];
+    int count = 0;
+    for (int k = 0; k < 3; k++) {
+        int next = (k + 1) % 3;
+        if (distance[k] >= 0.0f) {
+            polygon[count++] = vertices[k];
+        }
+        if ((distance[k] >= 0.0f) != (distance[next] >= 0.0f)) {
+            float t = distance[k] / (distance[k] - distance[next]);
+            polygon[count].position =
+                glm::mix(vertices[k].position, vertices[next].position, t);
+            polygon[count].attribute =
+                glm::mix(vertices[k].attribute, vertices[next].attribute, t);
+            count++;
+        }
+    }
+
+    for (int k = 1; k + 1 < count; k++) {
+        ClipVertex fan[3] = {polygon[0], polygon[k], polygon[k + 1]};
+        setupTriangle(fan, draw);
+    }
+}
+
+void SoftwareRasterizer::setupTriangle(const ClipVertex vertices[3], uint32_t draw) {
+    glm::vec2 screen[3];
+    float z[3], invW[3];
+    glm::vec3 attribute[3];
+
+    for (int k = 0; k < 3; k++) {
+        const glm::vec4& p = vertices[k].position;
+        if (p.w <= 0.0f) {
+            return;
+        }
+        invW[k] = 1.0f / p.w;
+        float sx = (p.x * invW[k] * 0.5f + 0.5f) * width;
+        float sy = (0.5f - p.y * invW[k] * 0.5f) * height;
+        screen[k] = glm::vec2(std::round(sx * SUBPIXEL_STEPS) / SUBPIXEL_STEPS,
+                              std::round(sy * SUBPIXEL_STEPS) / SUBPIXEL_STEPS);
+        z[k] = p.z * invW[k] * 0.5f + 0.5f;
+        attribute[k] = vertices[k].attribute * invW[k];
+    }
+
+    float area = (screen[1].x - screen[0].x) * (screen[2].y - screen[0].y) -
+                 (screen[1].y - screen[0].y) * (screen[2].x - screen[0].x);
+    if (std::fabs(area) < MIN_AREA) {
+        return;
+    }
+    // Sem culling de faces (como o backend OpenGL); normaliza a orientacao
+    if (area < 0.0f) {
+        std::swap(screen[1], screen[2]);
+        std::swap(z[1], z[2]);
+        std::swap(invW[1], invW[2]);
+        std::swap(attribute[1], attribute[2]);
+        area = -area;
+    }
+
+    float minX = std::min({screen[0].x, screen[1].x, screen[2].x});
+    float maxX = std::max({screen[0].x, screen[1].x, screen[2].x});
+    float minY = std::min({screen[0].y, screen[1].y, screen[2].y});
+    float maxY = std::max({screen[0].y, screen[1].y, screen[2].y});
+
+    Triangle triangle;
+    triangle.minX = std::max(static_cast<int>(std::floor(minX)), 0);
+    triangle.maxX = std::min(static_cast<int>(std::ceil(maxX)), width - 1);
+    triangle.minY = std::max(static_cast<int>(std::floor(minY)), 0);
+    triangle.maxY = std::min(static_cast<int>(std::ceil(maxY)), height - 1);
+    if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY) {
+        return;
+    }
+    triangle.draw = draw;
+
+    float invArea = 1.0f / area;
+    glm::vec3 lambdaA, lambdaB, lambdaC;
+    for (int k = 0; k < 3; k++) {
+        // Aresta oposta ao vertice k. Os coeficientes sao calculados sempre na ordem
+        // lexicografica dos extremos e negados se preciso: dois triangulos que dividem
+        // a aresta avaliam exatamente o mesmo valor com sinais opostos, sem frestas
+        // nem pixels desenhados duas vezes.
+        glm::vec2 from = screen[(k + 1) % 3];
+        glm::vec2 to = screen[(k + 2) % 3];
+        bool flipped = lexicographicLess(to, from);
+        if (flipped) {
+            std::swap(from, to);
+        }
+
+        float a = from.y - to.y;
+        float b = to.x - from.x;
+        float c = from.x * to.y - from.y * to.x;
+        if (flipped) {
+            a = -a;
+            b = -b;
+            c = -c;
+        }
+
+        triangle.edgeA[k] = a;
+        triangle.edgeB[k] = b;
+        triangle.edgeC[k] = c;
+        // Regra de preenchimento: em valor exatamente zero so um dos lados fica com o pixel
+        triangle.includeEdge[k] = a > 0.0f || (a == 0.0f && b > 0.0f);
+
+        lambdaA[k] = a * invArea;
+        lambdaB[k] = b * invArea;
+        lambdaC[k] = c * invArea;
+    }
+
+    auto plane = [&](const glm::vec3& values) {
+        return glm::vec3(glm::dot(lambdaA, values), glm::dot(lambdaB, values),
+                         glm::dot(lambdaC, values));
+    };
+    triangle.depthPlane = plane(glm::vec3(z[0], z[1], z[2]));
+    triangle.invWPlane = plane(glm::vec3(invW[0], invW[1], invW[2]));
+    for (int axis = 0; axis < 3; axis++) {
+        triangle.attributePlanes[axis] =
+            plane(glm::vec3(attribute[0][axis], attribute[1][axis], attribute[2][axis]));
+    }
+
+    uint32_t index = static_cast<uint32_t>(triangles.size());
+    triangles.push_back(triangle);
+    for (int ty = triangle.minY / TILE_SIZE; ty <= triangle.maxY / TILE_SIZE; ty++) {
+        for (int tx = triangle.minX / TILE_SIZE; tx <= triangle.maxX / TILE_SIZE; tx++) {
+            tileBins[ty * tilesX + tx].push_back(index);
+        }
+    }
+}
+
+void SoftwareRasterizer::flush() {
+    if (triangles.empty() && !clearPending) {
+        return;
+    }
+
+    int tileCount = tilesX * tilesY;
+    if (threadCount == 1) {
+        for (int tile = 0; tile < tileCount; tile++) {
+            rasterizeTile(tile);
+        }
+    } else {
+        // Um tile por vez: o custo varia muito entre tiles
+        Yume::JobSystem::shared().parallelFor(tileCount, 1, [this](size_t begin, size_t end) {
+            for (size_t tile = begin; tile < end; tile++) {
+                rasterizeTile(static_cast<int>(tile));
+            }
+        });
+    }
+
+    triangles.clear();
+    draws.clear();
+    for (auto& bin : tileBins) {
+        bin.clear();
+    }
+    clearPending = false;
+}
+
+void SoftwareRasterizer::clearTile(int x0, int y0, int x1, int y1) {
+    for (int y = y0; y < y1; y++) {
+        size_t row = static_cast<size_t>(y) * stride;
+        std::fill(color.begin() + row + x0, color.begin() + row + x1, clearColor);
+        std::fill(depth.begin() + row + x0, depth.begin() + row + x1, clearDepth);
+    }
+}
+
+void SoftwareRasterizer::rasterizeTile(int tile) {
+    int x0 = (tile % tilesX) * TILE_SIZE;
+    int y0 = (tile / tilesX) * TILE_SIZE;
+    int x1 = x0 + TILE_SIZE;
+    int y1 = y0 + TILE_SIZE;
+
+    if (clearPending) {
+        clearTile(x0, y0, x1, y1);
+    }
+
+    for (uint32_t index : tileBins[tile]) {
+        const Triangle& triangle = triangles[index];
+        // Inicio alinhado a 4 pixels; como o tile tambem e, os grupos nao saem dele
+        int startX = std::max(triangle.minX, x0) & ~3;
+        rasterizeTriangle(triangle, startX, std::max(triangle.minY, y0),
+                          std::min(triangle.maxX + 1, x1), std::min(triangle.maxY + 1, y1));
+    }
+}
+
+void SoftwareRasterizer::rasterizeTriangle(const Triangle& triangle, int x0, int y0, int x1,
+                                           int y1) {
+    const SoftwareDrawState& state = draws[triangle.draw];
+
+#ifdef SOFTWARE_RASTERIZER_SSE
+    __m128 edgeA[3], include[3];
+    for (int k = 0; k < 3; k++) {
+        edgeA[k] = _mm_set1_ps(triangle.edgeA[k]);
+        include[k] = _mm_castsi128_ps(_mm_set1_epi32(triangle.includeEdge[k] ? -1 : 0));
+    }
+    const __m128 depthA = _mm_set1_ps(triangle.depthPlane.x);
+    const __m128 laneOffset = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    for (int y = y0; y < y1; y++) {
+        float py = y + 0.5f;
+        __m128 rowTerm[3];
+        for (int k = 0; k < 3; k++) {
+            rowTerm[k] = _mm_set1_ps(triangle.edgeB[k] * py + triangle.edgeC[k]);
+        }
+        __m128 depthRow = _mm_set1_ps(triangle.depthPlane.y * py + triangle.depthPlane.z);
+        size_t row = static_cast<size_t>(y) * stride;
+
+        for (int x = x0; x < x1; x += 4) {
+            __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), laneOffset);
+            __m128 mask = _mm_castsi128_ps(_mm_set1_epi32(-1));
+            for (int k = 0; k < 3; k++) {
+                __m128 value = _mm_add_ps(_mm_mul_ps(edgeA[k], px), rowTerm[k]);
+                __m128 inside = _mm_or_ps(_mm_cmpgt_ps(value, zero),
+                                          _mm_and_ps(_mm_cmpeq_ps(value, zero), include[k]));
+                mask = _mm_and_ps(mask, inside);
+            }
+            if (_mm_movemask_ps(mask) == 0) {
+                continue;
+            }
+
+            __m128 z = _mm_add_ps(_mm_mul_ps(depthA, px), depthRow);
+            __m128 stored = _mm_loadu_ps(&depth[row + x]);
+            mask = _mm_and_ps(mask, _mm_cmplt_ps(z, stored));
+            mask = _mm_and_ps(mask, _mm_cmple_ps(z, one));
+            mask = _mm_and_ps(mask, _mm_cmpge_ps(z, zero));
+            int bits = _mm_movemask_ps(mask);
+            if (bits == 0) {
+                continue;
+            }
+
+            alignas(16) float zLanes[4];
+            _mm_store_ps(zLanes, z);
+            for (int lane = 0; lane < 4; lane++) {
+                if (bits & (1 << lane)) {
+                    size_t pixel = row + x + lane;
+                    depth[pixel] = zLanes[lane];
+                    shadePixel(triangle, state, x + lane + 0.5f, py, zLanes[lane], color[pixel]);
+                }
+            }
+        }
+    }
+#else
+    for (int y = y0; y < y1; y++) {
+        float py = y + 0.5f;
+        float rowTerm[3];
+        for (int k = 0; k < 3; k++) {
+            rowTerm[k] = triangle.edgeB[k] * py + triangle.edgeC[k];
+        }
+        float depthRow = triangle.depthPlane.y * py + triangle.depthPlane.z;
+        size_t row = static_cast<size_t>(y) * stride;
+
+        for (int x = x0; x < x1; x++) {
+            float px = x + 0.5f;
+            bool covered = true;
+            for (int k = 0; k < 3 && covered; k++) {
+                float value = triangle.edgeA[k] * px + rowTerm[k];
+                covered = value > 0.0f || (value == 0.0f && triangle.includeEdge[k]);
+            }
+            if (!covered) {
+                continue;
+            }
+
+            float z = triangle.depthPlane.x * px + depthRow;
+            size_t pixel = row + x;
+            if (z < depth[pixel] && z <= 1.0f && z >= 0.0f) {
+                depth[pixel] = z;
+                shadePixel(triangle, state, px, py, z, color[pixel]);
+            }
+        }
+    }
+#endif
+}
+
+void SoftwareRasterizer::shadePixel(const Triangle& triangle, const SoftwareDrawState& state,
+                                    float px, float py, float z, uint32_t& outColor) {
+    glm::vec4 result = state.color;
+
+    if (state.model == SoftwareShadingModel::FLAT ||
+        (state.model == SoftwareShadingModel::SPRITE && state.texture)) {
+        // Interpolacao com correcao de perspectiva
+        float invW = triangle.invWPlane.x * px + triangle.invWPlane.y * py + triangle.invWPlane.z;
+        float w = 1.0f / invW;
+        glm::vec3 attribute;
+        for (int axis = 0; axis < 3; axis++) {
+            const glm::vec3& plane = triangle.attributePlanes[axis];
+            attribute[axis] = (plane.x * px + plane.y * py + plane.z) * w;
+        }
+
+        if (state.model == SoftwareShadingModel::FLAT) {
+            float length = glm::length(attribute);
+            glm::vec3 normal = length > 0.0f ? attribute / length : glm::vec3(0.0f);
+            float diffuse = std::max(glm::dot(normal, -state.lightDirection), AMBIENT);
+            result = glm::vec4(glm::vec3(state.color) * diffuse, state.color.a);
+        } else {
+            result = state.color * sampleTexture(*state.texture, attribute.x, attribute.y);
+        }
+    }
+
+    if (result.a < 1.0f) {
+        // GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA
+        glm::vec4 destination = unpackColor(outColor);
+        result = glm::vec4(glm::mix(glm::vec3(destination), glm::vec3(result), result.a),
+                           result.a * result.a + destination.a * (1.0f - result.a));
+    }
+    outColor = packColor(result);
+}
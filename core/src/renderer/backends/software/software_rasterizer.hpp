@@ -0,0 +1,123 @@
+#ifndef SOFTWARE_RASTERIZER_HPP
+#define SOFTWARE_RASTERIZER_HPP
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+
+// Modelos de shading suportados pelo backend de software; equivalem aos pixel shaders
+// HLSL da raiz (flat.pxs, unlit.pxs) e ao shader de sprite
+enum class SoftwareShadingModel : uint8_t { UNLIT, FLAT, SPRITE, SKYBOX };
+
+struct SoftwareTexture {
+    int width = 0;
+    int height = 0;
+    bool linear = false;
+    std::vector<uint8_t> pixels; // RGBA8, linha 0 = primeira linha do arquivo
+};
+
+struct SoftwareDrawState {
+    SoftwareShadingModel model = SoftwareShadingModel::UNLIT;
+    glm::vec4 color = glm::vec4(1.0f);
+    // Direcao da luz como em LightData (sentido em que a luz viaja)
+    glm::vec3 lightDirection = glm::vec3(0.0f, 0.0f, -1.0f);
+    const SoftwareTexture* texture = nullptr;
+};
+
+// Rasterizador em tiles. Os vertices sao transformados 4 por vez (SSE), os triangulos
+// sao recortados contra o plano near, montados em tela e distribuidos em bins de tiles
+// de 64x64. flush() rasteriza os tiles em paralelo; cada tile e de uma thread so e
+// processa seus triangulos na ordem de submissao, entao a imagem nao depende do numero
+// de threads.
+//
+// Cor em ARGB8888 (mesmo layout de SDL_PIXELFORMAT_ARGB8888), profundidade em float
+// [0, 1] com teste LESS, como o backend OpenGL. Alpha < 1 mistura com SRC_ALPHA.
+class SoftwareRasterizer {
+  public:
+    static constexpr int TILE_SIZE = 64;
+
+  private:
+    struct Triangle {
+        // Funcoes de aresta w = a*x + b*y + c, ja normalizadas pela area
+        float edgeA[3], edgeB[3], edgeC[3];
+        bool includeEdge[3];
+        // Planos de profundidade, 1/w e atributos/w em tela
+        glm::vec3 depthPlane;
+        glm::vec3 invWPlane;
+        glm::vec3 attributePlanes[3];
+        int minX, minY, maxX, maxY; // max inclusivo
+        uint32_t draw;
+    };
+
+    struct ClipVertex {
+        glm::vec4 position;
+        glm::vec3 attribute;
+    };
+
+    int width = 0;
+    int height = 0;
+    int tilesX = 0;
+    int tilesY = 0;
+    int stride = 0; // largura alinhada aos tiles
+
+    std::vector<uint32_t> color;
+    std::vector<float> depth;
+    uint32_t clearColor = 0xFF000000u;
+    float clearDepth = 1.0f;
+    bool clearPending = false;
+
+    std::vector<SoftwareDrawState> draws;
+    std::vector<Triangle> triangles;
+    std::vector<std::vector<uint32_t>> tileBins;
+
+    // Saida da transformacao de vertices (SoA)
+    std::vector<float> clipX, clipY, clipZ, clipW;
+    std::vector<float> attributeX, attributeY, attributeZ;
+
+    size_t threadCount = 0;
+
+    void transformVertices(const float* x, const float* y, const float* z, size_t count,
+                           const glm::mat4& matrix, float w, float* outX, float* outY,
+                           float* outZ, float* outW);
+    void submitClipped(const ClipVertex vertices[3], uint32_t draw);
+    void setupTriangle(const ClipVertex vertices[3], uint32_t draw);
+    void rasterizeTile(int tile);
+    void clearTile(int x0, int y0, int x1, int y1);
+    void rasterizeTriangle(const Triangle& triangle, int x0, int y0, int x1, int y1);
+    void shadePixel(const Triangle& triangle, const SoftwareDrawState& state, float px,
+                    float py, float z, uint32_t& outColor);
+
+  public:
+    SoftwareRasterizer();
+    ~SoftwareRasterizer();
+
+    // threads == 1 rasteriza so na thread que chama flush; outro valor divide os tiles
+    // com o JobSystem compartilhado (a thread que chama flush tambem trabalha)
+    void setThreadCount(size_t threads);
+    void resize(int newWidth, int newHeight);
+    void setClear(const glm::vec4& rgba, float depthValue = 1.0f);
+
+    uint32_t addDrawState(const SoftwareDrawState& state);
+
+    // Malha nao indexada: cada 3 vertices formam um triangulo. attributes pode ser
+    // nullptr; normais sao transformadas por attributeMatrix (w = 0).
+    void drawTriangles(const float* x, const float* y, const float* z, const float* ax,
+                       const float* ay, const float* az, size_t vertexCount,
+                       const glm::mat4& modelViewProjection, const glm::mat4& attributeMatrix,
+                       uint32_t draw);
+    // Triangulo ja em clip space; attributes recebe normal ou (u, v, 0)
+    void drawTriangle(const glm::vec4 positions[3], const glm::vec3 attributes[3],
+                      uint32_t draw);
+
+    // Rasteriza tudo o que foi submetido desde o ultimo flush
+    void flush();
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    int getStride() const { return stride; }
+    const uint32_t* getColorBuffer() const { return color.data(); }
+    size_t getTriangleCount() const { return triangles.size(); }
+};
+
+#endif // SOFTWARE_RASTERIZER_HPP
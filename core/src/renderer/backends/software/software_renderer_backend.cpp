@@ -0,0 +1,297 @@
+#define CLASS_NAME "SoftwareRendererBackend"
+#include "../../../log_macros.hpp"
+
+#include "../../../color.hpp"
+#include "../../../game_object.hpp"
+#include "../../../material.hpp"
+#include "../../../mesh_renderer.hpp"
+#include "../../../stb_image.h"
+#include "../../../engine_stats.hpp"
+#include "../../../memory_tracker.hpp"
+#include "../../../trace.hpp"
+#include "mesh_buffer_factory.hpp"
+#include "shader_compiler_factory.hpp"
+#include "shader_program_factory.hpp"
+#include "software_mesh_buffer.hpp"
+#include "software_renderer_backend.hpp"
+#include "software_shader_program.hpp"
+#include <SDL2/SDL.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+constexpr int DEFAULT_WIDTH = 800;
+constexpr int DEFAULT_HEIGHT = 600;
+
+// Mesmo quad do backend OpenGL: posicao xyz e uv
+constexpr float SPRITE_QUAD[6][5] = {
+    {-0.5f, -0.5f, 0.0f, 0.0f, 0.0f}, {0.5f, -0.5f, 0.0f, 1.0f, 0.0f},
+    {0.5f, 0.5f, 0.0f, 1.0f, 1.0f},   {-0.5f, -0.5f, 0.0f, 0.0f, 0.0f},
+    {0.5f, 0.5f, 0.0f, 1.0f, 1.0f},   {-0.5f, 0.5f, 0.0f, 0.0f, 1.0f}};
+} // namespace
+
+GraphicsAPI SoftwareRendererBackend::getGraphicsAPI() const { return GraphicsAPI::SOFTWARE; }
+
+// Os shaders sao escolhidos pelo nome do arquivo HLSL, sem compilacao
+std::string SoftwareRendererBackend::getShaderExtension() const { return ""; }
+
+unsigned int SoftwareRendererBackend::getRequiredWindowFlags() const { return 0; }
+
+std::unique_ptr<ShaderProgram> SoftwareRendererBackend::createShaderProgram() {
+    return ShaderProgramFactory::create(getGraphicsAPI(), this);
+}
+
+std::unique_ptr<MeshBuffer> SoftwareRendererBackend::createMeshBuffer() {
+    return MeshBufferFactory::create(getGraphicsAPI(), this);
+}
+
+std::unique_ptr<ShaderCompiler> SoftwareRendererBackend::createShaderCompiler() {
+    return ShaderCompilerFactory::create(getGraphicsAPI(), this);
+}
+
+bool SoftwareRendererBackend::initWindowContext() { return true; }
+
+bool SoftwareRendererBackend::init(SDL_Window* window) {
+    if (!window) {
+        LOG_ERROR("Window is null!");
+        return false;
+    }
+
+    int width = 0, height = 0;
+    SDL_GetWindowSize(window, &width, &height);
+    resize(width, height);
+    return init();
+}
+
+bool SoftwareRendererBackend::init() {
+    if (rasterizer.getWidth() == 0) {
+        resize(DEFAULT_WIDTH, DEFAULT_HEIGHT);
+    }
+
+    LOG_INFO("Software rasterizer " + std::to_string(rasterizer.getWidth()) + "x" +
+             std::to_string(rasterizer.getHeight()));
+    return true;
+}
+
+bool SoftwareRendererBackend::initHeadless(int width, int height) {
+    resize(width, height);
+    return init();
+}
+
+bool SoftwareRendererBackend::readPixels(std::vector<uint8_t>& rgba, int& width, int& height) {
+    width = rasterizer.getWidth();
+    height = rasterizer.getHeight();
+    rgba.resize(static_cast<size_t>(width) * height * 4);
+
+    const uint32_t* color = rasterizer.getColorBuffer();
+    uint8_t* out = rgba.data();
+    for (int y = 0; y < height; y++) {
+        const uint32_t* row = color + static_cast<size_t>(y) * rasterizer.getStride();
+        for (int x = 0; x < width; x++) {
+            uint32_t argb = row[x];
+            *out++ = static_cast<uint8_t>(argb >> 16);
+            *out++ = static_cast<uint8_t>(argb >> 8);
+            *out++ = static_cast<uint8_t>(argb);
+            *out++ = static_cast<uint8_t>(argb >> 24);
+        }
+    }
+    return true;
+}
+
+void SoftwareRendererBackend::resize(int width, int height) { rasterizer.resize(width, height); }
+
+void SoftwareRendererBackend::onCameraSet() {}
+
+void SoftwareRendererBackend::bindCamera(Camera* camera) {
+    if (!camera) {
+        LOG_ERROR("Camera is null");
+        return;
+    }
+    mainCamera = camera;
+
+    frameView = camera->getViewMatrix();
+    frameProjection = camera->getProjectionMatrix();
+}
+
+void SoftwareRendererBackend::clear(Camera* camera) {
+    ColorRGBA bgColor = camera ? camera->getBackgroundColor() : COLOR::BLACK;
+    // Aplicado por tile no proximo flush, junto com a rasterizacao
+    rasterizer.setClear(glm::vec4(bgColor.r, bgColor.g, bgColor.b, bgColor.a));
+}
+
+void SoftwareRendererBackend::setBufferDataImpl(const std::string& name, const void* data,
+                                                size_t size) {
+    if (name == "LightData" && size >= sizeof(glm::vec3)) {
+        std::memcpy(&defaultLightDirection, data, sizeof(glm::vec3));
+        return;
+    }
+    LOG_WARN("Unknown uniform block: " + name);
+}
+
+void SoftwareRendererBackend::setUniforms(ShaderProgram* shaderProgram) {
+    if (shaderProgram && shaderProgram->isValid()) {
+        shaderProgram->use();
+    }
+}
+
+void SoftwareRendererBackend::applyMaterial(Material* material) {
+    auto program = material ? material->getShaderProgram() : nullptr;
+    if (!program || !program->isValid()) {
+        return;
+    }
+
+    currentMaterial = material;
+    setUniforms(program);
+}
+
+uint32_t SoftwareRendererBackend::makeDrawState(SoftwareShadingModel model,
+                                                const SoftwareTexture* texture) {
+    SoftwareDrawState state;
+    state.model = model;
+    state.texture = texture;
+    if (currentMaterial) {
+        const ColorRGBA& color = currentMaterial->getBaseColor();
+        state.color = glm::vec4(color.r, color.g, color.b, color.a);
+    }
+
+    float length = glm::length(frameLightDirection);
+    state.lightDirection = length > 0.0f ? frameLightDirection / length : glm::vec3(0.0f);
+    return rasterizer.addDrawState(state);
+}
+
+void SoftwareRendererBackend::draw(const Mesh& mesh) {
+    auto meshBuffer = static_cast<SoftwareMeshBuffer*>(mesh.getMeshBuffer());
+    if (!meshBuffer || meshBuffer->getVertexCount() == 0) {
+        return;
+    }
+
+    SoftwareShadingModel model = SoftwareShadingModel::UNLIT;
+    if (currentMaterial && currentMaterial->getShaderProgram()) {
+        model = static_cast<SoftwareShaderProgram*>(currentMaterial->getShaderProgram())
+                    ->getShadingModel();
+    }
+    uint32_t drawIndex = makeDrawState(model, nullptr);
+
+    bool normals = meshBuffer->hasNormals();
+    rasterizer.drawTriangles(meshBuffer->getPositionX(), meshBuffer->getPositionY(),
+                             meshBuffer->getPositionZ(),
+                             normals ? meshBuffer->getNormalX() : nullptr,
+                             normals ? meshBuffer->getNormalY() : nullptr,
+                             normals ? meshBuffer->getNormalZ() : nullptr,
+                             meshBuffer->getVertexCount(),
+                             frameProjection * frameView * currentModel, currentModel, drawIndex);
+}
+
+void SoftwareRendererBackend::drawSprite(const Sprite& sprite) {
+    // A escala do sprite ja foi aplicada na matriz model ao montar a fila de render
+    unsigned int id = sprite.getTexture();
+    const SoftwareTexture* texture =
+        id > 0 && id <= textures.size() ? &textures[id - 1] : nullptr;
+    uint32_t drawIndex = makeDrawState(SoftwareShadingModel::SPRITE, texture);
+
+    glm::mat4 modelViewProjection = frameProjection * frameView * currentModel;
+    for (int t = 0; t < 2; t++) {
+        glm::vec4 positions[3];
+        glm::vec3 uvs[3];
+        for (int k = 0; k < 3; k++) {
+            const float* v = SPRITE_QUAD[t * 3 + k];
+            positions[k] = modelViewProjection * glm::vec4(v[0], v[1], v[2], 1.0f);
+            uvs[k] = glm::vec3(v[3], v[4], 0.0f);
+        }
+        rasterizer.drawTriangle(positions, uvs, drawIndex);
+    }
+}
+
+void SoftwareRendererBackend::renderGameObjects(std::vector<GameObject*>* gameObjects,
+                                                std::vector<Light>* lights) {
+    frameLightDirection = defaultLightDirection;
+    if (lights && !lights->empty() && (*lights)[0].type == LightType::DIRECTIONAL) {
+        const Vector3& direction = (*lights)[0].direction;
+        frameLightDirection = glm::vec3(direction.x, direction.y, direction.z);
+    }
+
+    renderQueue.build(*gameObjects, mainCamera);
+    for (size_t i = 0; i < renderQueue.size(); i++) {
+        const RenderItem& item = renderQueue[i];
+        applyMaterial(item.material);
+        currentModel = item.model;
+
+        if (item.sprite) {
+            drawSprite(*item.sprite);
+        } else {
+            draw(*item.mesh);
+        }
+    }
+    currentModel = glm::mat4(1.0f);
+}
+
+void SoftwareRendererBackend::flush() { rasterizer.flush(); }
+
+void SoftwareRendererBackend::present(SDL_Window* window) {
+    flush();
+    if (!window) {
+        return;
+    }
+
+    SDL_Surface* surface = SDL_GetWindowSurface(window);
+    if (!surface) {
+        LOG_ERROR("Failed to get window surface: " + SDL_GetError());
+        return;
+    }
+
+    // A janela pode ter mudado de tamanho; o framebuffer acompanha no proximo frame
+    int width = std::min(surface->w, rasterizer.getWidth());
+    int height = std::min(surface->h, rasterizer.getHeight());
+    if (surface->w != rasterizer.getWidth() || surface->h != rasterizer.getHeight()) {
+        resize(surface->w, surface->h);
+    }
+
+    if (SDL_MUSTLOCK(surface) && SDL_LockSurface(surface) != 0) {
+        LOG_ERROR("Failed to lock window surface: " + SDL_GetError());
+        return;
+    }
+    SDL_ConvertPixels(width, height, SDL_PIXELFORMAT_ARGB8888, rasterizer.getColorBuffer(),
+                      rasterizer.getStride() * sizeof(uint32_t), surface->format->format,
+                      surface->pixels, surface->pitch);
+    if (SDL_MUSTLOCK(surface)) {
+        SDL_UnlockSurface(surface);
+    }
+
+    SDL_UpdateWindowSurface(window);
+}
+
+unsigned int SoftwareRendererBackend::loadTexture(const std::string& path, uint8_t filterType) {
+    TRACE_ZONE("SoftwareRendererBackend::loadTexture");
+    MEMORY_SCOPE(MemoryTag::ASSETS);
+    int width, height, nrChannels;
+    unsigned char* data = stbi_load(path.c_str(), &width, &height, &nrChannels, 4);
+    if (!data) {
+        LOG_ERROR("Failed to load texture: " + path);
+        return 0;
+    }
+
+    LOG_INFO("Texture loaded: " + path + " (" + std::to_string(width) + "x" +
+             std::to_string(height) + ", " + std::to_string(nrChannels) + " channels)");
+
+    SoftwareTexture texture;
+    texture.width = width;
+    texture.height = height;
+    texture.linear = filterType == 1;
+    texture.pixels.assign(data, data + static_cast<size_t>(width) * height * 4);
+    stbi_image_free(data);
+
+    textures.push_back(std::move(texture));
+    EngineStats::countAsset(AssetType::TEXTURE, 1);
+    return static_cast<unsigned int>(textures.size());
+}
+
+unsigned int SoftwareRendererBackend::createCubemapTexture(const std::vector<std::string>& faces) {
+    TRACE_ZONE("SoftwareRendererBackend::createCubemapTexture");
+    MEMORY_SCOPE(MemoryTag::ASSETS);
+    LOG_WARN("Cubemaps are not supported by the software renderer, skybox disabled");
+    return 0;
+}
+
+void SoftwareRendererBackend::renderSkybox(const Mesh& mesh, unsigned int shaderProgram,
+                                           unsigned int textureID) {}
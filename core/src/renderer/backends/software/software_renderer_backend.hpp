@@ -0,0 +1,75 @@
+#ifndef SOFTWARE_RENDERER_BACKEND_HPP
+#define SOFTWARE_RENDERER_BACKEND_HPP
+
+#include "../../../graphics_api.hpp"
+#include "../../render_queue.hpp"
+#include "../../renderer_backend.hpp"
+#include "software_rasterizer.hpp"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Backend que rasteriza na CPU (SoftwareRasterizer) e copia o resultado para a
+// superficie da janela do SDL. Nao depende de driver grafico, entao serve de
+// referencia para comparar imagens e para maquinas sem GPU.
+class SoftwareRendererBackend : public RendererBackend {
+  private:
+    SoftwareRasterizer rasterizer;
+    std::vector<SoftwareTexture> textures; // id = indice + 1
+    RenderQueue renderQueue;
+
+    glm::mat4 frameView = glm::mat4(1.0f);
+    glm::mat4 frameProjection = glm::mat4(1.0f);
+    glm::vec3 defaultLightDirection = glm::vec3(0.0f, 0.0f, -1.0f);
+    glm::vec3 frameLightDirection = glm::vec3(0.0f, 0.0f, -1.0f);
+
+    // Estado usado por draw()/drawSprite(), como o programa ligado no OpenGL
+    Material* currentMaterial = nullptr;
+    glm::mat4 currentModel = glm::mat4(1.0f);
+
+    uint32_t makeDrawState(SoftwareShadingModel model, const SoftwareTexture* texture);
+
+  public:
+    unsigned int loadTexture(const std::string& path, uint8_t filterType = 0) override;
+    void drawSprite(const Sprite& sprite) override;
+    bool init() override;
+    bool init(SDL_Window* window) override;
+    bool initHeadless(int width, int height) override;
+    bool readPixels(std::vector<uint8_t>& rgba, int& width, int& height) override;
+    void present(SDL_Window* window) override;
+    bool initWindowContext() override;
+    void bindCamera(Camera* camera) override;
+    void applyMaterial(Material* material) override;
+    void setBufferDataImpl(const std::string& name, const void* data, size_t size) override;
+    void clear(Camera* camera) override;
+    void draw(const Mesh&) override;
+    void setUniforms(ShaderProgram* shaderProgram) override;
+    unsigned int createCubemapTexture(const std::vector<std::string>& faces) override;
+    std::unique_ptr<ShaderProgram> createShaderProgram() override;
+    std::unique_ptr<ShaderCompiler> createShaderCompiler() override;
+    std::unique_ptr<MeshBuffer> createMeshBuffer() override;
+    void onCameraSet() override;
+    GraphicsAPI getGraphicsAPI() const override;
+    std::string getShaderExtension() const override;
+    unsigned int getRequiredWindowFlags() const override;
+
+    void renderGameObjects(std::vector<GameObject*>* gameObjects,
+                           std::vector<Light>* lights) override;
+    void renderSkybox(const Mesh& mesh, unsigned int shaderProgram,
+                      unsigned int textureID) override;
+
+    // Redimensiona o framebuffer (init(window) usa o tamanho da janela)
+    void resize(int width, int height);
+    // Rasteriza o que estiver pendente; present() ja chama
+    void flush();
+    void setThreadCount(size_t threads) { rasterizer.setThreadCount(threads); }
+
+    // ARGB8888, getStride() pixels por linha
+    const uint32_t* getColorBuffer() const { return rasterizer.getColorBuffer(); }
+    int getWidth() const { return rasterizer.getWidth(); }
+    int getHeight() const { return rasterizer.getHeight(); }
+    int getStride() const { return rasterizer.getStride(); }
+};
+
+#endif // SOFTWARE_RENDERER_BACKEND_HPP
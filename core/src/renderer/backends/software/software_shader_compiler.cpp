@@ -0,0 +1,51 @@
+#define CLASS_NAME "SoftwareShaderCompiler"
+#include "../../../log_macros.hpp"
+
+#include "software_shader_compiler.hpp"
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+
+bool SoftwareShaderCompiler::shadingModelFromPath(const std::string& path,
+                                                  SoftwareShadingModel& model) {
+    auto slash = path.find_last_of("/\\");
+    std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+    std::transform(name.begin(), name.end(), name.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    // "flat_instanced.vxs" usa o mesmo modelo de "flat.vxs"
+    if (name.rfind("flat", 0) == 0) {
+        model = SoftwareShadingModel::FLAT;
+    } else if (name.rfind("unlit", 0) == 0) {
+        model = SoftwareShadingModel::UNLIT;
+    } else if (name.rfind("sprite", 0) == 0) {
+        model = SoftwareShadingModel::SPRITE;
+    } else if (name.rfind("skybox", 0) == 0) {
+        model = SoftwareShadingModel::SKYBOX;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool SoftwareShaderCompiler::compile(const std::string& source, ShaderType type,
+                                     void** outHandle) {
+    if (!std::ifstream(source).good()) {
+        LOG_ERROR("Failed to open shader file: " + source);
+        return false;
+    }
+
+    SoftwareShadingModel model = SoftwareShadingModel::UNLIT;
+    if (!shadingModelFromPath(source, model)) {
+        LOG_WARN("No software shading model for " + source + ", using unlit");
+    }
+
+    *outHandle = new SoftwareShadingModel(model);
+    return true;
+}
+
+void SoftwareShaderCompiler::destroy(void* handle) {
+    delete static_cast<SoftwareShadingModel*>(handle);
+}
+
+bool SoftwareShaderCompiler::isValid(void* handle) { return handle != nullptr; }
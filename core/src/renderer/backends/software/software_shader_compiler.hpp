@@ -0,0 +1,19 @@
+#ifndef SOFTWARE_SHADER_COMPILER_HPP
+#define SOFTWARE_SHADER_COMPILER_HPP
+
+#include "../../../shader_compiler.hpp"
+#include "software_rasterizer.hpp"
+
+// Nao ha codigo de shader para executar: o nome do arquivo escolhe um dos modelos de
+// shading implementados no rasterizador ("flat.pxs" -> FLAT, "unlit.pxs" -> UNLIT).
+// O handle aponta para o SoftwareShadingModel escolhido.
+class SoftwareShaderCompiler : public ShaderCompiler {
+  public:
+    bool compile(const std::string& source, ShaderType type, void** outHandle) override;
+    void destroy(void* handle) override;
+    bool isValid(void* handle) override;
+
+    static bool shadingModelFromPath(const std::string& path, SoftwareShadingModel& model);
+};
+
+#endif // SOFTWARE_SHADER_COMPILER_HPP
@@ -0,0 +1,39 @@
+#define CLASS_NAME "SoftwareShaderProgram"
+#include "../../../log_macros.hpp"
+
+#include "../../../shader_asset.hpp"
+#include "software_shader_program.hpp"
+#include <cstring>
+
+SoftwareShaderProgram::SoftwareShaderProgram(SoftwareRendererBackend* backend) {}
+
+bool SoftwareShaderProgram::attachShader(const ShaderAsset& shader) {
+    auto handle = static_cast<const SoftwareShadingModel*>(shader.getHandle());
+    if (!handle) {
+        LOG_ERROR("Shader not compiled: " + shader.getPath());
+        return false;
+    }
+
+    if (shader.getType() == ShaderType::FRAGMENT) {
+        model = *handle;
+        hasFragment = true;
+    }
+    return true;
+}
+
+bool SoftwareShaderProgram::link() {
+    if (!hasFragment) {
+        LOG_ERROR("Program has no fragment shader");
+        return false;
+    }
+    linked = true;
+    return true;
+}
+
+void SoftwareShaderProgram::setUniformBuffer(const char* name, const void* data, size_t size) {
+    if (std::strcmp(name, "MaterialData") == 0 && size >= sizeof(glm::vec4)) {
+        std::memcpy(&baseColor, data, sizeof(glm::vec4));
+    } else if (std::strcmp(name, "LightData") == 0 && size >= sizeof(glm::vec3)) {
+        std::memcpy(&lightDirection, data, sizeof(glm::vec3));
+    }
+}
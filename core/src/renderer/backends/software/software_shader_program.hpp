@@ -0,0 +1,35 @@
+#ifndef SOFTWARE_SHADER_PROGRAM_HPP
+#define SOFTWARE_SHADER_PROGRAM_HPP
+
+#include "../../../shader_program.hpp"
+#include "software_rasterizer.hpp"
+#include <glm/glm.hpp>
+
+class SoftwareRendererBackend;
+
+// Guarda o modelo de shading do fragment shader e os blocos de uniform que o
+// rasterizador usa (MaterialData e LightData)
+class SoftwareShaderProgram : public ShaderProgram {
+  private:
+    SoftwareShadingModel model = SoftwareShadingModel::UNLIT;
+    glm::vec4 baseColor = glm::vec4(1.0f);
+    glm::vec3 lightDirection = glm::vec3(0.0f, 0.0f, -1.0f);
+    bool hasFragment = false;
+    bool linked = false;
+
+  public:
+    explicit SoftwareShaderProgram(SoftwareRendererBackend* backend);
+
+    bool attachShader(const ShaderAsset& shader) override;
+    bool link() override;
+    void use() override {}
+    void setUniformBuffer(const char* name, const void* data, size_t size) override;
+    void* getHandle() const override { return const_cast<SoftwareShadingModel*>(&model); }
+    bool isValid() const override { return linked; }
+
+    SoftwareShadingModel getShadingModel() const { return model; }
+    const glm::vec4& getBaseColor() const { return baseColor; }
+    const glm::vec3& getLightDirection() const { return lightDirection; }
+};
+
+#endif // SOFTWARE_SHADER_PROGRAM_HPP
@@ -0,0 +1,72 @@
+#define CLASS_NAME "VulkanGpuProfiler"
+#include "../../../log_macros.hpp"
+
+#include "vulkan_gpu_profiler.hpp"
+#include <vector>
+
+bool VulkanGpuProfiler::init(VkDevice device, VkPhysicalDevice physicalDevice,
+                             uint32_t queueFamily) {
+    destroy();
+
+    uint32_t familyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> families(familyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount, families.data());
+
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+    uint32_t validBits = queueFamily < familyCount ? families[queueFamily].timestampValidBits : 0;
+    if (validBits == 0 || properties.limits.timestampPeriod <= 0.0f) {
+        LOG_WARN("Graphics queue has no timestamps, GPU timings disabled");
+        return false;
+    }
+
+    VkQueryPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    poolInfo.queryCount = FRAME_LATENCY * QUERIES_PER_SLOT;
+    if (vkCreateQueryPool(device, &poolInfo, nullptr, &queryPool) != VK_SUCCESS) {
+        LOG_ERROR("Failed to create timestamp query pool");
+        return false;
+    }
+
+    this->device = device;
+    nsPerTick = properties.limits.timestampPeriod;
+    validMask = validBits >= 64 ? ~0ull : (1ull << validBits) - 1;
+    supported = true;
+    return true;
+}
+
+void VulkanGpuProfiler::destroy() {
+    if (queryPool) {
+        vkDestroyQueryPool(device, queryPool, nullptr);
+        queryPool = VK_NULL_HANDLE;
+    }
+    supported = false;
+}
+
+void VulkanGpuProfiler::resetQueries(uint32_t slot) {
+    vkCmdResetQueryPool(commandBuffer, queryPool, slot * QUERIES_PER_SLOT, QUERIES_PER_SLOT);
+}
+
+void VulkanGpuProfiler::writeTimestamp(uint32_t slot, uint32_t query) {
+    // Inicio no topo do pipe, fim no fundo: o intervalo cobre todo o trabalho entre os dois
+    VkPipelineStageFlagBits stage = query % 2 == 0 ? VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT
+                                                   : VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+    vkCmdWriteTimestamp(commandBuffer, stage, queryPool, slot * QUERIES_PER_SLOT + query);
+}
+
+bool VulkanGpuProfiler::readTimestamp(uint32_t slot, uint32_t query, uint64_t& ns) {
+    // Sem VK_QUERY_RESULT_WAIT_BIT: VK_NOT_READY em vez de esperar a GPU
+    uint64_t ticks = 0;
+    VkResult result =
+        vkGetQueryPoolResults(device, queryPool, slot * QUERIES_PER_SLOT + query, 1,
+                              sizeof(ticks), &ticks, sizeof(ticks), VK_QUERY_RESULT_64_BIT);
+    if (result != VK_SUCCESS) {
+        return false;
+    }
+
+    ns = static_cast<uint64_t>((ticks & validMask) * nsPerTick);
+    return true;
+}
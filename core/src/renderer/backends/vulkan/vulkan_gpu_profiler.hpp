@@ -0,0 +1,31 @@
+#ifndef VULKAN_GPU_PROFILER_HPP
+#define VULKAN_GPU_PROFILER_HPP
+
+#include "../../gpu_profiler.hpp"
+#include <vulkan/vulkan.h>
+
+// Timestamps num VkQueryPool com um trecho por slot. O reset do trecho e gravado no
+// command buffer do frame, fora do render pass (beginFrame antes de vkCmdBeginRenderPass).
+class VulkanGpuProfiler : public GpuProfiler {
+  private:
+    VkDevice device = VK_NULL_HANDLE;
+    VkQueryPool queryPool = VK_NULL_HANDLE;
+    VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+    double nsPerTick = 1.0;
+    uint64_t validMask = ~0ull;
+
+  protected:
+    void resetQueries(uint32_t slot) override;
+    void writeTimestamp(uint32_t slot, uint32_t query) override;
+    bool readTimestamp(uint32_t slot, uint32_t query, uint64_t& ns) override;
+
+  public:
+    // Sem timestamps na fila de graficos o profiler fica desligado
+    bool init(VkDevice device, VkPhysicalDevice physicalDevice, uint32_t queueFamily);
+    // Antes de vkDestroyDevice
+    void destroy();
+    // Command buffer em gravacao do frame atual
+    void setCommandBuffer(VkCommandBuffer buffer) { commandBuffer = buffer; }
+};
+
+#endif // VULKAN_GPU_PROFILER_HPP
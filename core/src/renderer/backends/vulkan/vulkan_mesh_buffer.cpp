@@ -3,6 +3,7 @@
 #include "renderer/backends/vulkan/vulkan_renderer_backend.hpp"
 #include <cstring>
 #include "log_macros.hpp"
+#include "engine_stats.hpp"
 
 VulkanMeshBuffer::~VulkanMeshBuffer() {
     destroy();
@@ -78,7 +79,8 @@ bool VulkanMeshBuffer::createBuffers(const std::vector<float>& vertices, const s
         memcpy(data, normals.data(), normalBufferSize);
         vkUnmapMemory(backend->getDevice(), normalBufferMemory);
     }
-    
+
+    EngineStats::current().bytesUploaded += vertexBufferSize + normalBufferSize;
     return true;
 }
 
@@ -2,6 +2,8 @@
 #include "shader_compiler_factory.hpp"
 #define CLASS_NAME "VulkanRendererBackend"
 #include "../../../log_macros.hpp"
+#include "../../../engine_stats.hpp"
+#include "../../../trace.hpp"
 
 #include "shader_program_factory.hpp"
 #include <SDL_video.h>
@@ -39,8 +41,15 @@ std::unique_ptr<ShaderCompiler> VulkanRendererBackend::createShaderCompiler() {
 }
 
 VulkanRendererBackend::~VulkanRendererBackend() {
+    // Espera pipelines em construcao antes de destruir o device
+    Yume::JobSystem::shared().wait(pipelineBuilds);
+
     if (device) {
         vkDeviceWaitIdle(device);
+
+        gpuProfiler.destroy();
+
+        if (pipelineCache) vkDestroyPipelineCache(device, pipelineCache, nullptr);
         
         if (inFlightFence) vkDestroyFence(device, inFlightFence, nullptr);
         if (renderFinishedSemaphore) vkDestroySemaphore(device, renderFinishedSemaphore, nullptr);
@@ -57,17 +66,25 @@ VulkanRendererBackend::~VulkanRendererBackend() {
         for (auto imageView : swapchainImageViews) {
             vkDestroyImageView(device, imageView, nullptr);
         }
+        if (offscreenImage) vkDestroyImage(device, offscreenImage, nullptr);
+        if (offscreenImageMemory) vkFreeMemory(device, offscreenImageMemory, nullptr);
+        if (readbackBuffer) vkDestroyBuffer(device, readbackBuffer, nullptr);
+        if (readbackBufferMemory) vkFreeMemory(device, readbackBufferMemory, nullptr);
         
         if (depthImageView) vkDestroyImageView(device, depthImageView, nullptr);
         if (depthImage) vkDestroyImage(device, depthImage, nullptr);
         if (depthImageMemory) vkFreeMemory(device, depthImageMemory, nullptr);
         
+        if (uniformMapped) vkUnmapMemory(device, uniformBufferMemory);
         if (uniformBuffer) vkDestroyBuffer(device, uniformBuffer, nullptr);
         if (uniformBufferMemory) vkFreeMemory(device, uniformBufferMemory, nullptr);
         if (materialBuffer) vkDestroyBuffer(device, materialBuffer, nullptr);
         if (materialBufferMemory) vkFreeMemory(device, materialBufferMemory, nullptr);
         if (lightDataBuffer) vkDestroyBuffer(device, lightDataBuffer, nullptr);
         if (lightDataBufferMemory) vkFreeMemory(device, lightDataBufferMemory, nullptr);
+        if (instanceMapped) vkUnmapMemory(device, instanceBufferMemory);
+        if (instanceBuffer) vkDestroyBuffer(device, instanceBuffer, nullptr);
+        if (instanceBufferMemory) vkFreeMemory(device, instanceBufferMemory, nullptr);
         
         if (descriptorPool) vkDestroyDescriptorPool(device, descriptorPool, nullptr);
         if (descriptorSetLayout) vkDestroyDescriptorSetLayout(device, descriptorSetLayout, nullptr);
@@ -93,11 +110,26 @@ bool VulkanRendererBackend::initWindowContext() {
     return createInstance();
 }
 
+bool VulkanRendererBackend::initHeadless(int width, int height) {
+    headless = true;
+    if (!createInstance()) {
+        LOG_ERROR("Failed to create Vulkan instance");
+        return false;
+    }
+    swapchainExtent = {static_cast<uint32_t>(width), static_cast<uint32_t>(height)};
+    return init();
+}
+
 bool VulkanRendererBackend::init() {
     printf("[Vulkan] init - starting full initialization\n");
     if (!pickPhysicalDevice()) { printf("Failed to pick physical device\n"); return false; }
     if (!createLogicalDevice()) { printf("Failed to create logical device\n"); return false; }
-    if (!createSwapchain()) { printf("Failed to create swapchain\n"); return false; }
+    if (headless) {
+        if (!createOffscreenTarget(swapchainExtent.width, swapchainExtent.height)) {
+            printf("Failed to create offscreen target\n");
+            return false;
+        }
+    } else if (!createSwapchain()) { printf("Failed to create swapchain\n"); return false; }
     if (!createImageViews()) { printf("Failed to create image views\n"); return false; }
     if (!createRenderPass()) { printf("Failed to create render pass\n"); return false; }
     if (!createDepthResources()) { printf("Failed to create depth resources\n"); return false; }
@@ -107,9 +139,14 @@ bool VulkanRendererBackend::init() {
     if (!createUniformBuffer()) { printf("Failed to create uniform buffer\n"); return false; }
     if (!createMaterialBuffer()) { printf("Failed to create material buffer\n"); return false; }
     if (!createLightDataBuffer()) { printf("Failed to create light data buffer\n"); return false; }
+    if (!createInstanceBuffer()) { printf("Failed to create instance buffer\n"); return false; }
     if (!createDescriptorPool()) { printf("Failed to create descriptor pool\n"); return false; }
     if (!createCommandBuffers()) { printf("Failed to create command buffers\n"); return false; }
     if (!createSyncObjects()) { printf("Failed to create sync objects\n"); return false; }
+    if (!createPipelineCache()) { printf("Failed to create pipeline cache\n"); return false; }
+    gpuProfiler.init(device, physicalDevice, graphicsQueueFamily);
+
+    printf("[Vulkan] Pipeline workers: %zu\n", Yume::JobSystem::shared().getWorkerCount());
     
     printf("[Vulkan] Initialization complete!\n");
     return true;
@@ -129,11 +166,14 @@ bool VulkanRendererBackend::createInstance() {
     createInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
     createInfo.pApplicationInfo = &appInfo;
     
-    // SDL extensions
+    // SDL extensions (nenhuma no modo headless)
     unsigned int extensionCount = 0;
-    SDL_Vulkan_GetInstanceExtensions(nullptr, &extensionCount, nullptr);
-    std::vector<const char*> extensions(extensionCount);
-    SDL_Vulkan_GetInstanceExtensions(nullptr, &extensionCount, extensions.data());
+    std::vector<const char*> extensions;
+    if (!headless) {
+        SDL_Vulkan_GetInstanceExtensions(nullptr, &extensionCount, nullptr);
+        extensions.resize(extensionCount);
+        SDL_Vulkan_GetInstanceExtensions(nullptr, &extensionCount, extensions.data());
+    }
     
     printf("[Vulkan] Required extensions: %u\n", extensionCount);
     
@@ -203,7 +243,7 @@ bool VulkanRendererBackend::createLogicalDevice() {
     createInfo.pEnabledFeatures = &deviceFeatures;
     
     const char* deviceExtensions[] = { VK_KHR_SWAPCHAIN_EXTENSION_NAME };
-    createInfo.enabledExtensionCount = 1;
+    createInfo.enabledExtensionCount = headless ? 0 : 1;
     createInfo.ppEnabledExtensionNames = deviceExtensions;
     
     VkResult result = vkCreateDevice(physicalDevice, &createInfo, nullptr, &device);
@@ -273,6 +313,162 @@ bool VulkanRendererBackend::createSwapchain() {
     return true;
 }
 
+bool VulkanRendererBackend::createOffscreenTarget(uint32_t width, uint32_t height) {
+    swapchainFormat = VK_FORMAT_R8G8B8A8_UNORM;
+    swapchainExtent = {width, height};
+
+    VkImageCreateInfo imageInfo{};
+    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.extent.width = width;
+    imageInfo.extent.height = height;
+    imageInfo.extent.depth = 1;
+    imageInfo.mipLevels = 1;
+    imageInfo.arrayLayers = 1;
+    imageInfo.format = swapchainFormat;
+    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    imageInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    if (vkCreateImage(device, &imageInfo, nullptr, &offscreenImage) != VK_SUCCESS) {
+        return false;
+    }
+
+    VkMemoryRequirements memRequirements;
+    vkGetImageMemoryRequirements(device, offscreenImage, &memRequirements);
+
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = memRequirements.size;
+    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+    if (vkAllocateMemory(device, &allocInfo, nullptr, &offscreenImageMemory) != VK_SUCCESS) {
+        return false;
+    }
+    vkBindImageMemory(device, offscreenImage, offscreenImageMemory, 0);
+
+    // O resto do init trata a imagem como uma swapchain de uma imagem so
+    swapchainImages = {offscreenImage};
+    return createReadbackBuffer();
+}
+
+bool VulkanRendererBackend::createReadbackBuffer() {
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = VkDeviceSize(swapchainExtent.width) * swapchainExtent.height * 4;
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    if (vkCreateBuffer(device, &bufferInfo, nullptr, &readbackBuffer) != VK_SUCCESS) {
+        return false;
+    }
+
+    VkMemoryRequirements memRequirements;
+    vkGetBufferMemoryRequirements(device, readbackBuffer, &memRequirements);
+
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = memRequirements.size;
+    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+    if (vkAllocateMemory(device, &allocInfo, nullptr, &readbackBufferMemory) != VK_SUCCESS) {
+        return false;
+    }
+    return vkBindBufferMemory(device, readbackBuffer, readbackBufferMemory, 0) == VK_SUCCESS;
+}
+
+bool VulkanRendererBackend::readPixels(std::vector<uint8_t>& rgba, int& width, int& height) {
+    if (!headless || !readbackBuffer) {
+        return false;
+    }
+
+    // Espera o ultimo frame submetido em present()
+    vkWaitForFences(device, 1, &inFlightFence, VK_TRUE, UINT64_MAX);
+
+    VkCommandBufferAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocInfo.commandPool = commandPool;
+    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocInfo.commandBufferCount = 1;
+
+    VkCommandBuffer commandBuffer;
+    if (vkAllocateCommandBuffers(device, &allocInfo, &commandBuffer) != VK_SUCCESS) {
+        return false;
+    }
+
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(commandBuffer, &beginInfo);
+
+    // O render pass deixa a imagem em TRANSFER_SRC; falta tornar as escritas visiveis
+    VkImageMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = offscreenImage;
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.levelCount = 1;
+    barrier.subresourceRange.layerCount = 1;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+    VkBufferImageCopy region{};
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.layerCount = 1;
+    region.imageExtent = {swapchainExtent.width, swapchainExtent.height, 1};
+    vkCmdCopyImageToBuffer(commandBuffer, offscreenImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                           readbackBuffer, 1, &region);
+
+    VkBufferMemoryBarrier hostBarrier{};
+    hostBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    hostBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    hostBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    hostBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    hostBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    hostBarrier.buffer = readbackBuffer;
+    hostBarrier.size = VK_WHOLE_SIZE;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT,
+                         0, 0, nullptr, 1, &hostBarrier, 0, nullptr);
+
+    vkEndCommandBuffer(commandBuffer);
+
+    VkSubmitInfo submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &commandBuffer;
+    bool submitted = vkQueueSubmit(graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE) == VK_SUCCESS;
+    if (submitted) {
+        vkQueueWaitIdle(graphicsQueue);
+    }
+    vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
+    if (!submitted) {
+        LOG_ERROR("Failed to submit readback");
+        return false;
+    }
+
+    width = static_cast<int>(swapchainExtent.width);
+    height = static_cast<int>(swapchainExtent.height);
+    size_t size = static_cast<size_t>(width) * height * 4;
+    rgba.resize(size);
+
+    void* mapped = nullptr;
+    if (vkMapMemory(device, readbackBufferMemory, 0, size, 0, &mapped) != VK_SUCCESS) {
+        return false;
+    }
+    // R8G8B8A8 com linhas de cima para baixo, ja no formato pedido
+    memcpy(rgba.data(), mapped, size);
+    vkUnmapMemory(device, readbackBufferMemory);
+    return true;
+}
+
 bool VulkanRendererBackend::createImageViews() {
     swapchainImageViews.resize(swapchainImages.size());
     
@@ -309,7 +505,9 @@ bool VulkanRendererBackend::createRenderPass() {
     colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
     colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
     colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    colorAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    // Sem swapchain a imagem termina pronta para ser copiada em readPixels
+    colorAttachment.finalLayout = headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+                                           : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
     
     VkAttachmentDescription depthAttachment{};
     depthAttachment.format = VK_FORMAT_D32_SFLOAT;
@@ -360,7 +558,7 @@ bool VulkanRendererBackend::createDescriptorSetLayout() {
     VkDescriptorSetLayoutBinding bindings[3] = {};
     
     bindings[0].binding = 0;
-    bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     bindings[0].descriptorCount = 1;
     bindings[0].stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
     
@@ -473,7 +671,14 @@ bool VulkanRendererBackend::createUniformBuffer() {
         return false;
     }
 
-    VkDeviceSize bufferSize = 4 * sizeof(glm::mat4);
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+    VkDeviceSize alignment = properties.limits.minUniformBufferOffsetAlignment;
+    uniformStride = 4 * sizeof(glm::mat4);
+    if (alignment > 0) {
+        uniformStride = (uniformStride + alignment - 1) / alignment * alignment;
+    }
+    VkDeviceSize bufferSize = uniformStride * uniformCapacity;
     
     VkBufferCreateInfo bufferInfo{};
     bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
@@ -499,7 +704,7 @@ bool VulkanRendererBackend::createUniformBuffer() {
     }
     
     vkBindBufferMemory(device, uniformBuffer, uniformBufferMemory, 0);
-    return true;
+    return vkMapMemory(device, uniformBufferMemory, 0, bufferSize, 0, &uniformMapped) == VK_SUCCESS;
 }
 
 bool VulkanRendererBackend::createMaterialBuffer() {
@@ -562,15 +767,47 @@ bool VulkanRendererBackend::createLightDataBuffer() {
     return true;
 }
 
+bool VulkanRendererBackend::createInstanceBuffer() {
+    VkDeviceSize bufferSize = instanceCapacity * sizeof(glm::mat4);
+
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = bufferSize;
+    bufferInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    if (vkCreateBuffer(device, &bufferInfo, nullptr, &instanceBuffer) != VK_SUCCESS) {
+        return false;
+    }
+
+    VkMemoryRequirements memRequirements;
+    vkGetBufferMemoryRequirements(device, instanceBuffer, &memRequirements);
+
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = memRequirements.size;
+    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+    if (vkAllocateMemory(device, &allocInfo, nullptr, &instanceBufferMemory) != VK_SUCCESS) {
+        return false;
+    }
+
+    vkBindBufferMemory(device, instanceBuffer, instanceBufferMemory, 0);
+    return vkMapMemory(device, instanceBufferMemory, 0, bufferSize, 0, &instanceMapped) == VK_SUCCESS;
+}
+
 bool VulkanRendererBackend::createDescriptorPool() {
-    VkDescriptorPoolSize poolSize{};
-    poolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-    poolSize.descriptorCount = 3;
+    VkDescriptorPoolSize poolSizes[2] = {};
+    poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    poolSizes[0].descriptorCount = 1;
+    poolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    poolSizes[1].descriptorCount = 2;
     
     VkDescriptorPoolCreateInfo poolInfo{};
     poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-    poolInfo.poolSizeCount = 1;
-    poolInfo.pPoolSizes = &poolSize;
+    poolInfo.poolSizeCount = 2;
+    poolInfo.pPoolSizes = poolSizes;
     poolInfo.maxSets = 1;
     
     if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS) {
@@ -606,7 +843,7 @@ bool VulkanRendererBackend::createDescriptorPool() {
     descriptorWrites[0].dstSet = descriptorSets[0];
     descriptorWrites[0].dstBinding = 0;
     descriptorWrites[0].dstArrayElement = 0;
-    descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     descriptorWrites[0].descriptorCount = 1;
     descriptorWrites[0].pBufferInfo = &bufferInfos[0];
     
@@ -656,6 +893,13 @@ bool VulkanRendererBackend::createSyncObjects() {
            vkCreateFence(device, &fenceInfo, nullptr, &inFlightFence) == VK_SUCCESS;
 }
 
+bool VulkanRendererBackend::createPipelineCache() {
+    // Cache compartilhado entre as worker threads (sincronizado internamente pelo driver)
+    VkPipelineCacheCreateInfo cacheInfo{};
+    cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    return vkCreatePipelineCache(device, &cacheInfo, nullptr, &pipelineCache) == VK_SUCCESS;
+}
+
 uint32_t VulkanRendererBackend::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) {
     VkPhysicalDeviceMemoryProperties memProperties;
     vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
@@ -668,6 +912,20 @@ uint32_t VulkanRendererBackend::findMemoryType(uint32_t typeFilter, VkMemoryProp
     return 0;
 }
 
+void VulkanRendererBackend::bindCamera(Camera* camera) {
+    if (!camera) {
+        LOG_ERROR("Camera is null");
+        return;
+    }
+    mainCamera = camera;
+
+    // Copiadas para cada slot de uniforms em bindObjectUniforms
+    frameView = camera->getViewMatrix();
+    frameProjection = camera->getProjectionMatrix();
+    // fix temporario pra deixar eixo y igual opengl
+    frameProjection[1][1] *= -1;
+}
+
 void VulkanRendererBackend::onCameraSet() {
     // Atualizar clear color se necessário
 }
@@ -675,14 +933,28 @@ void VulkanRendererBackend::onCameraSet() {
 void VulkanRendererBackend::clear(Camera* camera) {
     vkWaitForFences(device, 1, &inFlightFence, VK_TRUE, UINT64_MAX);
     vkResetFences(device, 1, &inFlightFence);
-    
-    vkAcquireNextImageKHR(device, swapchain, UINT64_MAX, imageAvailableSemaphore, VK_NULL_HANDLE, &currentImageIndex);
+
+    // A GPU terminou o frame anterior; os buffers de instancias e de uniforms podem
+    // ser reescritos
+    instanceWriteIndex = 0;
+    uniformWriteIndex = 0;
+    boundLayout = VK_NULL_HANDLE;
+    
+    if (headless) {
+        currentImageIndex = 0;
+    } else {
+        vkAcquireNextImageKHR(device, swapchain, UINT64_MAX, imageAvailableSemaphore, VK_NULL_HANDLE, &currentImageIndex);
+    }
     
     vkResetCommandBuffer(commandBuffers[currentImageIndex], 0);
     
     VkCommandBufferBeginInfo beginInfo{};
     beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
     vkBeginCommandBuffer(commandBuffers[currentImageIndex], &beginInfo);
+
+    gpuProfiler.setCommandBuffer(commandBuffers[currentImageIndex]);
+    gpuProfiler.beginFrame();
+    gpuProfiler.beginPass(GpuPass::CLEAR);
     
     VkRenderPassBeginInfo renderPassInfo{};
     renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
@@ -704,6 +976,10 @@ void VulkanRendererBackend::clear(Camera* camera) {
     renderPassInfo.pClearValues = clearValues.data();
     
     vkCmdBeginRenderPass(commandBuffers[currentImageIndex], &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+    gpuProfiler.endPass(GpuPass::CLEAR);
+
+    // Ainda sem sprites e skybox no Vulkan: todos os draws ate o present sao opacos
+    gpuProfiler.beginPass(GpuPass::OPAQUE);
 }
 
 void VulkanRendererBackend::draw(const Mesh& mesh) {
@@ -711,10 +987,108 @@ void VulkanRendererBackend::draw(const Mesh& mesh) {
     VkBuffer vertexBuffers[] = {vkMeshBuffer->getVertexBuffer(), vkMeshBuffer->getNormalBuffer()};
     VkDeviceSize offsets[] = {0, 0};
     vkCmdBindVertexBuffers(commandBuffers[currentImageIndex], 0, 2, vertexBuffers, offsets);
-    vkCmdDraw(commandBuffers[currentImageIndex], mesh.getVertices().size() / 3, 1, 0, 0);
+    uint32_t vertexCount = mesh.getVertices().size() / 3;
+    vkCmdDraw(commandBuffers[currentImageIndex], vertexCount, 1, 0, 0);
+
+    FrameStats& stats = EngineStats::current();
+    stats.vertexArrayBinds++;
+    stats.drawCalls++;
+    stats.triangles += vertexCount / 3;
+}
+
+bool VulkanRendererBackend::drawInstanced(const Mesh& mesh, const glm::mat4* models, uint32_t count) {
+    if (!instanceMapped || count == 0 || instanceWriteIndex + count > instanceCapacity) {
+        return false;
+    }
+
+    memcpy(static_cast<glm::mat4*>(instanceMapped) + instanceWriteIndex, models, count * sizeof(glm::mat4));
+
+    auto* vkMeshBuffer = static_cast<VulkanMeshBuffer*>(mesh.getMeshBuffer());
+    VkBuffer vertexBuffers[] = {vkMeshBuffer->getVertexBuffer(), vkMeshBuffer->getNormalBuffer(), instanceBuffer};
+    VkDeviceSize offsets[] = {0, 0, 0};
+    vkCmdBindVertexBuffers(commandBuffers[currentImageIndex], 0, 3, vertexBuffers, offsets);
+    uint32_t vertexCount = mesh.getVertices().size() / 3;
+    vkCmdDraw(commandBuffers[currentImageIndex], vertexCount, count, 0, instanceWriteIndex);
+
+    FrameStats& stats = EngineStats::current();
+    stats.bytesUploaded += count * sizeof(glm::mat4);
+    stats.vertexArrayBinds++;
+    stats.drawCalls++;
+    stats.triangles += static_cast<uint64_t>(vertexCount / 3) * count;
+
+    instanceWriteIndex += count;
+    return true;
+}
+
+void VulkanRendererBackend::renderGameObjects(std::vector<GameObject*>* gameObjects,
+                                              std::vector<Light>* lights) {
+    TRACE_ZONE("VulkanRendererBackend::renderGameObjects");
+    renderQueue.build(*gameObjects, mainCamera);
+
+    ShaderProgram* lastProgram = nullptr;
+    for (size_t i = 0; i < renderQueue.size();) {
+        const RenderItem& item = renderQueue[i];
+        // Sem texturas no Vulkan ainda, entao sprites nao tem como ser desenhados
+        if (!item.mesh) {
+            if (!spritesReported) {
+                LOG_ERROR("Sprites are not supported by the Vulkan backend yet, skipping them");
+                spritesReported = true;
+            }
+            i++;
+            continue;
+        }
+
+        // Runs de mesmo mesh e material viram um draw instanciado; sem a variante cada
+        // objeto recebe o proprio slot de uniforms
+        size_t runEnd = i + 1;
+        ShaderProgram* program = item.material->getInstancedShaderProgram();
+        if (program) {
+            while (runEnd < renderQueue.size() && renderQueue[runEnd].mesh == item.mesh &&
+                   renderQueue[runEnd].material == item.material) {
+                runEnd++;
+            }
+        } else {
+            program = item.material->getShaderProgram();
+        }
+
+        if (program != lastProgram) {
+            setUniforms(program);
+            lastProgram = program;
+        }
+        // Pipeline invalido: nada foi ligado para desenhar o run
+        if (boundLayout == VK_NULL_HANDLE) {
+            i = runEnd;
+            continue;
+        }
+
+        bool drawn = false;
+        if (program->isInstanced()) {
+            runModels.clear();
+            for (size_t j = i; j < runEnd; j++) {
+                runModels.push_back(renderQueue[j].model);
+            }
+            drawn = drawInstanced(*item.mesh, runModels.data(),
+                                  static_cast<uint32_t>(runModels.size()));
+        }
+        if (!drawn) {
+            // Sem variante instanciada ou sem espaco no buffer de instancias
+            if (program->isInstanced()) {
+                program = item.material->getShaderProgram();
+                setUniforms(program);
+                lastProgram = program;
+            }
+            for (size_t j = i; j < runEnd; j++) {
+                if (bindObjectUniforms(renderQueue[j].model)) {
+                    draw(*renderQueue[j].mesh);
+                }
+            }
+        }
+        i = runEnd;
+    }
 }
 
 void VulkanRendererBackend::setUniforms(ShaderProgram* shaderProgram) {
+    boundLayout = VK_NULL_HANDLE;
     if (!mainCamera) return;
     
     // Bind pipeline do material atual
@@ -723,49 +1097,48 @@ void VulkanRendererBackend::setUniforms(ShaderProgram* shaderProgram) {
         VkPipeline pipeline = static_cast<VkPipeline>(program->getHandle());
         vkCmdBindPipeline(commandBuffers[currentImageIndex], VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
         
-        // Bind descriptor sets usando o pipeline layout do material
+        // Descriptor sets sao ligados por slot em bindObjectUniforms, com este layout
         auto* vkProgram = static_cast<VulkanShaderProgram*>(program);
-        VkPipelineLayout layout = vkProgram->getPipelineLayout();
-        vkCmdBindDescriptorSets(commandBuffers[currentImageIndex], VK_PIPELINE_BIND_POINT_GRAPHICS, 
-                               layout, 0, 1, &descriptorSets[0], 0, nullptr);
-    }
-    
-    glm::mat4 model = glm::rotate(glm::mat4(1.0f), 0.0f, glm::vec3(1.0f, 0.0f, 1.0f));
-    model = glm::rotate(model, SDL_GetTicks() / 1000.0f, glm::vec3(0.5f, 1.0f, 0.0f));
-    
-    auto& camPos = mainCamera->getPosition();
-    glm::mat4 view = glm::lookAt(
-        {camPos.x, camPos.y, camPos.z},
-        glm::vec3(0.0f, 0.0f, 0.0f),
-        glm::vec3(0.0f, 1.0f, 0.0f)
-    );
-    
-    glm::mat4 projection = glm::perspective(
-        glm::radians(mainCamera->getFov()), 
-        mainCamera->getAspectRatio(), 
-        mainCamera->getNearDistance(), 
-        mainCamera->getFarDistance()
-    );
-    // fix temporario pra deixar eixo y igual opengl
-    projection[1][1] *= -1;
+        boundLayout = vkProgram->getPipelineLayout();
+        EngineStats::current().programBinds++;
+        EngineStats::current().textureBinds++;
+    }
     
+    // A variante instanciada le o model do buffer de instancias e ignora o do slot
+    bindObjectUniforms(glm::mat4(1.0f));
+}
+
+bool VulkanRendererBackend::bindObjectUniforms(const glm::mat4& model) {
+    if (boundLayout == VK_NULL_HANDLE || !uniformMapped) {
+        return false;
+    }
+    if (uniformWriteIndex >= uniformCapacity) {
+        if (!uniformOverflowReported) {
+            LOG_ERROR("Uniform buffer full (" + std::to_string(uniformCapacity) +
+                      " draws), skipping the remaining draws of the frame");
+            uniformOverflowReported = true;
+        }
+        return false;
+    }
+
     struct UniformBufferObject {
         glm::mat4 model;
         glm::mat4 view;
         glm::mat4 projection;
-    } ubo;
-    
-    ubo.model = model;
-    ubo.view = view;
-    ubo.projection = projection;
-    
-    void* data;
-    vkMapMemory(device, uniformBufferMemory, 0, sizeof(ubo), 0, &data);
-    memcpy(data, &ubo, sizeof(ubo));
-    vkUnmapMemory(device, uniformBufferMemory);
+    } ubo{model, frameView, frameProjection};
+
+    VkDeviceSize offset = uniformStride * uniformWriteIndex++;
+    memcpy(static_cast<uint8_t*>(uniformMapped) + offset, &ubo, sizeof(ubo));
+
+    uint32_t dynamicOffset = static_cast<uint32_t>(offset);
+    vkCmdBindDescriptorSets(commandBuffers[currentImageIndex], VK_PIPELINE_BIND_POINT_GRAPHICS,
+                            boundLayout, 0, 1, &descriptorSets[0], 1, &dynamicOffset);
+    EngineStats::current().bytesUploaded += sizeof(ubo);
+    return true;
 }
 
 unsigned int VulkanRendererBackend::createCubemapTexture(const std::vector<std::string>& faces) {
+    TRACE_ZONE("VulkanRendererBackend::createCubemapTexture");
     return 0;
 }
 
@@ -774,6 +1147,7 @@ void VulkanRendererBackend::renderSkybox(const Mesh& mesh, unsigned int shaderPr
 }
 
 void VulkanRendererBackend::present(SDL_Window* window) {
+    gpuProfiler.endFrame();
     vkCmdEndRenderPass(commandBuffers[currentImageIndex]);
     
     if (vkEndCommandBuffer(commandBuffers[currentImageIndex]) != VK_SUCCESS) {
@@ -786,20 +1160,24 @@ void VulkanRendererBackend::present(SDL_Window* window) {
     
     VkSemaphore waitSemaphores[] = {imageAvailableSemaphore};
     VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-    submitInfo.waitSemaphoreCount = 1;
+    submitInfo.waitSemaphoreCount = headless ? 0 : 1;
     submitInfo.pWaitSemaphores = waitSemaphores;
     submitInfo.pWaitDstStageMask = waitStages;
     submitInfo.commandBufferCount = 1;
     submitInfo.pCommandBuffers = &commandBuffers[currentImageIndex];
     
     VkSemaphore signalSemaphores[] = {renderFinishedSemaphore};
-    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.signalSemaphoreCount = headless ? 0 : 1;
     submitInfo.pSignalSemaphores = signalSemaphores;
     
     if (vkQueueSubmit(graphicsQueue, 1, &submitInfo, inFlightFence) != VK_SUCCESS) {
         printf("Failed to submit draw command buffer\n");
         return;
     }
+
+    if (headless) {
+        return;
+    }
     
     VkPresentInfoKHR presentInfo{};
     presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
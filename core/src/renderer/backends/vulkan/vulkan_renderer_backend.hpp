@@ -2,7 +2,11 @@
 #define VULKAN_RENDERER_BACKEND_HPP
 
 #include <vulkan/vulkan.h>
+#include "../../render_queue.hpp"
 #include "../../renderer_backend.hpp"
+#include "../../../job_system.hpp"
+#include "vulkan_gpu_profiler.hpp"
+#include <memory>
 #include <vector>
 
 struct SDL_Window;
@@ -20,22 +24,58 @@ private:
     VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
     VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
     std::vector<VkDescriptorSet> descriptorSets;
+    VkPipelineCache pipelineCache = VK_NULL_HANDLE;
+    VulkanGpuProfiler gpuProfiler;
+
+    // vkCreateGraphicsPipelines roda no JobSystem durante o carregamento da cena;
+    // conta os pipelines ainda em construcao
+    Yume::JobCounter pipelineBuilds;
     
     std::vector<VkImage> swapchainImages;
     std::vector<VkImageView> swapchainImageViews;
     std::vector<VkFramebuffer> framebuffers;
     std::vector<VkCommandBuffer> commandBuffers;
     
+    // Modo headless: uma imagem propria no lugar da swapchain, sem surface nem present
+    bool headless = false;
+    VkImage offscreenImage = VK_NULL_HANDLE;
+    VkDeviceMemory offscreenImageMemory = VK_NULL_HANDLE;
+    VkBuffer readbackBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory readbackBufferMemory = VK_NULL_HANDLE;
+
     VkImage depthImage = VK_NULL_HANDLE;
     VkDeviceMemory depthImageMemory = VK_NULL_HANDLE;
     VkImageView depthImageView = VK_NULL_HANDLE;
     
+    // Um slot (model, view, projection) por draw, escolhido por offset dinamico no
+    // descriptor set; mapeado permanentemente e reiniciado a cada frame em clear()
     VkBuffer uniformBuffer = VK_NULL_HANDLE;
     VkDeviceMemory uniformBufferMemory = VK_NULL_HANDLE;
+    void* uniformMapped = nullptr;
+    VkDeviceSize uniformStride = 0;
+    uint32_t uniformCapacity = 4096;
+    uint32_t uniformWriteIndex = 0;
+    // Layout do pipeline ligado por setUniforms; slots novos sao ligados com ele
+    VkPipelineLayout boundLayout = VK_NULL_HANDLE;
+    glm::mat4 frameView = glm::mat4(1.0f);
+    glm::mat4 frameProjection = glm::mat4(1.0f);
+    bool uniformOverflowReported = false;
+    bool spritesReported = false;
     VkBuffer materialBuffer = VK_NULL_HANDLE;
     VkDeviceMemory materialBufferMemory = VK_NULL_HANDLE;
     VkBuffer lightDataBuffer = VK_NULL_HANDLE;
     VkDeviceMemory lightDataBufferMemory = VK_NULL_HANDLE;
+
+    // Matrizes por instancia, mapeado permanentemente; reiniciado a cada frame em clear()
+    VkBuffer instanceBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory instanceBufferMemory = VK_NULL_HANDLE;
+    void* instanceMapped = nullptr;
+    uint32_t instanceCapacity = 16384;
+    uint32_t instanceWriteIndex = 0;
+
+    RenderQueue renderQueue;
+    // Matrizes de um run da fila antes de irem para o buffer de instancias
+    std::vector<glm::mat4> runModels;
     
     VkSemaphore imageAvailableSemaphore = VK_NULL_HANDLE;
     VkSemaphore renderFinishedSemaphore = VK_NULL_HANDLE;
@@ -52,6 +92,8 @@ private:
     bool pickPhysicalDevice();
     bool createLogicalDevice();
     bool createSwapchain();
+    bool createOffscreenTarget(uint32_t width, uint32_t height);
+    bool createReadbackBuffer();
     bool createImageViews();
     bool createRenderPass();
     bool createDescriptorSetLayout();
@@ -61,11 +103,15 @@ private:
     bool createUniformBuffer();
     bool createMaterialBuffer();
     bool createLightDataBuffer();
+    bool createInstanceBuffer();
     bool createDescriptorPool();
     bool createCommandBuffers();
     bool createSyncObjects();
+    bool createPipelineCache();
     
     uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
+    // Grava model com a camera do frame num slot novo e liga o descriptor set nele
+    bool bindObjectUniforms(const glm::mat4& model);
     
 public:
     ~VulkanRendererBackend();
@@ -74,12 +120,13 @@ public:
     void drawSprite(const Sprite& sprite) override;
     bool init() override;
     bool initWindowContext() override;
-    void bindCamera(Camera* camera) override {return;};
+    void bindCamera(Camera* camera) override;
     void applyMaterial(Material* material) override {};
-    void renderGameObjects(std::vector<GameObject*>* gameObjects, std::vector<Light>* lights) override {};
+    void renderGameObjects(std::vector<GameObject*>* gameObjects, std::vector<Light>* lights) override;
     void setBufferDataImpl(const std::string& name, const void* data, size_t size) override {};
     void clear(Camera* camera) override;
     void draw(const Mesh&) override;
+    bool drawInstanced(const Mesh& mesh, const glm::mat4* models, uint32_t count) override;
     void setUniforms(ShaderProgram* shaderProgram) override;
     void onCameraSet() override;
     GraphicsAPI getGraphicsAPI() const override;
@@ -100,10 +147,14 @@ public:
     VkExtent2D getSwapchainExtent() const { return swapchainExtent; }
     VkRenderPass getRenderPass() const { return renderPass; }
     VkDescriptorSetLayout getDescriptorSetLayout() const { return descriptorSetLayout; }
+    VkPipelineCache getPipelineCache() const { return pipelineCache; }
+    Yume::JobCounter& getPipelineBuilds() { return pipelineBuilds; }
     void setSurface(VkSurfaceKHR surf) { surface = surf; }
     void setWindow(SDL_Window* win) { window = win; }
     unsigned int getRequiredWindowFlags() const override;
     bool init(SDL_Window* window) override;
+    bool initHeadless(int width, int height) override;
+    bool readPixels(std::vector<uint8_t>& rgba, int& width, int& height) override;
 };
 
 #endif // VULKAN_RENDERER_BACKEND_HPP
@@ -1,3 +1,6 @@
+#define CLASS_NAME "VulkanShaderProgram"
+#include "../../../log_macros.hpp"
+
 #include "vulkan_shader_program.hpp"
 #include "vulkan_renderer_backend.hpp"
 #include "../../../shader_asset.hpp"
@@ -5,6 +8,8 @@
 #include <array>
 
 VulkanShaderProgram::~VulkanShaderProgram() {
+    // Nao destruir enquanto o job ainda escreve no pipeline
+    Yume::JobSystem::shared().wait(pendingBuild);
     if (pipeline) {
         vkDestroyPipeline(backend->getDevice(), pipeline, nullptr);
     }
@@ -21,7 +26,31 @@ bool VulkanShaderProgram::attachShader(const ShaderAsset& shader) {
 }
 
 bool VulkanShaderProgram::link() {
-    return createPipeline();
+    Yume::JobSystem& jobs = Yume::JobSystem::shared();
+    jobs.run(
+        [this]() {
+            if (!createPipeline()) {
+                LOG_ERROR("Failed to create the graphics pipeline");
+                failed.store(true, std::memory_order_release);
+            }
+        },
+        &pendingBuild);
+    // O backend so destroi o device depois que todos os pipelines terminarem
+    jobs.runAfter(pendingBuild, []() {}, &backend->getPipelineBuilds());
+    linked = true;
+    return true;
+}
+
+bool VulkanShaderProgram::isReady() {
+    if (built) {
+        return true;
+    }
+    if (!linked || !pendingBuild.isDone()) {
+        return false;
+    }
+
+    built = true;
+    return true;
 }
 
 bool VulkanShaderProgram::createPipeline() {
@@ -42,7 +71,7 @@ bool VulkanShaderProgram::createPipeline() {
         shaderStages.push_back(stageInfo);
     }
     
-    VkVertexInputBindingDescription bindingDescriptions[2] = {};
+    VkVertexInputBindingDescription bindingDescriptions[3] = {};
     bindingDescriptions[0].binding = 0;
     bindingDescriptions[0].stride = 3 * sizeof(float);
     bindingDescriptions[0].inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
@@ -50,8 +79,13 @@ bool VulkanShaderProgram::createPipeline() {
     bindingDescriptions[1].binding = 1;
     bindingDescriptions[1].stride = 3 * sizeof(float);
     bindingDescriptions[1].inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+    // Binding 2: matriz model por instancia (colunas nas locations 2..5)
+    bindingDescriptions[2].binding = 2;
+    bindingDescriptions[2].stride = 16 * sizeof(float);
+    bindingDescriptions[2].inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
     
-    VkVertexInputAttributeDescription attributeDescriptions[2] = {};
+    VkVertexInputAttributeDescription attributeDescriptions[6] = {};
     attributeDescriptions[0].binding = 0;
     attributeDescriptions[0].location = 0;
     attributeDescriptions[0].format = VK_FORMAT_R32G32B32_SFLOAT;
@@ -61,12 +95,19 @@ bool VulkanShaderProgram::createPipeline() {
     attributeDescriptions[1].location = 1;
     attributeDescriptions[1].format = VK_FORMAT_R32G32B32_SFLOAT;
     attributeDescriptions[1].offset = 0;
+
+    for (uint32_t column = 0; column < 4; column++) {
+        attributeDescriptions[2 + column].binding = 2;
+        attributeDescriptions[2 + column].location = 2 + column;
+        attributeDescriptions[2 + column].format = VK_FORMAT_R32G32B32A32_SFLOAT;
+        attributeDescriptions[2 + column].offset = column * 4 * sizeof(float);
+    }
     
     VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
     vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-    vertexInputInfo.vertexBindingDescriptionCount = 2;
+    vertexInputInfo.vertexBindingDescriptionCount = isInstanced() ? 3 : 2;
     vertexInputInfo.pVertexBindingDescriptions = bindingDescriptions;
-    vertexInputInfo.vertexAttributeDescriptionCount = 2;
+    vertexInputInfo.vertexAttributeDescriptionCount = isInstanced() ? 6 : 2;
     vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions;
     
     VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
@@ -153,7 +194,7 @@ bool VulkanShaderProgram::createPipeline() {
     pipelineInfo.renderPass = backend->getRenderPass();
     pipelineInfo.subpass = 0;
     
-    return vkCreateGraphicsPipelines(backend->getDevice(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline) == VK_SUCCESS;
+    return vkCreateGraphicsPipelines(backend->getDevice(), backend->getPipelineCache(), 1, &pipelineInfo, nullptr, &pipeline) == VK_SUCCESS;
 }
 
 void VulkanShaderProgram::use() {
@@ -183,5 +224,5 @@ void* VulkanShaderProgram::getHandle() const {
 }
 
 bool VulkanShaderProgram::isValid() const {
-    return pipeline != VK_NULL_HANDLE;
+    return built && !hasFailed() && pipeline != VK_NULL_HANDLE;
 }
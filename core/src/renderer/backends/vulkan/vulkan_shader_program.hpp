@@ -4,7 +4,9 @@
 #include "../../../shader_program.hpp"
 #include "../../../shader_type.hpp"
 #include "material.hpp"
+#include "../../../job_system.hpp"
 #include <vulkan/vulkan.h>
+#include <atomic>
 #include <vector>
 
 class VulkanRendererBackend;
@@ -16,6 +18,14 @@ private:
     std::vector<ShaderType> shaderTypes;
     VkPipeline pipeline = VK_NULL_HANDLE;
     VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+
+    // Pipeline e criado num job; pipeline/pipelineLayout so podem ser lidos depois
+    // que isReady() retornar true
+    Yume::JobCounter pendingBuild;
+    // Escrito pelo job quando vkCreate* falha
+    std::atomic<bool> failed{false};
+    bool linked = false;
+    bool built = false;
     
     bool createPipeline();
     
@@ -29,6 +39,9 @@ public:
     void setUniformBuffer(const char* name, const void* data, size_t size) override;
     void* getHandle() const override;
     bool isValid() const override;
+    bool isReady() override;
+    // Pronto, mas sem pipeline: o material nao deve ser desenhado
+    bool hasFailed() const { return failed.load(std::memory_order_acquire); }
     
     VkPipeline getPipeline() const { return pipeline; }
     VkPipelineLayout getPipelineLayout() const { return pipelineLayout; }
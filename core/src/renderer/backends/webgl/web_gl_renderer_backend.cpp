@@ -1,6 +1,7 @@
 #include "web_gl_renderer_backend.hpp"
 #include "color.hpp"
 #include "graphics_api.hpp"
+#include "trace.hpp"
 #include <GL/glew.h>
 #include <SDL2/SDL.h>
 #include <emscripten.h>
@@ -88,6 +89,7 @@ void WebGLRendererBackend::setUniforms(unsigned int shaderProgram) {
 }
 
 unsigned int WebGLRendererBackend::createCubemapTexture(const std::vector<std::string>& faces) {
+    TRACE_ZONE("WebGLRendererBackend::createCubemapTexture");
     unsigned int textureID;
     glGenTextures(1, &textureID);
     glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
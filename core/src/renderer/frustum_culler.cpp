@@ -0,0 +1,218 @@
+#include "frustum_culler.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define FRUSTUM_CULLER_SSE
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define FRUSTUM_CULLER_NEON
+#include <arm_neon.h>
+#endif
+
+namespace {
+constexpr uint32_t SIMD_WIDTH = 4;
+
+struct PlaneSet {
+    float nx[6], ny[6], nz[6], d[6];
+    float ax[6], ay[6], az[6]; // |normal|, para projetar as extensoes da AABB
+};
+
+PlaneSet makePlaneSet(const glm::vec4 planes[6]) {
+    PlaneSet set;
+    for (int p = 0; p < 6; p++) {
+        set.nx[p] = planes[p].x;
+        set.ny[p] = planes[p].y;
+        set.nz[p] = planes[p].z;
+        set.d[p] = planes[p].w;
+        set.ax[p] = std::fabs(planes[p].x);
+        set.ay[p] = std::fabs(planes[p].y);
+        set.az[p] = std::fabs(planes[p].z);
+    }
+    return set;
+}
+} // namespace
+
+void FrustumCuller::extractPlanes(const glm::mat4& viewProjection, glm::vec4 planes[6]) {
+    // Gribb/Hartmann: linhas da matriz combinadas (glm e column-major)
+    glm::vec4 row0(viewProjection[0][0], viewProjection[1][0], viewProjection[2][0],
+                   viewProjection[3][0]);
+    glm::vec4 row1(viewProjection[0][1], viewProjection[1][1], viewProjection[2][1],
+                   viewProjection[3][1]);
+    glm::vec4 row2(viewProjection[0][2], viewProjection[1][2], viewProjection[2][2],
+                   viewProjection[3][2]);
+    glm::vec4 row3(viewProjection[0][3], viewProjection[1][3], viewProjection[2][3],
+                   viewProjection[3][3]);
+
+    planes[0] = row3 + row0; // esquerda
+    planes[1] = row3 - row0; // direita
+    planes[2] = row3 + row1; // baixo
+    planes[3] = row3 - row1; // cima
+    planes[4] = row3 + row2; // perto (clip z em [-1, 1])
+    planes[5] = row3 - row2; // longe
+
+    for (int p = 0; p < 6; p++) {
+        float length = glm::length(glm::vec3(planes[p]));
+        if (length > 0.0f) {
+            planes[p] /= length;
+        }
+    }
+}
+
+void FrustumCuller::clear() {
+    centerX.clear();
+    centerY.clear();
+    centerZ.clear();
+    extentX.clear();
+    extentY.clear();
+    extentZ.clear();
+    radius.clear();
+    count = 0;
+}
+
+void FrustumCuller::reserve(size_t capacity) {
+    capacity += SIMD_WIDTH;
+    centerX.reserve(capacity);
+    centerY.reserve(capacity);
+    centerZ.reserve(capacity);
+    extentX.reserve(capacity);
+    extentY.reserve(capacity);
+    extentZ.reserve(capacity);
+    radius.reserve(capacity);
+}
+
+uint32_t FrustumCuller::add(const AABB& worldBox, const BoundingSphere& worldSphere) {
+    // Remove o padding de um cull anterior antes de continuar adicionando
+    centerX.resize(count);
+    centerY.resize(count);
+    centerZ.resize(count);
+    extentX.resize(count);
+    extentY.resize(count);
+    extentZ.resize(count);
+    radius.resize(count);
+
+    glm::vec3 center = worldBox.getCenter();
+    glm::vec3 extents = worldBox.getExtents();
+    centerX.push_back(center.x);
+    centerY.push_back(center.y);
+    centerZ.push_back(center.z);
+    extentX.push_back(extents.x);
+    extentY.push_back(extents.y);
+    extentZ.push_back(extents.z);
+
+    // A esfera e testada em relacao ao centro da AABB; ajusta o raio para cobrir a
+    // esfera original mesmo quando os centros diferem
+    radius.push_back(worldSphere.radius + glm::length(worldSphere.center - center));
+    return count++;
+}
+
+void FrustumCuller::padToSimdWidth() {
+    // Objetos de padding ficam com raio negativo e nunca passam no teste
+    size_t padded = (count + SIMD_WIDTH - 1) / SIMD_WIDTH * SIMD_WIDTH;
+    centerX.resize(padded, 0.0f);
+    centerY.resize(padded, 0.0f);
+    centerZ.resize(padded, 0.0f);
+    extentX.resize(padded, -1.0f);
+    extentY.resize(padded, -1.0f);
+    extentZ.resize(padded, -1.0f);
+    radius.resize(padded, -1.0f);
+}
+
+void FrustumCuller::cull(const glm::mat4& viewProjection, std::vector<uint32_t>& visible) {
+    visible.clear();
+    stats = Stats();
+    stats.tested = count;
+    if (count == 0) {
+        return;
+    }
+
+    glm::vec4 planes[6];
+    extractPlanes(viewProjection, planes);
+    const PlaneSet set = makePlaneSet(planes);
+
+    padToSimdWidth();
+    const uint32_t padded = static_cast<uint32_t>(centerX.size());
+
+#if defined(FRUSTUM_CULLER_SSE)
+    const __m128 zero = _mm_setzero_ps();
+    for (uint32_t i = 0; i < padded; i += SIMD_WIDTH) {
+        __m128 cx = _mm_loadu_ps(&centerX[i]);
+        __m128 cy = _mm_loadu_ps(&centerY[i]);
+        __m128 cz = _mm_loadu_ps(&centerZ[i]);
+        __m128 ex = _mm_loadu_ps(&extentX[i]);
+        __m128 ey = _mm_loadu_ps(&extentY[i]);
+        __m128 ez = _mm_loadu_ps(&extentZ[i]);
+        __m128 r = _mm_loadu_ps(&radius[i]);
+        __m128 inside = _mm_cmpge_ps(r, zero);
+
+        for (int p = 0; p < 6; p++) {
+            __m128 dist = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(cx, _mm_set1_ps(set.nx[p])),
+                           _mm_mul_ps(cy, _mm_set1_ps(set.ny[p]))),
+                _mm_add_ps(_mm_mul_ps(cz, _mm_set1_ps(set.nz[p])), _mm_set1_ps(set.d[p])));
+            __m128 boxReach = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(ex, _mm_set1_ps(set.ax[p])),
+                           _mm_mul_ps(ey, _mm_set1_ps(set.ay[p]))),
+                _mm_mul_ps(ez, _mm_set1_ps(set.az[p])));
+            __m128 reach = _mm_min_ps(r, boxReach);
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(dist, reach), zero));
+        }
+
+        int mask = _mm_movemask_ps(inside);
+        for (uint32_t lane = 0; mask; lane++, mask >>= 1) {
+            if (mask & 1) {
+                visible.push_back(i + lane);
+            }
+        }
+    }
+#elif defined(FRUSTUM_CULLER_NEON)
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    for (uint32_t i = 0; i < padded; i += SIMD_WIDTH) {
+        float32x4_t cx = vld1q_f32(&centerX[i]);
+        float32x4_t cy = vld1q_f32(&centerY[i]);
+        float32x4_t cz = vld1q_f32(&centerZ[i]);
+        float32x4_t ex = vld1q_f32(&extentX[i]);
+        float32x4_t ey = vld1q_f32(&extentY[i]);
+        float32x4_t ez = vld1q_f32(&extentZ[i]);
+        float32x4_t r = vld1q_f32(&radius[i]);
+        uint32x4_t inside = vcgeq_f32(r, zero);
+
+        for (int p = 0; p < 6; p++) {
+            float32x4_t dist = vdupq_n_f32(set.d[p]);
+            dist = vmlaq_n_f32(dist, cx, set.nx[p]);
+            dist = vmlaq_n_f32(dist, cy, set.ny[p]);
+            dist = vmlaq_n_f32(dist, cz, set.nz[p]);
+            float32x4_t boxReach = vmulq_n_f32(ex, set.ax[p]);
+            boxReach = vmlaq_n_f32(boxReach, ey, set.ay[p]);
+            boxReach = vmlaq_n_f32(boxReach, ez, set.az[p]);
+            float32x4_t reach = vminq_f32(r, boxReach);
+            inside = vandq_u32(inside, vcgeq_f32(vaddq_f32(dist, reach), zero));
+        }
+
+        uint32_t lanes[SIMD_WIDTH];
+        vst1q_u32(lanes, inside);
+        for (uint32_t lane = 0; lane < SIMD_WIDTH; lane++) {
+            if (lanes[lane]) {
+                visible.push_back(i + lane);
+            }
+        }
+    }
+#else
+    for (uint32_t i = 0; i < padded; i++) {
+        bool inside = radius[i] >= 0.0f;
+        for (int p = 0; p < 6 && inside; p++) {
+            float dist = centerX[i] * set.nx[p] + centerY[i] * set.ny[p] +
+                         centerZ[i] * set.nz[p] + set.d[p];
+            float boxReach =
+                extentX[i] * set.ax[p] + extentY[i] * set.ay[p] + extentZ[i] * set.az[p];
+            inside = dist + std::min(radius[i], boxReach) >= 0.0f;
+        }
+        if (inside) {
+            visible.push_back(i);
+        }
+    }
+#endif
+
+    stats.visible = static_cast<uint32_t>(visible.size());
+    stats.culled = stats.tested - stats.visible;
+}
@@ -0,0 +1,48 @@
+#ifndef FRUSTUM_CULLER_HPP
+#define FRUSTUM_CULLER_HPP
+
+#include "../bounds.hpp"
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+// Culling por frustum em lote. Os volumes (AABB + esfera em espaco de mundo) ficam em
+// arrays separados por componente (SoA) e sao testados 4 por vez contra os 6 planos
+// com SSE ou NEON; sem nenhum dos dois cai no laco escalar.
+//
+// Um objeto e descartado se estiver inteiramente atras de algum plano usando o menor
+// dos dois volumes naquele plano, o que e mais justo que testar so um deles.
+class FrustumCuller {
+  public:
+    struct Stats {
+        uint32_t tested = 0;
+        uint32_t visible = 0;
+        uint32_t culled = 0;
+    };
+
+  private:
+    std::vector<float> centerX, centerY, centerZ;
+    std::vector<float> extentX, extentY, extentZ;
+    std::vector<float> radius;
+    uint32_t count = 0;
+    Stats stats;
+
+    void padToSimdWidth();
+
+  public:
+    // Planos (normal xyz, distancia w) normalizados, apontando para dentro
+    static void extractPlanes(const glm::mat4& viewProjection, glm::vec4 planes[6]);
+
+    void clear();
+    void reserve(size_t capacity);
+    // Retorna o indice usado em cull()
+    uint32_t add(const AABB& worldBox, const BoundingSphere& worldSphere);
+
+    // Preenche visible com os indices (em ordem crescente) que intersectam o frustum
+    void cull(const glm::mat4& viewProjection, std::vector<uint32_t>& visible);
+
+    uint32_t size() const { return count; }
+    const Stats& getStats() const { return stats; }
+};
+
+#endif // FRUSTUM_CULLER_HPP
@@ -0,0 +1,98 @@
+#include "gpu_profiler.hpp"
+#include "../trace.hpp"
+#include <algorithm>
+
+void GpuProfiler::beginFrame() {
+    if (!supported) {
+        return;
+    }
+
+    Slot& slot = slots[currentSlot];
+    if (slot.pending) {
+        collect(slot, currentSlot);
+    }
+
+    resetQueries(currentSlot);
+    slot = Slot();
+    slot.frame = EngineStats::getFrameCount();
+    slot.traceBeginNs = Trace::now();
+    inFrame = true;
+}
+
+void GpuProfiler::beginPass(GpuPass pass) {
+    size_t index = static_cast<size_t>(pass);
+    if (!inFrame || inPass || slots[currentSlot].written[index]) {
+        return;
+    }
+
+    writeTimestamp(currentSlot, 2 * index);
+    inPass = true;
+    activePass = pass;
+}
+
+void GpuProfiler::endPass(GpuPass pass) {
+    if (!inPass || pass != activePass) {
+        return;
+    }
+
+    size_t index = static_cast<size_t>(pass);
+    writeTimestamp(currentSlot, 2 * index + 1);
+    slots[currentSlot].written[index] = true;
+    inPass = false;
+}
+
+void GpuProfiler::endFrame() {
+    if (!inFrame) {
+        return;
+    }
+    if (inPass) {
+        endPass(activePass);
+    }
+
+    Slot& slot = slots[currentSlot];
+    for (bool written : slot.written) {
+        slot.pending = slot.pending || written;
+    }
+    currentSlot = (currentSlot + 1) % FRAME_LATENCY;
+    inFrame = false;
+}
+
+void GpuProfiler::collect(Slot& slot, uint32_t index) {
+    slot.pending = false;
+
+    uint64_t begin[GPU_PASS_COUNT] = {};
+    uint64_t end[GPU_PASS_COUNT] = {};
+    uint64_t frameBegin = UINT64_MAX;
+    uint64_t frameEnd = 0;
+    for (size_t pass = 0; pass < GPU_PASS_COUNT; pass++) {
+        if (!slot.written[pass]) {
+            continue;
+        }
+        if (!readTimestamp(index, 2 * pass, begin[pass]) ||
+            !readTimestamp(index, 2 * pass + 1, end[pass])) {
+            droppedFrames++;
+            return;
+        }
+        frameBegin = std::min(frameBegin, begin[pass]);
+        frameEnd = std::max(frameEnd, end[pass]);
+    }
+
+    GpuFrameStats gpuFrame;
+    gpuFrame.frame = slot.frame;
+    gpuFrame.totalMs = frameEnd > frameBegin ? (frameEnd - frameBegin) / 1e6f : 0.0f;
+    for (size_t pass = 0; pass < GPU_PASS_COUNT; pass++) {
+        if (!slot.written[pass] || end[pass] < begin[pass]) {
+            continue;
+        }
+        gpuFrame.passMs[pass] = (end[pass] - begin[pass]) / 1e6f;
+
+        if (slot.traceBeginNs) {
+            Trace::gpuZone(getGpuPassName(static_cast<GpuPass>(pass)),
+                           slot.traceBeginNs + (begin[pass] - frameBegin),
+                           slot.traceBeginNs + (end[pass] - frameBegin));
+        }
+    }
+
+    EngineStats::recordGpuFrame(gpuFrame);
+    TRACE_COUNTER("gpu ms", gpuFrame.totalMs);
+}
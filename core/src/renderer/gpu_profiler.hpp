@@ -0,0 +1,61 @@
+#ifndef GPU_PROFILER_HPP
+#define GPU_PROFILER_HPP
+
+#include "../engine_stats.hpp"
+#include <cstdint>
+
+// Tempos de GPU por pass com timestamps. Cada frame usa um slot de consultas; o slot so
+// e lido FRAME_LATENCY frames depois, quando a GPU ja passou por ele, e a leitura nunca
+// espera: um slot ainda pendente e descartado e reutilizado.
+//
+// Os resultados vao para EngineStats::recordGpuFrame e para a trilha "GPU" do trace.
+// Como os relogios de CPU e GPU nao sao sincronizados, as zonas de GPU sao ancoradas
+// no inicio do frame de CPU que as gravou; duracoes e intervalos entre passes sao exatos.
+class GpuProfiler {
+  public:
+    static constexpr uint32_t FRAME_LATENCY = 4;
+    // Inicio do pass em 2 * pass, fim em 2 * pass + 1
+    static constexpr uint32_t QUERIES_PER_SLOT = 2 * GPU_PASS_COUNT;
+
+  private:
+    struct Slot {
+        bool pending = false;
+        uint64_t frame = 0;
+        uint64_t traceBeginNs = 0;
+        bool written[GPU_PASS_COUNT] = {};
+    };
+
+    Slot slots[FRAME_LATENCY];
+    uint32_t currentSlot = 0;
+    bool inFrame = false;
+    bool inPass = false;
+    GpuPass activePass = GpuPass::CLEAR;
+    uint32_t droppedFrames = 0;
+
+    void collect(Slot& slot, uint32_t index);
+
+  protected:
+    // Backends ligam quando as consultas foram criadas
+    bool supported = false;
+
+    virtual void resetQueries(uint32_t slot) = 0;
+    virtual void writeTimestamp(uint32_t slot, uint32_t query) = 0;
+    // Timestamp em ns; false se a GPU ainda nao terminou (nao pode bloquear)
+    virtual bool readTimestamp(uint32_t slot, uint32_t query, uint64_t& ns) = 0;
+
+  public:
+    virtual ~GpuProfiler() = default;
+
+    bool isSupported() const { return supported; }
+    // Frames cujas consultas ainda nao estavam prontas quando o slot voltou
+    uint32_t getDroppedFrames() const { return droppedFrames; }
+
+    // Le o slot mais antigo e o prepara para o frame atual
+    void beginFrame();
+    // Um pass por vez; um pass repetido no mesmo frame so mede a primeira ocorrencia
+    void beginPass(GpuPass pass);
+    void endPass(GpuPass pass);
+    void endFrame();
+};
+
+#endif // GPU_PROFILER_HPP
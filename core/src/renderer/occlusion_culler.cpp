@@ -0,0 +1,341 @@
+#include "occlusion_culler.hpp"
+#include "../game_object.hpp"
+#include "../material.hpp"
+#include "../job_system.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define OCCLUSION_CULLER_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace {
+// Oclusores com mais triangulos que isso custam mais do que economizam
+constexpr size_t MAX_OCCLUDER_TRIANGLES = 8192;
+constexpr float MIN_CLIP_W = 1e-5f;
+
+struct ScreenRect {
+    int minX, minY, maxX, maxY; // max exclusivo
+    float minDepth;
+};
+
+// Projeta os 8 cantos da caixa; false se ela cruza o plano near ou cai fora da tela
+bool projectBox(const AABB& box, const glm::mat4& viewProjection, int width, int height,
+                ScreenRect& rect) {
+    glm::vec2 screenMin(1e30f), screenMax(-1e30f);
+    float minDepth = 1.0f;
+
+    for (int corner = 0; corner < 8; corner++) {
+        glm::vec3 p((corner & 1) ? box.max.x : box.min.x, (corner & 2) ? box.max.y : box.min.y,
+                    (corner & 4) ? box.max.z : box.min.z);
+        glm::vec4 clip = viewProjection * glm::vec4(p, 1.0f);
+        if (clip.w < MIN_CLIP_W || clip.z < -clip.w) {
+            return false;
+        }
+
+        glm::vec3 ndc = glm::vec3(clip) / clip.w;
+        glm::vec2 screen((ndc.x * 0.5f + 0.5f) * width, (0.5f - ndc.y * 0.5f) * height);
+        screenMin = glm::min(screenMin, screen);
+        screenMax = glm::max(screenMax, screen);
+        minDepth = std::min(minDepth, ndc.z * 0.5f + 0.5f);
+    }
+
+    rect.minX = std::max(0, static_cast<int>(std::floor(screenMin.x)));
+    rect.minY = std::max(0, static_cast<int>(std::floor(screenMin.y)));
+    rect.maxX = std::min(width, static_cast<int>(std::ceil(screenMax.x)));
+    rect.maxY = std::min(height, static_cast<int>(std::ceil(screenMax.y)));
+    rect.minDepth = std::max(minDepth, 0.0f);
+    return rect.minX < rect.maxX && rect.minY < rect.maxY;
+}
+} // namespace
+
+OcclusionCuller::OcclusionCuller()
+    : depth(WIDTH * HEIGHT, 1.0f), blockMaxDepth(BLOCKS_X * BLOCKS_Y, 1.0f),
+      tileBins(TILES_X * TILES_Y) {}
+
+OcclusionCuller::~OcclusionCuller() = default;
+
+void OcclusionCuller::selectOccluders(const std::vector<GameObject*>& objects) {
+    candidates.clear();
+    for (const auto go : objects) {
+        if (!go->hasMesh() || !go->hasMeshRenderer() || go->hasSprite()) {
+            continue;
+        }
+        // So ocluem objetos desenhados opacos (mesmo criterio da RenderQueue). Roda na
+        // thread de simulacao, entao usa o estado publicado em vez de isReady()
+        const Material* material = go->getMeshRenderer()->getMaterial();
+        if (!material || !material->isDrawable() || material->isTranslucent()) {
+            continue;
+        }
+        if (go->getMesh()->getVertices().size() / 9 > MAX_OCCLUDER_TRIANGLES) {
+            continue;
+        }
+
+        AABB box;
+        BoundingSphere sphere;
+        ScreenRect rect;
+        if (!go->getWorldBounds(box, sphere) ||
+            !projectBox(box, viewProjection, WIDTH, HEIGHT, rect)) {
+            continue;
+        }
+
+        float size = std::max(static_cast<float>(rect.maxX - rect.minX) / WIDTH,
+                              static_cast<float>(rect.maxY - rect.minY) / HEIGHT);
+        if (size >= minOccluderSize) {
+            candidates.push_back({size, go});
+        }
+    }
+
+    size_t count = std::min(candidates.size(), MAX_OCCLUDERS);
+    std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end(),
+                      [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    occluders.clear();
+    for (size_t i = 0; i < count; i++) {
+        occluders.push_back(candidates[i].second);
+    }
+}
+
+void OcclusionCuller::addOccluder(GameObject* object) {
+    const std::vector<float>& vertices = object->getMesh()->getVertices();
+    glm::mat4 model = object->getTransform() ? object->getTransform()->getModelMatrix()
+                                             : glm::mat4(1.0f);
+    glm::mat4 modelViewProjection = viewProjection * model;
+
+    for (size_t i = 0; i + 8 < vertices.size(); i += 9) {
+        ScreenTriangle triangle;
+        bool clipped = false;
+        for (int k = 0; k < 3; k++) {
+            glm::vec4 clip = modelViewProjection * glm::vec4(vertices[i + k * 3],
+                                                             vertices[i + k * 3 + 1],
+                                                             vertices[i + k * 3 + 2], 1.0f);
+            // Triangulos cortando o near sao descartados: deixar de ocluir e seguro
+            if (clip.w < MIN_CLIP_W || clip.z < -clip.w) {
+                clipped = true;
+                break;
+            }
+            glm::vec3 ndc = glm::vec3(clip) / clip.w;
+            triangle.v[k] = glm::vec3((ndc.x * 0.5f + 0.5f) * WIDTH,
+                                      (0.5f - ndc.y * 0.5f) * HEIGHT, ndc.z * 0.5f + 0.5f);
+        }
+        if (clipped) {
+            continue;
+        }
+
+        glm::vec2 lo = glm::min(glm::min(glm::vec2(triangle.v[0]), glm::vec2(triangle.v[1])),
+                                glm::vec2(triangle.v[2]));
+        glm::vec2 hi = glm::max(glm::max(glm::vec2(triangle.v[0]), glm::vec2(triangle.v[1])),
+                                glm::vec2(triangle.v[2]));
+        if (hi.x < 0.0f || hi.y < 0.0f || lo.x >= WIDTH || lo.y >= HEIGHT) {
+            continue;
+        }
+
+        int tileX0 = std::max(0, static_cast<int>(lo.x) / TILE_WIDTH);
+        int tileY0 = std::max(0, static_cast<int>(lo.y) / TILE_HEIGHT);
+        int tileX1 = std::min(TILES_X - 1, static_cast<int>(hi.x) / TILE_WIDTH);
+        int tileY1 = std::min(TILES_Y - 1, static_cast<int>(hi.y) / TILE_HEIGHT);
+
+        uint32_t index = static_cast<uint32_t>(triangles.size());
+        triangles.push_back(triangle);
+        for (int ty = tileY0; ty <= tileY1; ty++) {
+            for (int tx = tileX0; tx <= tileX1; tx++) {
+                tileBins[ty * TILES_X + tx].push_back(index);
+            }
+        }
+    }
+}
+
+void OcclusionCuller::rasterizeTriangle(const ScreenTriangle& triangle, int minX, int minY,
+                                        int maxX, int maxY) {
+    glm::vec3 v0 = triangle.v[0];
+    glm::vec3 v1 = triangle.v[1];
+    glm::vec3 v2 = triangle.v[2];
+
+    float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+    if (std::fabs(area) < 1e-6f) {
+        return;
+    }
+    // Oclusores sao rasterizados dos dois lados; normaliza a orientacao
+    if (area < 0.0f) {
+        std::swap(v1, v2);
+        area = -area;
+    }
+
+    // Funcoes de aresta E(x, y) = a*x + b*y + c, positivas dentro do triangulo
+    const glm::vec3 edges[3][2] = {{v0, v1}, {v1, v2}, {v2, v0}};
+    float a[3], b[3], c[3];
+    for (int e = 0; e < 3; e++) {
+        const glm::vec3& p = edges[e][0];
+        const glm::vec3& q = edges[e][1];
+        a[e] = -(q.y - p.y);
+        b[e] = q.x - p.x;
+        c[e] = -(a[e] * p.x + b[e] * p.y);
+    }
+
+    float dzdx = ((v1.z - v0.z) * (v2.y - v0.y) - (v2.z - v0.z) * (v1.y - v0.y)) / area;
+    float dzdy = ((v2.z - v0.z) * (v1.x - v0.x) - (v1.z - v0.z) * (v2.x - v0.x)) / area;
+    float zc = v0.z - dzdx * v0.x - dzdy * v0.y;
+
+    int x0 = std::max(minX, static_cast<int>(std::floor(std::min({v0.x, v1.x, v2.x}))));
+    int y0 = std::max(minY, static_cast<int>(std::floor(std::min({v0.y, v1.y, v2.y}))));
+    int x1 = std::min(maxX, static_cast<int>(std::ceil(std::max({v0.x, v1.x, v2.x}))));
+    int y1 = std::min(maxY, static_cast<int>(std::ceil(std::max({v0.y, v1.y, v2.y}))));
+    // Tiles comecam em multiplos de 4, entao os grupos de 4 pixels nao saem do tile
+    x0 &= ~3;
+
+    for (int y = y0; y < y1; y++) {
+        float py = y + 0.5f;
+        float* row = &depth[y * WIDTH];
+
+#if defined(OCCLUSION_CULLER_SSE)
+        const __m128 laneOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+        const __m128 zero = _mm_setzero_ps();
+        __m128 rowE0 = _mm_set1_ps(b[0] * py + c[0]);
+        __m128 rowE1 = _mm_set1_ps(b[1] * py + c[1]);
+        __m128 rowE2 = _mm_set1_ps(b[2] * py + c[2]);
+        __m128 rowZ = _mm_set1_ps(dzdy * py + zc);
+
+        for (int x = x0; x < x1; x += 4) {
+            __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), laneOffsets);
+            __m128 e0 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a[0]), px), rowE0);
+            __m128 e1 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a[1]), px), rowE1);
+            __m128 e2 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a[2]), px), rowE2);
+            __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)),
+                                       _mm_cmpge_ps(e2, zero));
+            if (_mm_movemask_ps(inside) == 0) {
+                continue;
+            }
+
+            __m128 z = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(dzdx), px), rowZ);
+            __m128 old = _mm_loadu_ps(row + x);
+            __m128 nearest = _mm_min_ps(old, z);
+            _mm_storeu_ps(row + x,
+                          _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, old)));
+        }
+#else
+        for (int x = x0; x < x1; x++) {
+            float px = x + 0.5f;
+            if (a[0] * px + b[0] * py + c[0] < 0.0f || a[1] * px + b[1] * py + c[1] < 0.0f ||
+                a[2] * px + b[2] * py + c[2] < 0.0f) {
+                continue;
+            }
+            row[x] = std::min(row[x], dzdx * px + dzdy * py + zc);
+        }
+#endif
+    }
+}
+
+void OcclusionCuller::rasterizeTile(int tile) {
+    int minX = (tile % TILES_X) * TILE_WIDTH;
+    int minY = (tile / TILES_X) * TILE_HEIGHT;
+    int maxX = minX + TILE_WIDTH;
+    int maxY = minY + TILE_HEIGHT;
+
+    for (int y = minY; y < maxY; y++) {
+        std::fill(&depth[y * WIDTH + minX], &depth[y * WIDTH + maxX], 1.0f);
+    }
+
+    for (uint32_t index : tileBins[tile]) {
+        rasterizeTriangle(triangles[index], minX, minY, maxX, maxY);
+    }
+
+    // Nivel hierarquico: profundidade maxima (mais distante) de cada bloco
+    for (int by = minY / BLOCK_SIZE; by < maxY / BLOCK_SIZE; by++) {
+        for (int bx = minX / BLOCK_SIZE; bx < maxX / BLOCK_SIZE; bx++) {
+            float farthest = 0.0f;
+            for (int y = by * BLOCK_SIZE; y < (by + 1) * BLOCK_SIZE; y++) {
+                const float* row = &depth[y * WIDTH + bx * BLOCK_SIZE];
+                for (int x = 0; x < BLOCK_SIZE; x++) {
+                    farthest = std::max(farthest, row[x]);
+                }
+            }
+            blockMaxDepth[by * BLOCKS_X + bx] = farthest;
+        }
+    }
+}
+
+void OcclusionCuller::rasterizeTiles() {
+    // Um tile por vez: o custo varia muito entre tiles; a thread atual tambem trabalha
+    Yume::JobSystem::shared().parallelFor(TILES_X * TILES_Y, 1, [this](size_t begin, size_t end) {
+        for (size_t tile = begin; tile < end; tile++) {
+            rasterizeTile(static_cast<int>(tile));
+        }
+    });
+}
+
+bool OcclusionCuller::isOccluded(const AABB& box) const {
+    ScreenRect rect;
+    if (!projectBox(box, viewProjection, WIDTH, HEIGHT, rect)) {
+        return false;
+    }
+
+    for (int by = rect.minY / BLOCK_SIZE; by <= (rect.maxY - 1) / BLOCK_SIZE; by++) {
+        for (int bx = rect.minX / BLOCK_SIZE; bx <= (rect.maxX - 1) / BLOCK_SIZE; bx++) {
+            // Bloco inteiro mais perto que o ponto mais proximo da caixa
+            if (rect.minDepth > blockMaxDepth[by * BLOCKS_X + bx]) {
+                continue;
+            }
+
+            int x0 = std::max(rect.minX, bx * BLOCK_SIZE);
+            int x1 = std::min(rect.maxX, (bx + 1) * BLOCK_SIZE);
+            int y0 = std::max(rect.minY, by * BLOCK_SIZE);
+            int y1 = std::min(rect.maxY, (by + 1) * BLOCK_SIZE);
+            for (int y = y0; y < y1; y++) {
+                const float* row = &depth[y * WIDTH];
+                for (int x = x0; x < x1; x++) {
+                    if (rect.minDepth <= row[x]) {
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+void OcclusionCuller::cull(const glm::mat4& viewProjectionMatrix,
+                           std::vector<GameObject*>& objects) {
+    stats = Stats();
+    if (!enabled || objects.size() < 2) {
+        return;
+    }
+
+    viewProjection = viewProjectionMatrix;
+    selectOccluders(objects);
+    if (occluders.empty()) {
+        return;
+    }
+
+    triangles.clear();
+    for (auto& bin : tileBins) {
+        bin.clear();
+    }
+    for (const auto occluder : occluders) {
+        addOccluder(occluder);
+    }
+    stats.occluders = static_cast<uint32_t>(occluders.size());
+    stats.occluderTriangles = static_cast<uint32_t>(triangles.size());
+
+    rasterizeTiles();
+
+    auto isOccluder = [&](GameObject* go) {
+        return std::find(occluders.begin(), occluders.end(), go) != occluders.end();
+    };
+
+    size_t kept = 0;
+    for (size_t i = 0; i < objects.size(); i++) {
+        GameObject* go = objects[i];
+        AABB box;
+        BoundingSphere sphere;
+        if (!isOccluder(go) && go->getWorldBounds(box, sphere)) {
+            stats.tested++;
+            if (isOccluded(box)) {
+                stats.occluded++;
+                continue;
+            }
+        }
+        objects[kept++] = go;
+    }
+    objects.resize(kept);
+}
@@ -0,0 +1,84 @@
+#ifndef OCCLUSION_CULLER_HPP
+#define OCCLUSION_CULLER_HPP
+
+#include "../bounds.hpp"
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+class GameObject;
+
+// Occlusion culling em CPU. Os triangulos de alguns oclusores grandes sao rasterizados
+// num depth buffer de baixa resolucao (SSE, 4 pixels por vez), dividido em tiles que
+// sao processados em paralelo. Cada tile tambem gera um nivel hierarquico com a
+// profundidade maxima por bloco de 8x8, que responde a maioria dos testes de oclusao
+// sem descer ao buffer completo.
+//
+// Os testes usam so as caixas dos oclusos, entao o resultado nao depende do backend
+// (inclusive headless). Pixels contam como cobertos pelo centro, como em outros
+// rasterizadores de oclusao; objetos muito finos atras de bordas podem sumir um frame.
+class OcclusionCuller {
+  public:
+    static constexpr int WIDTH = 320;
+    static constexpr int HEIGHT = 192;
+    static constexpr int TILE_WIDTH = 64;
+    static constexpr int TILE_HEIGHT = 32;
+    static constexpr int BLOCK_SIZE = 8;
+    static constexpr size_t MAX_OCCLUDERS = 16;
+
+    struct Stats {
+        uint32_t occluders = 0;
+        uint32_t occluderTriangles = 0;
+        uint32_t tested = 0;
+        uint32_t occluded = 0;
+    };
+
+  private:
+    static constexpr int TILES_X = WIDTH / TILE_WIDTH;
+    static constexpr int TILES_Y = HEIGHT / TILE_HEIGHT;
+    static constexpr int BLOCKS_X = WIDTH / BLOCK_SIZE;
+    static constexpr int BLOCKS_Y = HEIGHT / BLOCK_SIZE;
+
+    // Triangulo em coordenadas de tela, profundidade em [0, 1]
+    struct ScreenTriangle {
+        glm::vec3 v[3];
+    };
+
+    std::vector<float> depth;
+    std::vector<float> blockMaxDepth;
+    std::vector<ScreenTriangle> triangles;
+    std::vector<std::vector<uint32_t>> tileBins;
+
+    glm::mat4 viewProjection = glm::mat4(1.0f);
+    float minOccluderSize = 0.15f;
+    bool enabled = true;
+    Stats stats;
+
+    std::vector<std::pair<float, GameObject*>> candidates;
+    std::vector<GameObject*> occluders;
+
+    void selectOccluders(const std::vector<GameObject*>& objects);
+    void addOccluder(GameObject* object);
+    void rasterizeTiles();
+    void rasterizeTile(int tile);
+    void rasterizeTriangle(const ScreenTriangle& triangle, int minX, int minY, int maxX,
+                           int maxY);
+    bool isOccluded(const AABB& box) const;
+
+  public:
+    OcclusionCuller();
+    ~OcclusionCuller();
+
+    void setEnabled(bool value) { enabled = value; }
+    bool isEnabled() const { return enabled; }
+    // Fracao da altura da tela que a esfera projetada precisa cobrir para virar oclusor
+    void setMinOccluderSize(float fraction) { minOccluderSize = fraction; }
+
+    // Remove de objects (ja filtrados por frustum) os que estao escondidos atras dos
+    // oclusores escolhidos entre eles. A ordem relativa dos restantes e mantida.
+    void cull(const glm::mat4& viewProjectionMatrix, std::vector<GameObject*>& objects);
+
+    const Stats& getStats() const { return stats; }
+};
+
+#endif // OCCLUSION_CULLER_HPP
@@ -0,0 +1,74 @@
+#include "render_capture.hpp"
+
+void CaptureWriter::begin(CaptureRecord type) {
+    recordStart = data.size();
+    data.push_back(static_cast<uint8_t>(type));
+    uint32_t size = 0;
+    write(size);
+}
+
+void CaptureWriter::end() {
+    uint32_t size = static_cast<uint32_t>(data.size() - recordStart - 1 - sizeof(uint32_t));
+    std::memcpy(data.data() + recordStart + 1, &size, sizeof(size));
+}
+
+void CaptureWriter::write(const void* source, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(source);
+    data.insert(data.end(), bytes, bytes + size);
+}
+
+void CaptureWriter::writeString(const std::string& text) {
+    uint32_t length = static_cast<uint32_t>(text.size());
+    write(length);
+    write(text.data(), length);
+}
+
+bool CaptureReader::read(void* destination, size_t length) {
+    const uint8_t* source = skip(length);
+    if (!source) {
+        return false;
+    }
+    std::memcpy(destination, source, length);
+    return true;
+}
+
+bool CaptureReader::readString(std::string& text) {
+    uint32_t length = 0;
+    if (!read(length)) {
+        return false;
+    }
+    const uint8_t* source = skip(length);
+    if (!source) {
+        return false;
+    }
+    text.assign(reinterpret_cast<const char*>(source), length);
+    return true;
+}
+
+const uint8_t* CaptureReader::skip(size_t length) {
+    if (failed || length > size - offset) {
+        failed = true;
+        return nullptr;
+    }
+    const uint8_t* source = data + offset;
+    offset += length;
+    return source;
+}
+
+bool CaptureReader::nextRecord(CaptureRecord& type, CaptureReader& payload) {
+    uint8_t rawType = 0;
+    uint32_t length = 0;
+    if (!read(rawType) || !read(length) ||
+        rawType >= static_cast<uint8_t>(CaptureRecord::COUNT)) {
+        failed = true;
+        return false;
+    }
+
+    const uint8_t* bytes = skip(length);
+    if (!bytes) {
+        return false;
+    }
+    type = static_cast<CaptureRecord>(rawType);
+    payload = CaptureReader(bytes, length);
+    return true;
+}
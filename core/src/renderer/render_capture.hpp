@@ -0,0 +1,139 @@
+#ifndef RENDER_CAPTURE_HPP
+#define RENDER_CAPTURE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Captura binaria (.yrc) das chamadas ao RendererBackend, gravada pelo
+// CaptureRendererBackend e reproduzida pelo RenderReplay:
+//   CaptureFileHeader
+//   registros: tipo (uint8) + tamanho do payload (uint32) + payload
+// Recursos (DEFINE_*) sao gravados antes do primeiro uso dentro da captura, com os
+// dados necessarios para recria-los em qualquer backend (vertices, caminhos de shader
+// sem extensao, caminhos de textura). Estado (SET_*) so e gravado quando muda, e o
+// primeiro frame traz o estado completo do que ele usa. Cada frame termina em PRESENT.
+constexpr uint32_t CAPTURE_MAGIC = 0x31435259; // "YRC1"
+constexpr uint32_t CAPTURE_VERSION = 2;
+
+struct CaptureFileHeader {
+    uint32_t magic = CAPTURE_MAGIC;
+    uint32_t version = CAPTURE_VERSION;
+    uint32_t frameCount = 0;
+    // GraphicsAPI do backend capturado (so informativo)
+    uint32_t sourceApi = 0;
+};
+
+enum class CaptureRecord : uint8_t {
+    DEFINE_TEXTURE,  // id, filtro, caminho
+    DEFINE_CUBEMAP,  // id, faces
+    DEFINE_MESH,     // id, vertices, normais
+    DEFINE_MATERIAL, // id, cor, shaders (vertex, fragment, vertex instanciado)
+    DEFINE_OBJECT,   // CaptureObjectData
+    SET_TRANSFORM,   // CaptureTransformData
+    SET_CAMERA,      // CaptureCameraData
+    SET_LIGHTS,      // CaptureLightData[]
+    BIND_CAMERA,
+    CLEAR,
+    RENDER_OBJECTS, // ids dos objetos visiveis, na ordem recebida
+    APPLY_MATERIAL, // id do material
+    SET_BUFFER_DATA,
+    DRAW,           // id da mesh
+    DRAW_INSTANCED, // id da mesh, matrizes
+    DRAW_SPRITE,    // CaptureSpriteData
+    DRAW_SKYBOX,    // ids da mesh, do material e do cubemap
+    PRESENT,
+    COUNT
+};
+
+// Objeto com mesh + material ou sprite + material (texture != 0)
+struct CaptureObjectData {
+    uint32_t id;
+    uint32_t mesh;
+    uint32_t material;
+    uint32_t texture;
+    float spriteWidth;
+    float spriteHeight;
+};
+
+struct CaptureTransformData {
+    uint32_t object;
+    // Matriz de mundo, coluna a coluna (ja inclui os pais)
+    float model[16];
+};
+
+struct CaptureCameraData {
+    float position[3];
+    float background[4];
+    float fov;
+    float nearDistance;
+    float farDistance;
+    float width;
+    float height;
+    float orthoSize;
+    uint32_t orthographic;
+};
+
+struct CaptureLightData {
+    uint32_t type;
+    float direction[3];
+    float position[3];
+    float range;
+};
+
+struct CaptureSpriteData {
+    uint32_t texture;
+    float width;
+    float height;
+};
+
+// Buffer de escrita dos registros
+class CaptureWriter {
+  private:
+    std::vector<uint8_t> data;
+    size_t recordStart = 0;
+
+  public:
+    void clear() { data.clear(); }
+    void reserve(size_t bytes) { data.reserve(bytes); }
+    size_t size() const { return data.size(); }
+    const std::vector<uint8_t>& bytes() const { return data; }
+
+    // Cada begin deve ser fechado por end, que preenche o tamanho do payload
+    void begin(CaptureRecord type);
+    void end();
+
+    void write(const void* source, size_t size);
+    template <typename T> void write(const T& value) { write(&value, sizeof(T)); }
+    void writeString(const std::string& text);
+};
+
+// Leitura com verificacao de limites; depois de um erro tudo falha
+class CaptureReader {
+  private:
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    size_t offset = 0;
+    bool failed = false;
+
+  public:
+    CaptureReader() = default;
+    CaptureReader(const uint8_t* bytes, size_t length) : data(bytes), size(length) {}
+
+    bool ok() const { return !failed; }
+    bool atEnd() const { return offset >= size; }
+    size_t getOffset() const { return offset; }
+    size_t getRemaining() const { return size - offset; }
+
+    bool read(void* destination, size_t length);
+    template <typename T> bool read(T& value) { return read(&value, sizeof(T)); }
+    bool readString(std::string& text);
+    // Aponta para length bytes dentro do buffer sem copiar
+    const uint8_t* skip(size_t length);
+    // Proximo registro: tipo e um leitor restrito ao payload
+    bool nextRecord(CaptureRecord& type, CaptureReader& payload);
+};
+
+#endif // RENDER_CAPTURE_HPP
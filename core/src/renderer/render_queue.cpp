@@ -0,0 +1,163 @@
+#include "render_queue.hpp"
+#include "../camera.hpp"
+#include "../game_object.hpp"
+#include "../material.hpp"
+#include "../mesh_renderer.hpp"
+#include <algorithm>
+#include <cassert>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace {
+constexpr uint32_t DEPTH_BITS = 20;
+constexpr uint32_t DEPTH_MAX = (1u << DEPTH_BITS) - 1;
+constexpr uint32_t ID_BITS = 13;
+constexpr uint32_t ID_MAX = (1u << ID_BITS) - 1;
+// 16 faixas de profundidade para opacos
+constexpr uint32_t OPAQUE_DEPTH_SHIFT = DEPTH_BITS - 4;
+} // namespace
+
+uint64_t RenderQueue::makeKey(RenderPass pass, bool translucent, float depth01,
+                              uint32_t programId, uint32_t materialId, uint32_t meshId) {
+    assert(programId <= ID_MAX && materialId <= ID_MAX && meshId <= ID_MAX);
+    float clamped = std::min(std::max(depth01, 0.0f), 1.0f);
+    uint32_t depth = static_cast<uint32_t>(clamped * DEPTH_MAX);
+
+    if (translucent) {
+        depth = DEPTH_MAX - depth;
+    } else {
+        depth = (depth >> OPAQUE_DEPTH_SHIFT) << OPAQUE_DEPTH_SHIFT;
+    }
+
+    return (static_cast<uint64_t>(static_cast<uint8_t>(pass) & 0xF) << 60) |
+           (static_cast<uint64_t>(translucent ? 1 : 0) << 59) |
+           (static_cast<uint64_t>(depth) << (ID_BITS * 3)) |
+           (static_cast<uint64_t>(programId & ID_MAX) << (ID_BITS * 2)) |
+           (static_cast<uint64_t>(materialId & ID_MAX) << ID_BITS) |
+           static_cast<uint64_t>(meshId & ID_MAX);
+}
+
+uint32_t RenderQueue::denseId(std::unordered_map<uint32_t, uint32_t>& ids, uint32_t id,
+                              uint32_t maxId, bool& overflow) {
+    uint32_t dense = ids.emplace(id, static_cast<uint32_t>(ids.size())).first->second;
+    if (dense > maxId) {
+        overflow = true;
+        return maxId;
+    }
+    return dense;
+}
+
+void RenderQueue::clear() {
+    items.clear();
+    entries.clear();
+}
+
+void RenderQueue::reserve(size_t count) {
+    items.reserve(count);
+    entries.reserve(count);
+    scratch.reserve(count);
+}
+
+void RenderQueue::submit(const RenderItem& item, uint64_t key) {
+    entries.push_back({key, static_cast<uint32_t>(items.size())});
+    items.push_back(item);
+}
+
+void RenderQueue::sort() {
+    const size_t count = entries.size();
+    if (count < 2) {
+        return;
+    }
+
+    scratch.resize(count);
+    SortEntry* src = entries.data();
+    SortEntry* dst = scratch.data();
+
+    for (uint32_t shift = 0; shift < 64; shift += 8) {
+        size_t histogram[256] = {};
+        for (size_t i = 0; i < count; i++) {
+            histogram[(src[i].key >> shift) & 0xFF]++;
+        }
+
+        // Todas as chaves com o mesmo byte: a passada nao muda nada
+        if (histogram[(src[0].key >> shift) & 0xFF] == count) {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (size_t& bucket : histogram) {
+            size_t n = bucket;
+            bucket = offset;
+            offset += n;
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            dst[histogram[(src[i].key >> shift) & 0xFF]++] = src[i];
+        }
+        std::swap(src, dst);
+    }
+
+    if (src != entries.data()) {
+        std::copy(src, src + count, entries.data());
+    }
+}
+
+void RenderQueue::build(const std::vector<GameObject*>& gameObjects, const Camera* camera) {
+    clear();
+    reserve(gameObjects.size());
+    densePrograms.clear();
+    denseMaterials.clear();
+    denseMeshes.clear();
+    idOverflows = 0;
+
+    glm::vec3 camPos(0.0f);
+    float farDistance = 100.0f;
+    if (camera) {
+        auto& pos = camera->getPosition();
+        camPos = {pos.x, pos.y, pos.z};
+        farDistance = camera->getFarDistance();
+    }
+
+    for (const auto go : gameObjects) {
+        RenderItem item;
+        if (go->hasSprite() && go->hasSpriteRenderer()) {
+            item.sprite = go->getSprite();
+            item.material = go->getSpriteRenderer()->getMaterial();
+        } else if (go->hasMesh() && go->hasMeshRenderer()) {
+            item.mesh = go->getMesh();
+            item.material = go->getMeshRenderer()->getMaterial();
+        }
+
+        // Programas ainda compilando no driver sao pulados neste frame
+        if (!item.material || !item.material->isReady()) {
+            continue;
+        }
+
+        if (go->getTransform()) {
+            item.model = go->getTransform()->getModelMatrix();
+        }
+        if (item.sprite) {
+            item.model = glm::scale(item.model, glm::vec3(item.sprite->getWidth(),
+                                                          item.sprite->getHeight(), 1.0f));
+        }
+
+        // Sprites usam alpha da textura, entao sao tratados como translucidos
+        bool translucent = item.sprite || item.material->isTranslucent();
+        float depth = glm::length(glm::vec3(item.model[3]) - camPos) / farDistance;
+        uint32_t meshId = item.mesh ? item.mesh->getId() : 0;
+
+        bool overflow = false;
+        uint32_t programId =
+            denseId(densePrograms, item.material->getShaderProgram()->getId(), ID_MAX, overflow);
+        uint32_t materialId = denseId(denseMaterials, item.material->getId(), ID_MAX, overflow);
+        uint32_t denseMeshId = denseId(denseMeshes, meshId, ID_MAX, overflow);
+        if (overflow) {
+            idOverflows++;
+        }
+
+        uint64_t key =
+            makeKey(RenderPass::MAIN, translucent, depth, programId, materialId, denseMeshId);
+        submit(item, key);
+    }
+
+    sort();
+}
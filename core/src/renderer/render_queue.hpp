@@ -0,0 +1,78 @@
+#ifndef RENDER_QUEUE_HPP
+#define RENDER_QUEUE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <unordered_map>
+#include <vector>
+
+class Camera;
+class GameObject;
+class Material;
+class Mesh;
+class Sprite;
+
+enum class RenderPass : uint8_t { MAIN = 0 };
+
+struct RenderItem {
+    Material* material = nullptr;
+    const Mesh* mesh = nullptr;
+    const Sprite* sprite = nullptr;
+    glm::mat4 model = glm::mat4(1.0f);
+};
+
+// Fila de desenho ordenada por chave de 64 bits (do bit mais alto para o mais baixo):
+//   pass (4) | translucido (1) | profundidade (20) | programa (13) | material (13) | mesh (13)
+// Opacos usam profundidade em faixas grossas (frente para tras, mas sem quebrar a
+// ordenacao por estado); translucidos usam a profundidade completa, de tras para frente.
+// build() troca os ids de programa, material e mesh (nunca reciclados) por ids densos
+// do frame, na ordem em que aparecem, para caberem nos campos sem colidir. Ids alem
+// da largura do campo ficam presos no maior valor e sao contados em getIdOverflows().
+// makeKey espera ids que ja cabem nos campos (assert em debug).
+class RenderQueue {
+  private:
+    struct SortEntry {
+        uint64_t key;
+        uint32_t index;
+    };
+
+    std::vector<RenderItem> items;
+    std::vector<SortEntry> entries;
+    std::vector<SortEntry> scratch;
+
+    // id global -> id denso do frame; limpos a cada build, mantem a memoria
+    std::unordered_map<uint32_t, uint32_t> densePrograms;
+    std::unordered_map<uint32_t, uint32_t> denseMaterials;
+    std::unordered_map<uint32_t, uint32_t> denseMeshes;
+    uint32_t idOverflows = 0;
+
+    // Preso em maxId; marca overflow se o id denso nao couber
+    static uint32_t denseId(std::unordered_map<uint32_t, uint32_t>& ids, uint32_t id,
+                            uint32_t maxId, bool& overflow);
+
+  public:
+    static uint64_t makeKey(RenderPass pass, bool translucent, float depth01, uint32_t programId,
+                            uint32_t materialId, uint32_t meshId);
+
+    void clear();
+    void reserve(size_t count);
+    void submit(const RenderItem& item, uint64_t key);
+    // Limpa a fila, submete os objetos com material pronto (sprites com a escala ja
+    // aplicada na model) e ordena. Compartilhado pelos backends.
+    void build(const std::vector<GameObject*>& gameObjects, const Camera* camera);
+
+    // Radix sort LSD, 8 bits por passada; passadas em que todas as chaves tem o
+    // mesmo byte sao puladas
+    void sort();
+
+    size_t size() const { return entries.size(); }
+    bool empty() const { return entries.empty(); }
+    // Itens do ultimo build com algum id preso no limite do campo (ordenacao por
+    // estado degradada)
+    uint32_t getIdOverflows() const { return idOverflows; }
+    uint64_t keyAt(size_t i) const { return entries[i].key; }
+    const RenderItem& operator[](size_t i) const { return items[entries[i].index]; }
+};
+
+#endif // RENDER_QUEUE_HPP
@@ -0,0 +1,453 @@
+#define CLASS_NAME "RenderReplay"
+#include "../log_macros.hpp"
+
+#include "../material.hpp"
+#include "../shader_asset.hpp"
+#include "render_replay.hpp"
+#include <chrono>
+#include <fstream>
+#include <thread>
+
+namespace {
+// Tempo maximo esperando shaders compilados de forma assincrona
+constexpr auto SHADER_READY_TIMEOUT = std::chrono::seconds(30);
+
+Vector3 toVector3(const float* values) {
+    Vector3 vector;
+    vector.x = values[0];
+    vector.y = values[1];
+    vector.z = values[2];
+    return vector;
+}
+
+bool isDefinition(CaptureRecord type) {
+    return type == CaptureRecord::DEFINE_TEXTURE || type == CaptureRecord::DEFINE_CUBEMAP ||
+           type == CaptureRecord::DEFINE_MESH || type == CaptureRecord::DEFINE_MATERIAL ||
+           type == CaptureRecord::DEFINE_OBJECT;
+}
+} // namespace
+
+bool RenderReplay::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        LOG_ERROR("Unable to open capture: " + path);
+        return false;
+    }
+
+    data.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(data.data()), data.size())) {
+        LOG_ERROR("Unable to read capture: " + path);
+        return false;
+    }
+
+    CaptureReader reader(data.data(), data.size());
+    if (!reader.read(header) || header.magic != CAPTURE_MAGIC ||
+        header.version != CAPTURE_VERSION) {
+        LOG_ERROR("Not a capture file or unsupported version: " + path);
+        return false;
+    }
+
+    definitions.clear();
+    commands.clear();
+    frameStarts.assign(1, 0);
+    while (!reader.atEnd()) {
+        Command command;
+        if (!reader.nextRecord(command.type, command.payload)) {
+            LOG_ERROR("Corrupted capture: " + path);
+            return false;
+        }
+
+        if (isDefinition(command.type)) {
+            definitions.push_back(command);
+            continue;
+        }
+        commands.push_back(command);
+        if (command.type == CaptureRecord::PRESENT) {
+            frameStarts.push_back(commands.size());
+        }
+    }
+
+    // Um frame sem PRESENT no fim (captura interrompida) e descartado
+    commands.resize(frameStarts.back());
+    LOG_INFO("Loaded " + std::to_string(getFrameCount()) + " frames from " + path);
+    return true;
+}
+
+std::unique_ptr<Material> RenderReplay::createMaterial(const MaterialDefinition& definition,
+                                                       bool instancing) {
+    // Mesma montagem do SceneLoader, com a extensao de shader do backend de destino
+    std::string shaderExt = backend->getShaderExtension();
+    auto vertexShader =
+        std::make_unique<ShaderAsset>(definition.vertexShader + shaderExt, ShaderType::VERTEX);
+    vertexShader->setShaderCompiler(backend->createShaderCompiler());
+    auto fragmentShader = std::make_unique<ShaderAsset>(definition.fragmentShader + shaderExt,
+                                                        ShaderType::FRAGMENT);
+    fragmentShader->setShaderCompiler(backend->createShaderCompiler());
+
+    auto material = std::make_unique<Material>();
+    material->setShaderProgram(backend->createShaderProgram());
+    material->setVertexShader(std::move(vertexShader));
+    material->setFragmentShader(std::move(fragmentShader));
+    material->setBaseColor(definition.color);
+
+    std::string instancedPath = definition.instancedVertexShader + shaderExt;
+    if (instancing && !definition.instancedVertexShader.empty() &&
+        std::ifstream(instancedPath).good()) {
+        auto instancedShader = std::make_unique<ShaderAsset>(instancedPath, ShaderType::VERTEX);
+        instancedShader->setShaderCompiler(backend->createShaderCompiler());
+        material->setInstancedVariant(std::move(instancedShader), backend->createShaderProgram());
+    }
+
+    if (!material->init()) {
+        LOG_WARN("Material failed to build: " + definition.vertexShader + ", " +
+                 definition.fragmentShader);
+        return nullptr;
+    }
+
+    pendingMaterials.push_back(material.get());
+    return material;
+}
+
+bool RenderReplay::createResource(const Command& command) {
+    CaptureReader payload = command.payload;
+
+    switch (command.type) {
+    case CaptureRecord::DEFINE_TEXTURE: {
+        uint32_t id = 0;
+        uint8_t filterType = 0;
+        std::string path;
+        if (!payload.read(id) || !payload.read(filterType) || !payload.readString(path)) {
+            return false;
+        }
+        textures[id] = path.empty() ? 0 : backend->loadTexture(path, filterType);
+        return true;
+    }
+
+    case CaptureRecord::DEFINE_CUBEMAP: {
+        uint32_t id = 0;
+        uint32_t count = 0;
+        if (!payload.read(id) || !payload.read(count)) {
+            return false;
+        }
+        // Cada face tem ao menos o tamanho da string: contagem maior e arquivo corrompido
+        if (count > payload.getRemaining() / sizeof(uint32_t)) {
+            return false;
+        }
+        std::vector<std::string> faces(count);
+        for (std::string& face : faces) {
+            if (!payload.readString(face)) {
+                return false;
+            }
+        }
+        textures[id] = backend->createCubemapTexture(faces);
+        return true;
+    }
+
+    case CaptureRecord::DEFINE_MESH: {
+        uint32_t id = 0;
+        uint32_t vertexCount = 0;
+        uint32_t normalCount = 0;
+        if (!payload.read(id) || !payload.read(vertexCount) || !payload.read(normalCount)) {
+            return false;
+        }
+        // Contagens do arquivo so alocam se os dados cabem no payload
+        if (vertexCount > payload.getRemaining() / sizeof(float) ||
+            normalCount > payload.getRemaining() / sizeof(float) - vertexCount) {
+            return false;
+        }
+        std::vector<float> vertices(vertexCount);
+        std::vector<float> normals(normalCount);
+        if (!payload.read(vertices.data(), vertexCount * sizeof(float)) ||
+            !payload.read(normals.data(), normalCount * sizeof(float))) {
+            return false;
+        }
+
+        auto mesh = std::make_shared<Mesh>();
+        mesh->setVertices(vertices);
+        mesh->setNormals(normals);
+        mesh->setMeshBuffer(backend->createMeshBuffer());
+        if (!mesh->configure()) {
+            LOG_WARN("Mesh " + std::to_string(id) + " failed to configure");
+        }
+        meshes[id] = mesh;
+        return true;
+    }
+
+    case CaptureRecord::DEFINE_MATERIAL: {
+        uint32_t id = 0;
+        MaterialDefinition definition;
+        if (!payload.read(id) || !payload.read(definition.color.v, sizeof(float) * 4) ||
+            !payload.readString(definition.vertexShader) ||
+            !payload.readString(definition.fragmentShader) ||
+            !payload.readString(definition.instancedVertexShader)) {
+            return false;
+        }
+        materialDefinitions[id] = definition;
+        materials[id] = createMaterial(definition, true);
+        return true;
+    }
+
+    case CaptureRecord::DEFINE_OBJECT: {
+        CaptureObjectData objectData;
+        // Ids sao sequenciais a partir de 1, um por DEFINE_OBJECT (objects ja tem o
+        // tamanho certo, ver createResources)
+        if (!payload.read(objectData) || objectData.id == 0 || objectData.id >= objects.size()) {
+            return false;
+        }
+
+        auto gameObject = std::make_unique<GameObject>();
+        gameObject->setTransform(std::make_unique<Transform>());
+
+        auto definition = materialDefinitions.find(objectData.material);
+        if (objectData.mesh == 0 && definition != materialDefinitions.end()) {
+            // Como no SceneLoader, cada sprite tem o proprio material, sem instancing
+            auto sprite = std::make_unique<Sprite>(objectData.spriteWidth, objectData.spriteHeight);
+            sprite->setTexture(findTexture(objectData.texture));
+            auto spriteRenderer = std::make_unique<SpriteRenderer>();
+            spriteRenderer->setMaterial(createMaterial(definition->second, false));
+            gameObject->setSprite(std::move(sprite));
+            gameObject->setSpriteRenderer(std::move(spriteRenderer));
+        } else if (objectData.mesh != 0) {
+            auto mesh = meshes.find(objectData.mesh);
+            auto material = materials.find(objectData.material);
+            if (mesh != meshes.end() && material != materials.end() && material->second) {
+                gameObject->setMesh(mesh->second);
+                auto meshRenderer = std::make_unique<MeshRenderer>();
+                meshRenderer->setMaterial(material->second);
+                gameObject->setMeshRenderer(std::move(meshRenderer));
+            }
+        }
+
+        objects[objectData.id] = std::move(gameObject);
+        return true;
+    }
+
+    default:
+        return false;
+    }
+}
+
+bool RenderReplay::createResources(RendererBackend& rendererBackend) {
+    backend = &rendererBackend;
+    pendingMaterials.clear();
+
+    size_t objectCount = 0;
+    for (const Command& command : definitions) {
+        if (command.type == CaptureRecord::DEFINE_OBJECT) {
+            objectCount++;
+        }
+    }
+    objects.clear();
+    objects.resize(objectCount + 1);
+
+    for (const Command& command : definitions) {
+        if (!createResource(command)) {
+            LOG_ERROR("Corrupted resource definition in capture");
+            return false;
+        }
+    }
+
+    // Compilacao assincrona: o primeiro frame medido ja deve desenhar tudo
+    auto deadline = std::chrono::steady_clock::now() + SHADER_READY_TIMEOUT;
+    for (Material* material : pendingMaterials) {
+        while (!material->isReady() && !material->hasFailed() &&
+               std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    pendingMaterials.clear();
+    return true;
+}
+
+Mesh* RenderReplay::findMesh(uint32_t id) {
+    auto it = meshes.find(id);
+    return it != meshes.end() ? it->second.get() : nullptr;
+}
+
+Material* RenderReplay::findMaterial(uint32_t id) {
+    auto it = materials.find(id);
+    return it != materials.end() ? it->second.get() : nullptr;
+}
+
+unsigned int RenderReplay::findTexture(uint32_t id) {
+    auto it = textures.find(id);
+    return it != textures.end() ? it->second : 0;
+}
+
+void RenderReplay::applyCamera(const CaptureCameraData& cameraData) {
+    camera.setPosition(toVector3(cameraData.position));
+    camera.setBackgroundColor({cameraData.background[0], cameraData.background[1],
+                               cameraData.background[2], cameraData.background[3]});
+    camera.setFov(cameraData.fov);
+    camera.setNearDistance(cameraData.nearDistance);
+    camera.setFarDistance(cameraData.farDistance);
+    camera.setViewRect(cameraData.width, cameraData.height);
+    camera.setOrthoSize(cameraData.orthoSize);
+    camera.setOrthographic(cameraData.orthographic != 0);
+}
+
+bool RenderReplay::getViewport(int& width, int& height) const {
+    for (const Command& command : commands) {
+        CaptureReader payload = command.payload;
+        CaptureCameraData cameraData;
+        if (command.type == CaptureRecord::SET_CAMERA && payload.read(cameraData)) {
+            width = static_cast<int>(cameraData.width);
+            height = static_cast<int>(cameraData.height);
+            return width > 0 && height > 0;
+        }
+    }
+    return false;
+}
+
+void RenderReplay::playFrame(size_t frame, SDL_Window* window) {
+    if (!backend || frame >= getFrameCount()) {
+        return;
+    }
+
+    for (size_t i = frameStarts[frame]; i < frameStarts[frame + 1]; i++) {
+        CaptureReader payload = commands[i].payload;
+
+        switch (commands[i].type) {
+        case CaptureRecord::SET_TRANSFORM: {
+            CaptureTransformData transformData;
+            if (payload.read(transformData) && transformData.object < objects.size() &&
+                objects[transformData.object]) {
+                glm::mat4 model;
+                std::memcpy(&model[0][0], transformData.model, sizeof(transformData.model));
+                objects[transformData.object]->getTransform()->setLocalMatrix(model);
+            }
+            break;
+        }
+
+        case CaptureRecord::SET_CAMERA: {
+            CaptureCameraData cameraData;
+            if (payload.read(cameraData)) {
+                applyCamera(cameraData);
+            }
+            break;
+        }
+
+        case CaptureRecord::SET_LIGHTS: {
+            uint32_t count = 0;
+            payload.read(count);
+            lights.clear();
+            CaptureLightData lightData;
+            for (uint32_t light = 0; light < count && payload.read(lightData); light++) {
+                Light sceneLight;
+                sceneLight.type = static_cast<LightType>(lightData.type);
+                sceneLight.direction = toVector3(lightData.direction);
+                sceneLight.position = toVector3(lightData.position);
+                sceneLight.range = lightData.range;
+                lights.push_back(sceneLight);
+            }
+            break;
+        }
+
+        case CaptureRecord::BIND_CAMERA:
+            backend->bindCamera(&camera);
+            break;
+
+        case CaptureRecord::CLEAR:
+            backend->clear(&camera);
+            break;
+
+        case CaptureRecord::RENDER_OBJECTS: {
+            uint32_t count = 0;
+            payload.read(count);
+            visibleObjects.clear();
+            uint32_t id = 0;
+            for (uint32_t object = 0; object < count && payload.read(id); object++) {
+                if (id < objects.size() && objects[id]) {
+                    visibleObjects.push_back(objects[id].get());
+                }
+            }
+            backend->renderGameObjects(&visibleObjects, &lights);
+            break;
+        }
+
+        case CaptureRecord::APPLY_MATERIAL: {
+            uint32_t id = 0;
+            if (payload.read(id)) {
+                if (Material* material = findMaterial(id)) {
+                    backend->applyMaterial(material);
+                }
+            }
+            break;
+        }
+
+        case CaptureRecord::SET_BUFFER_DATA: {
+            std::string name;
+            uint32_t size = 0;
+            const uint8_t* bytes = nullptr;
+            if (payload.readString(name) && payload.read(size) && (bytes = payload.skip(size))) {
+                backend->setBufferDataImpl(name, bytes, size);
+            }
+            break;
+        }
+
+        case CaptureRecord::DRAW: {
+            uint32_t id = 0;
+            if (payload.read(id)) {
+                if (Mesh* mesh = findMesh(id)) {
+                    backend->draw(*mesh);
+                }
+            }
+            break;
+        }
+
+        case CaptureRecord::DRAW_INSTANCED: {
+            uint32_t id = 0;
+            uint32_t count = 0;
+            if (!payload.read(id) || !payload.read(count)) {
+                break;
+            }
+            if (count > payload.getRemaining() / sizeof(glm::mat4)) {
+                break;
+            }
+            // Copia: o payload nao tem o alinhamento de glm::mat4
+            instanceModels.resize(count);
+            Mesh* mesh = findMesh(id);
+            if (mesh && payload.read(instanceModels.data(), count * sizeof(glm::mat4))) {
+                backend->drawInstanced(*mesh, instanceModels.data(), count);
+            }
+            break;
+        }
+
+        case CaptureRecord::DRAW_SPRITE: {
+            CaptureSpriteData spriteData;
+            if (payload.read(spriteData)) {
+                Sprite sprite(spriteData.width, spriteData.height);
+                sprite.setTexture(findTexture(spriteData.texture));
+                backend->drawSprite(sprite);
+            }
+            break;
+        }
+
+        case CaptureRecord::DRAW_SKYBOX: {
+            uint32_t meshId = 0;
+            uint32_t materialId = 0;
+            uint32_t textureId = 0;
+            if (!payload.read(meshId) || !payload.read(materialId) || !payload.read(textureId)) {
+                break;
+            }
+            Mesh* mesh = findMesh(meshId);
+            Material* material = findMaterial(materialId);
+            if (mesh && material && material->getShaderProgram()) {
+                material->use();
+                unsigned int program = static_cast<unsigned int>(
+                    reinterpret_cast<uintptr_t>(material->getShaderProgram()->getHandle()));
+                backend->renderSkybox(*mesh, program, findTexture(textureId));
+            }
+            break;
+        }
+
+        case CaptureRecord::PRESENT:
+            backend->present(window);
+            break;
+
+        default:
+            break;
+        }
+    }
+}
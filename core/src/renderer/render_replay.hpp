@@ -0,0 +1,76 @@
+#ifndef RENDER_REPLAY_HPP
+#define RENDER_REPLAY_HPP
+
+#include "../camera.hpp"
+#include "../game_object.hpp"
+#include "../light.hpp"
+#include "render_capture.hpp"
+#include "renderer_backend.hpp"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct SDL_Window;
+
+// Reproduz uma captura do CaptureRendererBackend em qualquer backend. Todos os
+// recursos (DEFINE_*) sao criados em createResources, antes do primeiro frame; cada
+// playFrame so repete as chamadas de um frame, entao o tempo medido e o do backend.
+class RenderReplay {
+  private:
+    struct Command {
+        CaptureRecord type;
+        CaptureReader payload;
+    };
+
+    struct MaterialDefinition {
+        ColorRGBA color;
+        std::string vertexShader;
+        std::string fragmentShader;
+        std::string instancedVertexShader;
+    };
+
+    std::vector<uint8_t> data;
+    CaptureFileHeader header;
+    std::vector<Command> definitions;
+    std::vector<Command> commands;
+    // commands[frameStarts[i], frameStarts[i + 1])
+    std::vector<size_t> frameStarts;
+
+    RendererBackend* backend = nullptr;
+    std::unordered_map<uint32_t, MaterialDefinition> materialDefinitions;
+    std::unordered_map<uint32_t, std::shared_ptr<Mesh>> meshes;
+    std::unordered_map<uint32_t, std::shared_ptr<Material>> materials;
+    std::unordered_map<uint32_t, unsigned int> textures;
+    // Indexado pelo id gravado (sequencial a partir de 1)
+    std::vector<std::unique_ptr<GameObject>> objects;
+    std::vector<Material*> pendingMaterials;
+
+    Camera camera;
+    std::vector<Light> lights;
+    std::vector<GameObject*> visibleObjects;
+    std::vector<glm::mat4> instanceModels;
+
+    std::unique_ptr<Material> createMaterial(const MaterialDefinition& definition,
+                                             bool instancing);
+    bool createResource(const Command& command);
+    Mesh* findMesh(uint32_t id);
+    Material* findMaterial(uint32_t id);
+    unsigned int findTexture(uint32_t id);
+    void applyCamera(const CaptureCameraData& cameraData);
+
+  public:
+    bool load(const std::string& path);
+    // Recria os recursos no backend e espera os shaders ficarem prontos
+    bool createResources(RendererBackend& backend);
+
+    size_t getFrameCount() const { return frameStarts.empty() ? 0 : frameStarts.size() - 1; }
+    GraphicsAPI getSourceApi() const { return static_cast<GraphicsAPI>(header.sourceApi); }
+    // Tamanho da camera no primeiro SET_CAMERA (tamanho da janela capturada)
+    bool getViewport(int& width, int& height) const;
+
+    // Executa as chamadas do frame, terminando em present(window)
+    void playFrame(size_t frame, SDL_Window* window = nullptr);
+};
+
+#endif // RENDER_REPLAY_HPP
@@ -0,0 +1,37 @@
+#include "render_snapshot.hpp"
+#include "../trace.hpp"
+
+void RenderSnapshot::capture(const Camera& sceneCamera, const std::vector<Light>* sceneLights,
+                             const std::vector<GameObject*>& visibleObjects,
+                             const FrustumCuller::Stats& stats) {
+    TRACE_ZONE("RenderSnapshot::capture");
+    camera = sceneCamera;
+    hasCamera = true;
+
+    hasLights = sceneLights != nullptr;
+    if (hasLights) {
+        lights = *sceneLights;
+    }
+
+    objects.clear();
+    objects.reserve(visibleObjects.size());
+    for (GameObject* source : visibleObjects) {
+        std::unique_ptr<GameObject>& proxy = proxies[source];
+        if (!proxy) {
+            proxy = std::make_unique<GameObject>();
+        }
+        proxy->copyRenderState(*source);
+        objects.push_back(proxy.get());
+    }
+    cullingStats = stats;
+}
+
+void RenderSnapshot::clear() {
+    camera = Camera();
+    hasCamera = false;
+    lights.clear();
+    hasLights = false;
+    proxies.clear();
+    objects.clear();
+    cullingStats = FrustumCuller::Stats();
+}
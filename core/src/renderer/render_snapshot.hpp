@@ -0,0 +1,48 @@
+#ifndef RENDER_SNAPSHOT_HPP
+#define RENDER_SNAPSHOT_HPP
+
+#include "../camera.hpp"
+#include "../game_object.hpp"
+#include "../light.hpp"
+#include "frustum_culler.hpp"
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Tudo que um frame precisa para ser desenhado, copiado da cena depois do culling:
+// camera, luzes e um proxy por objeto visivel com o transform daquele momento. A
+// simulacao pode alterar a cena enquanto a thread de render desenha o snapshot.
+//
+// Meshes, materiais e texturas sao compartilhados com a cena, nao copiados: so podem
+// ser destruidos com o render pausado (RenderThread::pause), que tambem limpa os snapshots.
+class RenderSnapshot {
+  private:
+    Camera camera;
+    bool hasCamera = false;
+    std::vector<Light> lights;
+    bool hasLights = false;
+    // Um proxy por objeto da cena ja visto, reaproveitado entre frames
+    std::unordered_map<const GameObject*, std::unique_ptr<GameObject>> proxies;
+    std::vector<GameObject*> objects;
+    FrustumCuller::Stats cullingStats;
+    uint64_t frameIndex = 0;
+
+  public:
+    void capture(const Camera& sceneCamera, const std::vector<Light>* sceneLights,
+                 const std::vector<GameObject*>& visibleObjects,
+                 const FrustumCuller::Stats& stats);
+    // Solta os proxies e as referencias aos recursos da cena
+    void clear();
+
+    bool isValid() const { return hasCamera; }
+    Camera* getCamera() { return hasCamera ? &camera : nullptr; }
+    std::vector<Light>* getLights() { return hasLights ? &lights : nullptr; }
+    std::vector<GameObject*>* getObjects() { return &objects; }
+    const FrustumCuller::Stats& getCullingStats() const { return cullingStats; }
+
+    void setFrameIndex(uint64_t index) { frameIndex = index; }
+    uint64_t getFrameIndex() const { return frameIndex; }
+};
+
+#endif // RENDER_SNAPSHOT_HPP
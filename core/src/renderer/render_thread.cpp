@@ -0,0 +1,170 @@
+#define CLASS_NAME "RenderThread"
+#include "../log_macros.hpp"
+
+#include "render_thread.hpp"
+#include "../job_system.hpp"
+#include "../trace.hpp"
+
+RenderThread::RenderThread(RendererBackend& backend, FrameCallback renderFrame)
+    : backend(backend), renderFrame(std::move(renderFrame)) {}
+
+RenderThread::~RenderThread() { stop(); }
+
+bool RenderThread::start() {
+    if (running) {
+        return true;
+    }
+
+    backend.releaseCurrent();
+    stopping = false;
+    started = false;
+    contextReleased = false;
+    thread = std::thread(&RenderThread::threadLoop, this);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this]() { return started || stopping; });
+    if (stopping) {
+        lock.unlock();
+        thread.join();
+        backend.makeCurrent();
+        Yume::JobSystem::shared().setMainThread();
+        LOG_WARN("Backend context cannot move to a render thread, rendering inline");
+        return false;
+    }
+    running = true;
+    LOG_INFO("Render thread started");
+    return true;
+}
+
+void RenderThread::stop() {
+    if (!running) {
+        return;
+    }
+    // Pausado, o contexto esta com a thread chamadora; a de render precisa dele para sair
+    if (paused) {
+        resume();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        writing = false;
+    }
+    wake.notify_one();
+    thread.join();
+    running = false;
+
+    backend.makeCurrent();
+    Yume::JobSystem::shared().setMainThread();
+    for (RenderSnapshot& snapshot : snapshots) {
+        snapshot.clear();
+    }
+}
+
+RenderSnapshot& RenderThread::acquireSnapshot() {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!writing) {
+        TRACE_ZONE("RenderThread::acquireSnapshot");
+        // O slot de escrita e o primeiro depois dos que estao em voo
+        done.wait(lock, [this]() { return inFlight < SNAPSHOT_COUNT; });
+        writing = true;
+    }
+    return snapshots[writeIndex];
+}
+
+void RenderThread::submitSnapshot() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!writing) {
+            return;
+        }
+        writing = false;
+        writeIndex = (writeIndex + 1) % SNAPSHOT_COUNT;
+        inFlight++;
+    }
+    wake.notify_one();
+}
+
+void RenderThread::pause() {
+    if (!running) {
+        return;
+    }
+    {
+        TRACE_ZONE("RenderThread::pause");
+        std::unique_lock<std::mutex> lock(mutex);
+        paused = true;
+        wake.notify_one();
+        done.wait(lock, [this]() { return inFlight == 0 && contextReleased; });
+        writing = false;
+    }
+
+    backend.makeCurrent();
+    Yume::JobSystem::shared().setMainThread();
+    for (RenderSnapshot& snapshot : snapshots) {
+        snapshot.clear();
+    }
+}
+
+void RenderThread::resume() {
+    if (!running) {
+        return;
+    }
+    backend.releaseCurrent();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    paused = false;
+    wake.notify_one();
+    done.wait(lock, [this]() { return !contextReleased; });
+}
+
+void RenderThread::threadLoop() {
+    Trace::setThreadName("Render");
+
+    if (!backend.makeCurrent()) {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        done.notify_all();
+        return;
+    }
+    // Jobs com afinidade de GPU seguem o contexto
+    Yume::JobSystem::shared().setMainThread();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        started = true;
+    }
+    done.notify_all();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        wake.wait(lock, [this]() {
+            return stopping || inFlight > 0 || paused != contextReleased;
+        });
+
+        // Frames pendentes primeiro: pause e stop so acontecem com a fila vazia
+        if (inFlight > 0 && !contextReleased) {
+            RenderSnapshot& snapshot = snapshots[readIndex];
+            lock.unlock();
+            renderFrame(snapshot);
+            lock.lock();
+            readIndex = (readIndex + 1) % SNAPSHOT_COUNT;
+            inFlight--;
+            done.notify_all();
+        } else if (paused && !contextReleased) {
+            backend.releaseCurrent();
+            contextReleased = true;
+            done.notify_all();
+        } else if (!paused && contextReleased) {
+            if (!backend.makeCurrent()) {
+                LOG_ERROR("Render thread lost the backend context");
+            }
+            Yume::JobSystem::shared().setMainThread();
+            contextReleased = false;
+            done.notify_all();
+        } else if (stopping) {
+            break;
+        }
+    }
+
+    if (!contextReleased) {
+        backend.releaseCurrent();
+    }
+}
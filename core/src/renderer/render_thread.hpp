@@ -0,0 +1,70 @@
+#ifndef RENDER_THREAD_HPP
+#define RENDER_THREAD_HPP
+
+#include "render_snapshot.hpp"
+#include "renderer_backend.hpp"
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// Thread dona do contexto da API. A simulacao escreve o frame N+1 num snapshot
+// enquanto esta thread desenha e apresenta o frame N; com SNAPSHOT_COUNT buffers a
+// simulacao fica no maximo dois frames a frente e depois espera um slot livre.
+//
+// Criar ou destruir recursos do backend (carregar cena) so entre pause() e resume():
+// pause espera os frames pendentes, traz o contexto para a thread chamadora e limpa
+// os snapshots, que guardam referencias aos recursos da cena.
+class RenderThread {
+  public:
+    static constexpr size_t SNAPSHOT_COUNT = 3;
+    // Desenha e apresenta um snapshot, na thread de render
+    using FrameCallback = std::function<void(RenderSnapshot&)>;
+
+  private:
+    RendererBackend& backend;
+    FrameCallback renderFrame;
+    RenderSnapshot snapshots[SNAPSHOT_COUNT];
+
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    // snapshots[readIndex] e os inFlight seguintes foram enviados e nao terminaram
+    size_t readIndex = 0;
+    size_t writeIndex = 0;
+    size_t inFlight = 0;
+    bool writing = false;
+    bool paused = false;
+    bool contextReleased = false;
+    bool stopping = false;
+    bool started = false;
+    bool running = false;
+
+    void threadLoop();
+
+  public:
+    RenderThread(RendererBackend& backend, FrameCallback renderFrame);
+    ~RenderThread();
+
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+
+    // Passa o contexto para a nova thread; false (e tudo continua na thread
+    // chamadora) se o backend nao conseguir troca-lo
+    bool start();
+    // Termina os frames pendentes e devolve o contexto a thread chamadora
+    void stop();
+    bool isRunning() const { return running; }
+
+    // Snapshot a ser preenchido para o proximo frame; espera se todos estao em uso
+    RenderSnapshot& acquireSnapshot();
+    // Envia o snapshot adquirido para ser desenhado
+    void submitSnapshot();
+
+    void pause();
+    void resume();
+};
+
+#endif // RENDER_THREAD_HPP
@@ -6,6 +6,11 @@
 #include "../log_macros.hpp"
 #include "renderer_factory.hpp"
 #include "renderer.hpp"
+#include "../engine_stats.hpp"
+#include "../job_system.hpp"
+#include "../memory_tracker.hpp"
+#include "../trace.hpp"
+#include <algorithm>
 #include <cstdint>
 #include <cstdio>
 
@@ -20,6 +25,7 @@ void Renderer::setRendererBackend(RendererBackend* backend) { this->backend = ba
 RendererBackend* Renderer::getRendererBackend() { return backend; }
 
 bool Renderer::initBackend(const GraphicsAPI& graphicsApi) {
+    MEMORY_SCOPE(MemoryTag::RENDERER);
     backend = RendererFactory::create(graphicsApi);
     if (!backend) {
         LOG_ERROR("Unsupported graphics API!");
@@ -30,6 +36,7 @@ bool Renderer::initBackend(const GraphicsAPI& graphicsApi) {
 }
 
 bool Renderer::initWindow(SDL_Window* win) {
+    MEMORY_SCOPE(MemoryTag::RENDERER);
     if (backend) {
         return backend->init(win);
     }
@@ -37,7 +44,21 @@ bool Renderer::initWindow(SDL_Window* win) {
     return false;
 }
 
+bool Renderer::initHeadless(int width, int height) {
+    MEMORY_SCOPE(MemoryTag::RENDERER);
+    if (backend) {
+        return backend->initHeadless(width, height);
+    }
+
+    return false;
+}
+
 void Renderer::render(const Scene& scene) {
+    TRACE_ZONE("Renderer::render");
+    MEMORY_SCOPE(MemoryTag::RENDERER);
+    MEMORY_RENDER_LOOP();
+    // Uploads e outros jobs que precisam do contexto grafico
+    Yume::JobSystem::shared().runMainThreadJobs();
 
     if (!backend) {
         LOG_ERROR("Can not render without a renderer backend!");
@@ -53,16 +74,163 @@ void Renderer::render(const Scene& scene) {
 
     backend->bindCamera(scene.getCamera());
 
-    backend->clear(scene.getCamera());
+    {
+        TRACE_ZONE("RendererBackend::clear");
+        backend->clear(scene.getCamera());
+    }
+
+    cullGameObjects(scene);
+    selectLights(scene);
+    publishCullingStats(cullingStats);
+
+    TRACE_ZONE("RendererBackend::renderGameObjects");
+    backend->renderGameObjects(&visibleObjects, getFrameLights(scene));
+}
+
+void Renderer::buildSnapshot(const Scene& scene, RenderSnapshot& snapshot) {
+    TRACE_ZONE("Renderer::buildSnapshot");
+    MEMORY_SCOPE(MemoryTag::RENDERER);
+
+    if (!scene.getCamera()) {
+        LOG_WARN("Scene doesn't have a main camera to render!");
+        snapshot.clear();
+        return;
+    }
+
+    cullGameObjects(scene);
+    selectLights(scene);
+    snapshot.capture(*scene.getCamera(), getFrameLights(scene), visibleObjects, cullingStats);
+}
+
+void Renderer::render(RenderSnapshot& snapshot) {
+    TRACE_ZONE("Renderer::render");
+    MEMORY_SCOPE(MemoryTag::RENDERER);
+    MEMORY_RENDER_LOOP();
+    // Uploads e outros jobs que precisam do contexto grafico
+    Yume::JobSystem::shared().runMainThreadJobs();
+
+    if (!backend) {
+        LOG_ERROR("Can not render without a renderer backend!");
+        return;
+    }
+    if (!snapshot.isValid()) {
+        return;
+    }
+
+    backend->bindCamera(snapshot.getCamera());
+
+    {
+        TRACE_ZONE("RendererBackend::clear");
+        backend->clear(snapshot.getCamera());
+    }
+
+    // Os contadores do frame pertencem a thread que chama present
+    publishCullingStats(snapshot.getCullingStats());
+
+    TRACE_ZONE("RendererBackend::renderGameObjects");
+    backend->renderGameObjects(snapshot.getObjects(), snapshot.getLights());
+}
+
+void Renderer::cullGameObjects(const Scene& scene) {
+    TRACE_ZONE("Renderer::cullGameObjects");
+    const Camera& camera = *scene.getCamera();
+    glm::mat4 viewProjection = camera.getProjectionMatrix() * camera.getViewMatrix();
+    SceneBVH& spatialIndex = scene.getSpatialIndex();
+
+    // A BVH descarta subarvores inteiras; as folhas que sobram passam pelo teste SIMD
+    // com as caixas justas
+    glm::vec4 planes[6];
+    FrustumCuller::extractPlanes(viewProjection, planes);
+    spatialIndex.queryFrustum(planes, candidateProxies);
+
+    culler.clear();
+    culler.reserve(candidateProxies.size());
+    for (int32_t proxy : candidateProxies) {
+        culler.add(spatialIndex.getTightBounds(proxy), spatialIndex.getBoundingSphere(proxy));
+    }
+    culler.cull(viewProjection, visibleIndices);
+
+    visibleObjects.clear();
+    visibleObjects.reserve(visibleIndices.size());
+    for (uint32_t index : visibleIndices) {
+        visibleObjects.push_back(spatialIndex.getObject(candidateProxies[index]));
+    }
+
+    // Interiores: o que sobrou do frustum ainda pode estar atras de paredes
+    occlusionCuller.cull(viewProjection, visibleObjects);
+
+    // O occlusion culling mantem a ordem, entao os sobreviventes aparecem na mesma
+    // sequencia dos candidatos
+    if (++visibilityStamp == 0) {
+        visibilityStamp = 1;
+    }
+    size_t next = 0;
+    for (uint32_t index : visibleIndices) {
+        int32_t proxy = candidateProxies[index];
+        if (next < visibleObjects.size() && visibleObjects[next] == spatialIndex.getObject(proxy)) {
+            spatialIndex.markVisible(proxy, visibilityStamp);
+            next++;
+        }
+    }
+
+    cullingStats.tested = spatialIndex.getProxyCount();
+    cullingStats.visible = static_cast<uint32_t>(visibleObjects.size());
+    cullingStats.culled = cullingStats.tested - cullingStats.visible;
+}
+
+void Renderer::selectLights(const Scene& scene) {
+    TRACE_ZONE("Renderer::selectLights");
+    frameLights.clear();
+    if (!scene.getLights()) {
+        return;
+    }
+
+    // Os backends sombreiam com a primeira luz quando ela e direcional: as direcionais
+    // vem antes para essa escolha nao mudar com a camera
+    for (const Light& light : *scene.getLights()) {
+        if (light.type == LightType::DIRECTIONAL) {
+            frameLights.push_back(light);
+        }
+    }
+
+    // Pontuais e spots sem nenhum objeto visivel no alcance nao vao para o backend
+    const SceneBVH& spatialIndex = scene.getSpatialIndex();
+    for (const Light& light : *scene.getLights()) {
+        if (light.type == LightType::DIRECTIONAL) {
+            continue;
+        }
+        scene.queryLitProxies(light, litProxies);
+        bool reachesVisible =
+            std::any_of(litProxies.begin(), litProxies.end(), [&](int32_t proxy) {
+                return spatialIndex.isVisible(proxy, visibilityStamp);
+            });
+        if (reachesVisible) {
+            frameLights.push_back(light);
+        }
+    }
+}
+
+std::vector<Light>* Renderer::getFrameLights(const Scene& scene) {
+    return scene.getLights() ? &frameLights : nullptr;
+}
+
+void Renderer::publishCullingStats(const FrustumCuller::Stats& stats) {
+    TRACE_COUNTER("visible objects", stats.visible);
 
-    backend->renderGameObjects(const_cast<std::vector<GameObject*>*>(scene.getGameObjects()),
-                               const_cast<std::vector<Light>*>(scene.getLights()));
+    FrameStats& frameStats = EngineStats::current();
+    frameStats.objectsTested = stats.tested;
+    frameStats.objectsVisible = stats.visible;
+    frameStats.objectsCulled = stats.culled;
 }
 
 void Renderer::present(SDL_Window* window) {
+    TRACE_ZONE("Renderer::present");
+    MEMORY_SCOPE(MemoryTag::RENDERER);
+    MEMORY_RENDER_LOOP();
     if (backend) {
         backend->present(window);
     }
+    EngineStats::endFrame();
 }
 
 //deprecated
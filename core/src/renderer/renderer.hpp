@@ -4,7 +4,11 @@
 #include "../game_object.hpp"
 #include "../graphics_api.hpp"
 #include "../scene.hpp"
+#include "frustum_culler.hpp"
+#include "occlusion_culler.hpp"
+#include "render_snapshot.hpp"
 #include "renderer_backend.hpp"
+#include <vector>
 
 class Material;
 
@@ -12,16 +16,45 @@ class Renderer{
 private: 
     RendererBackend* backend = nullptr;
 
+    // Lista de objetos visiveis que os backends recebem em renderGameObjects
+    FrustumCuller culler;
+    FrustumCuller::Stats cullingStats;
+    OcclusionCuller occlusionCuller;
+    std::vector<int32_t> candidateProxies;
+    std::vector<uint32_t> visibleIndices;
+    std::vector<GameObject*> visibleObjects;
+    // Direcionais primeiro, depois pontuais e spots que alcancam algum objeto visivel;
+    // ordem da cena dentro de cada grupo
+    std::vector<Light> frameLights;
+    std::vector<int32_t> litProxies;
+    // Marca as folhas da BVH visiveis no quadro atual
+    uint32_t visibilityStamp = 0;
+
+    void cullGameObjects(const Scene& scene);
+    void selectLights(const Scene& scene);
+    std::vector<Light>* getFrameLights(const Scene& scene);
+    void publishCullingStats(const FrustumCuller::Stats& stats);
+
 public:
     ~Renderer();
     void setRendererBackend(RendererBackend* backend);
     RendererBackend* getRendererBackend();
     bool initBackend(const GraphicsAPI& graphicsApi);
     bool initWindow(SDL_Window* win);
+    bool initHeadless(int width, int height);
     void preRender();
     void render(const std::vector<GameObject*>* objects);
     void render(const Scene& scene);
+    // Com a thread de render: culling e copia na thread da simulacao, desenho na de render
+    void buildSnapshot(const Scene& scene, RenderSnapshot& snapshot);
+    void render(RenderSnapshot& snapshot);
     void present(SDL_Window* window);
+
+    // Contadores do ultimo render(scene)
+    // tested conta todos os objetos do indice, inclusive os descartados pela BVH
+    const FrustumCuller::Stats& getCullingStats() const { return cullingStats; }
+    const OcclusionCuller::Stats& getOcclusionStats() const { return occlusionCuller.getStats(); }
+    OcclusionCuller& getOcclusionCuller() { return occlusionCuller; }
 };
 
 #endif // RENDERER_HPP
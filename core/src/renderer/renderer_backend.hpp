@@ -8,6 +8,7 @@
 #include "../mesh.hpp"
 #include "../shader_program.hpp"
 #include "../sprite.hpp"
+#include <glm/glm.hpp>
 #include <memory>
 #include <vector>
 
@@ -26,11 +27,29 @@ class RendererBackend {
     virtual bool init() = 0;
     virtual bool init(SDL_Window* window) = 0;
     virtual void present(SDL_Window* window) = 0;
+    // Renderiza sem janela num alvo offscreen de width x height; present(nullptr)
+    // termina o frame. Backends sem suporte retornam false.
+    virtual bool initHeadless(int width, int height) { return false; }
+    // Copia o ultimo frame apresentado em RGBA8, linhas de cima para baixo
+    virtual bool readPixels(std::vector<uint8_t>& rgba, int& width, int& height) {
+        return false;
+    }
     virtual bool initWindowContext() = 0;
+    // Contexto da API na thread atual (OpenGL). A thread de render chama makeCurrent
+    // antes do primeiro frame; quem solta chama releaseCurrent antes. Backends sem
+    // afinidade de thread nao fazem nada.
+    virtual bool makeCurrent() { return true; }
+    virtual void releaseCurrent() {}
     virtual void bindCamera(Camera* camera) = 0;
     virtual void applyMaterial(Material* material) = 0;
     virtual void clear(Camera* camera) = 0;
     virtual void draw(const Mesh&) = 0;
+    // Desenha count copias da mesh com o programa instanciado atual, uma matriz model
+    // por instancia. Retorna false se o backend nao suporta instancing (o chamador
+    // deve desenhar as copias uma a uma).
+    virtual bool drawInstanced(const Mesh& mesh, const glm::mat4* models, uint32_t count) {
+        return false;
+    }
     virtual GraphicsAPI getGraphicsAPI() const = 0;
     virtual std::string getShaderExtension() const = 0;
     virtual unsigned int createCubemapTexture(const std::vector<std::string>& faces) = 0;
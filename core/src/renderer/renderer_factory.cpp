@@ -1,10 +1,12 @@
 #include "renderer_factory.hpp"
+#include "backends/null/null_renderer_backend.hpp"
 
 #ifdef PLATFORM_WEBGL
     #include "backends/webgl/web_gl_renderer_backend.hpp"
 #else
     #include "backends/opengl/open_gl_renderer_backend.hpp"
     #include "backends/vulkan/vulkan_renderer_backend.hpp"
+    #include "backends/software/software_renderer_backend.hpp"
     #ifdef _WIN32
     #include "backends/directx12/d3d12_renderer_backend.hpp"
     #endif
@@ -34,6 +36,13 @@ RendererBackend* RendererFactory::create(const GraphicsAPI& api) {
             return nullptr;
         #endif
 
+        case GraphicsAPI::SOFTWARE:
+        #ifndef PLATFORM_WEBGL
+            return new SoftwareRendererBackend();
+        #else
+            return nullptr;
+        #endif
+
         case GraphicsAPI::DIRECTX12:
         #if defined(_WIN32) && !defined(PLATFORM_WEBGL)
             return new D3D12RendererBackend();
@@ -41,6 +50,9 @@ RendererBackend* RendererFactory::create(const GraphicsAPI& api) {
             return nullptr;
         #endif
 
+        case GraphicsAPI::NONE:
+            return new NullRendererBackend();
+
         default:
             return nullptr;
     }
@@ -0,0 +1,269 @@
+#define CLASS_NAME "SamplingProfiler"
+#include "sampling_profiler.hpp"
+#include "log_macros.hpp"
+
+#ifdef __linux__
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <signal.h>
+#include <sys/syscall.h>
+#include <sys/time.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+
+namespace {
+constexpr int MAX_DEPTH = 48;
+// Frames do proprio handler e do trampolim de sinal no topo de cada pilha
+constexpr int SKIPPED_FRAMES = 2;
+
+struct Sample {
+    std::atomic<bool> ready{false};
+    pid_t threadId;
+    int depth;
+    void* frames[MAX_DEPTH];
+};
+
+// Escritos so fora do handler, com o timer parado
+std::unique_ptr<Sample[]> g_samples;
+size_t g_capacity = 0;
+std::string g_path;
+struct sigaction g_previousAction;
+
+std::atomic<bool> g_running{false};
+std::atomic<size_t> g_next{0};
+std::atomic<uint64_t> g_dropped{0};
+std::atomic<int> g_inHandler{0};
+
+// So operacoes async-signal-safe: backtrace foi chamado uma vez em start() para que
+// a glibc carregue o unwinder fora do handler
+void onProfSignal(int, siginfo_t*, void*) {
+    int savedErrno = errno;
+    // seq_cst dos dois lados (aqui e em stop): cada lado escreve e depois le a
+    // variavel do outro, e com acquire/release essa escrita e leitura podem trocar de
+    // ordem; stop() veria 0 handlers com este ainda escrevendo em g_samples
+    g_inHandler.fetch_add(1, std::memory_order_seq_cst);
+
+    if (g_running.load(std::memory_order_seq_cst)) {
+        size_t index = g_next.fetch_add(1, std::memory_order_relaxed);
+        if (index < g_capacity) {
+            Sample& sample = g_samples[index];
+            void* frames[MAX_DEPTH + SKIPPED_FRAMES];
+            int depth = backtrace(frames, MAX_DEPTH + SKIPPED_FRAMES) - SKIPPED_FRAMES;
+            sample.depth = depth > 0 ? depth : 0;
+            for (int i = 0; i < sample.depth; i++) {
+                sample.frames[i] = frames[i + SKIPPED_FRAMES];
+            }
+            sample.threadId = static_cast<pid_t>(syscall(SYS_gettid));
+            sample.ready.store(true, std::memory_order_release);
+        } else {
+            g_dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    g_inHandler.fetch_sub(1, std::memory_order_release);
+    errno = savedErrno;
+}
+
+bool setTimer(int frequencyHz) {
+    itimerval timer{};
+    if (frequencyHz > 0) {
+        timer.it_interval.tv_usec = 1000000 / frequencyHz;
+        timer.it_value = timer.it_interval;
+    }
+    return setitimer(ITIMER_PROF, &timer, nullptr) == 0;
+}
+
+std::string threadName(pid_t threadId, std::unordered_map<pid_t, std::string>& cache) {
+    auto it = cache.find(threadId);
+    if (it != cache.end()) {
+        return it->second;
+    }
+
+    std::string name;
+    std::ifstream comm("/proc/self/task/" + std::to_string(threadId) + "/comm");
+    if (!std::getline(comm, name) || name.empty()) {
+        // A thread ja terminou
+        name = "thread-" + std::to_string(threadId);
+    }
+    cache[threadId] = name;
+    return name;
+}
+
+std::string symbolName(void* address, std::unordered_map<void*, std::string>& cache) {
+    auto it = cache.find(address);
+    if (it != cache.end()) {
+        return it->second;
+    }
+
+    std::string name;
+    Dl_info info;
+    // Enderecos de retorno apontam para depois da chamada
+    if (dladdr(static_cast<char*>(address) - 1, &info) && info.dli_sname) {
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+        name = status == 0 && demangled ? demangled : info.dli_sname;
+        std::free(demangled);
+    } else {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%p", address);
+        name = buffer;
+        if (dladdr(address, &info) && info.dli_fname) {
+            const char* file = std::strrchr(info.dli_fname, '/');
+            name = std::string(file ? file + 1 : info.dli_fname) + "+" + name;
+        }
+    }
+
+    // ';' separa frames no formato folded
+    for (char& c : name) {
+        if (c == ';') {
+            c = ':';
+        }
+    }
+    cache[address] = name;
+    return name;
+}
+} // namespace
+
+namespace SamplingProfiler {
+
+bool start(const std::string& path, int frequencyHz, size_t capacity) {
+    if (g_running.load()) {
+        LOG_WARN("Sampling profiler already running, writing to " + g_path);
+        return false;
+    }
+    if (frequencyHz <= 0 || frequencyHz > 10000 || capacity == 0) {
+        LOG_ERROR("Invalid sampling profiler settings");
+        return false;
+    }
+
+    g_samples.reset(new Sample[capacity]);
+    g_capacity = capacity;
+    g_path = path;
+    g_next.store(0);
+    g_dropped.store(0);
+
+    void* warmup[1];
+    backtrace(warmup, 1);
+
+    struct sigaction action{};
+    action.sa_sigaction = onProfSignal;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(SIGPROF, &action, &g_previousAction) != 0) {
+        LOG_ERROR("Failed to install SIGPROF handler");
+        return false;
+    }
+
+    g_running.store(true, std::memory_order_release);
+    if (!setTimer(frequencyHz)) {
+        g_running.store(false);
+        sigaction(SIGPROF, &g_previousAction, nullptr);
+        LOG_ERROR("Failed to start profiling timer");
+        return false;
+    }
+
+    LOG_INFO("Sampling at " + std::to_string(frequencyHz) + " Hz to " + path);
+    return true;
+}
+
+bool stop() {
+    if (!g_running.load()) {
+        return false;
+    }
+
+    setTimer(0);
+    g_running.store(false, std::memory_order_seq_cst);
+    // Um sinal ja entregue pode estar terminando em outra thread
+    while (g_inHandler.load(std::memory_order_seq_cst) > 0) {
+        std::this_thread::yield();
+    }
+    sigaction(SIGPROF, &g_previousAction, nullptr);
+
+    bool written = writeFoldedStacks();
+    g_samples.reset();
+    g_capacity = 0;
+    return written;
+}
+
+bool isRunning() { return g_running.load(std::memory_order_relaxed); }
+
+bool writeFoldedStacks() {
+    if (!g_samples) {
+        return false;
+    }
+
+    std::unordered_map<pid_t, std::string> threadNames;
+    std::unordered_map<void*, std::string> symbols;
+    // Ordenado: o arquivo sai igual para as mesmas amostras
+    std::map<std::string, uint64_t> stacks;
+
+    size_t count = std::min(g_next.load(std::memory_order_acquire), g_capacity);
+    std::string stack;
+    for (size_t i = 0; i < count; i++) {
+        const Sample& sample = g_samples[i];
+        if (!sample.ready.load(std::memory_order_acquire)) {
+            continue;
+        }
+
+        stack = threadName(sample.threadId, threadNames);
+        for (int frame = sample.depth - 1; frame >= 0; frame--) {
+            stack += ';';
+            stack += symbolName(sample.frames[frame], symbols);
+        }
+        stacks[stack]++;
+    }
+
+    std::ofstream file(g_path);
+    if (!file) {
+        LOG_ERROR("Failed to open " + g_path);
+        return false;
+    }
+    for (const auto& entry : stacks) {
+        file << entry.first << ' ' << entry.second << '\n';
+    }
+    if (!file) {
+        LOG_ERROR("Failed to write " + g_path);
+        return false;
+    }
+
+    LOG_INFO("Wrote " + std::to_string(count) + " samples (" +
+             std::to_string(g_dropped.load()) + " dropped) to " + g_path);
+    return true;
+}
+
+size_t getSampleCount() { return std::min(g_next.load(), g_capacity); }
+
+uint64_t getDroppedSamples() { return g_dropped.load(); }
+
+} // namespace SamplingProfiler
+
+#else
+
+namespace SamplingProfiler {
+
+bool start(const std::string& path, int frequencyHz, size_t capacity) {
+    LOG_WARN("Sampling profiler is only available on Linux");
+    return false;
+}
+
+bool stop() { return false; }
+bool isRunning() { return false; }
+bool writeFoldedStacks() { return false; }
+size_t getSampleCount() { return 0; }
+uint64_t getDroppedSamples() { return 0; }
+
+} // namespace SamplingProfiler
+
+#endif
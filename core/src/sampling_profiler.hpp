@@ -0,0 +1,36 @@
+#ifndef SAMPLING_PROFILER_HPP
+#define SAMPLING_PROFILER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Profiler por amostragem (so Linux). Um timer ITIMER_PROF manda SIGPROF conforme o
+// tempo de CPU do processo, entregue a thread que esta rodando; o handler grava a
+// pilha dessa thread num buffer alocado em start(). Nao precisa de instrumentacao nem
+// de ferramenta externa: writeFoldedStacks gera o formato do flamegraph.pl / speedscope
+// (uma linha "thread;externa;...;interna contagem" por pilha distinta).
+//
+// Os nomes vem da tabela de simbolos dinamica: o executavel precisa ser linkado com
+// -rdynamic (ENABLE_EXPORTS no CMake); funcoes estaticas aparecem como endereco.
+namespace SamplingProfiler {
+
+constexpr int DEFAULT_FREQUENCY = 499;
+constexpr size_t DEFAULT_CAPACITY = 32768;
+
+// frequencyHz e por segundo de CPU do processo, somando todas as threads. Amostras
+// alem de capacity sao descartadas (getDroppedSamples).
+bool start(const std::string& path, int frequencyHz = DEFAULT_FREQUENCY,
+           size_t capacity = DEFAULT_CAPACITY);
+// Para o timer e grava o arquivo
+bool stop();
+bool isRunning();
+// Grava as amostras ate agora sem parar (ex.: por tecla)
+bool writeFoldedStacks();
+
+size_t getSampleCount();
+uint64_t getDroppedSamples();
+
+} // namespace SamplingProfiler
+
+#endif // SAMPLING_PROFILER_HPP
@@ -1,6 +1,8 @@
 #include "scene.hpp"
 
 Scene::~Scene() {
+    spatialIndex.clear();
+    detachTransforms();
     if (gameObjects) {
         for (GameObject* obj : *gameObjects) {
             delete obj;
@@ -26,9 +28,35 @@ Camera* Scene::getCamera() const {
 };
 
 void Scene::setGameObjects(std::vector<GameObject*>* gos) { 
+    detachTransforms();
     gameObjects = gos; 
+
+    spatialIndex.clear();
+    if (gameObjects) {
+        for (GameObject* obj : *gameObjects) {
+            if (obj->getTransform()) {
+                obj->getTransform()->setHierarchy(&transforms);
+            }
+        }
+        // As folhas do indice ja leem as matrizes calculadas em lote
+        transforms.update();
+        for (GameObject* obj : *gameObjects) {
+            spatialIndex.createProxy(obj);
+        }
+    }
 };
 
+void Scene::detachTransforms() {
+    transforms.clear();
+    if (gameObjects) {
+        for (GameObject* obj : *gameObjects) {
+            if (obj->getTransform()) {
+                obj->getTransform()->setHierarchy(nullptr);
+            }
+        }
+    }
+}
+
 std::vector<GameObject*>* Scene::getGameObjects() { 
     return gameObjects; 
 };
@@ -47,4 +75,52 @@ std::vector<Light>* Scene::getLights() {
 
 const std::vector<Light>* Scene::getLights() const { 
     return lights; 
-};
\ No newline at end of file
+};
+
+void Scene::updateTransforms() const {
+    transforms.update();
+}
+
+SceneBVH& Scene::getSpatialIndex() const {
+    transforms.update();
+    spatialIndex.update();
+    return spatialIndex;
+}
+
+bool Scene::raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                    RaycastHit& hit) const {
+    return getSpatialIndex().raycast(origin, direction, maxDistance, hit);
+}
+
+void Scene::queryLitObjects(const Light& light, std::vector<GameObject*>& out) const {
+    out.clear();
+
+    if (light.type == LightType::DIRECTIONAL) {
+        // Mesmo criterio das folhas do indice: so o que tem algo para desenhar
+        if (gameObjects) {
+            for (GameObject* obj : *gameObjects) {
+                if ((obj->hasMesh() && obj->hasMeshRenderer()) ||
+                    (obj->hasSprite() && obj->hasSpriteRenderer())) {
+                    out.push_back(obj);
+                }
+            }
+        }
+        return;
+    }
+
+    queryLitProxies(light, queryProxies);
+    for (int32_t proxy : queryProxies) {
+        out.push_back(spatialIndex.getObject(proxy));
+    }
+}
+
+void Scene::queryLitProxies(const Light& light, std::vector<int32_t>& out) const {
+    out.clear();
+    if (light.type == LightType::DIRECTIONAL) {
+        return;
+    }
+
+    // Spot usa a esfera do alcance inteiro; o cone fica para o shader
+    BoundingSphere reach{{light.position.x, light.position.y, light.position.z}, light.range};
+    getSpatialIndex().querySphere(reach, out);
+}
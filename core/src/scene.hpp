@@ -4,12 +4,22 @@
 #include "camera.hpp"
 #include "game_object.hpp"
 #include "light.hpp"
+#include "scene_bvh.hpp"
+#include "transform_hierarchy.hpp"
+#include <glm/glm.hpp>
+#include <vector>
 
 class Scene {
   private:
     Camera* mainCamera = nullptr;
     std::vector<GameObject*>* gameObjects = nullptr;
     std::vector<Light>* lights = nullptr;
+    // Atualizados preguicosamente pelas consultas e pelo renderer, por isso mutable
+    mutable TransformHierarchy transforms;
+    mutable SceneBVH spatialIndex;
+    mutable std::vector<int32_t> queryProxies;
+
+    void detachTransforms();
 
   public:
     ~Scene();
@@ -23,6 +33,21 @@ class Scene {
     void setLights(std::vector<Light>* l);
     std::vector<Light>* getLights();
     const std::vector<Light>* getLights() const;
+
+    // Recalcula as matrizes de mundo dos Transforms que mudaram (em lote)
+    void updateTransforms() const;
+
+    // Indice espacial sobre os objetos com mesh ou sprite; reconstruido em
+    // setGameObjects e atualizado conforme os Transforms mudam
+    SceneBVH& getSpatialIndex() const;
+    bool raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                 RaycastHit& hit) const;
+    // Objetos com mesh ou sprite ao alcance da luz (todos eles para luz direcional);
+    // out e reaproveitado entre chamadas
+    void queryLitObjects(const Light& light, std::vector<GameObject*>& out) const;
+    // Proxies do indice espacial ao alcance de uma luz pontual ou spot; vazio para
+    // direcionais
+    void queryLitProxies(const Light& light, std::vector<int32_t>& out) const;
 };
 
 #endif
\ No newline at end of file
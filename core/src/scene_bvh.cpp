@@ -0,0 +1,463 @@
+#include "scene_bvh.hpp"
+#include "game_object.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+// Margem das caixas gordas: fracao do tamanho do objeto mais um minimo absoluto
+constexpr float FAT_MARGIN_RATIO = 0.1f;
+constexpr float FAT_MARGIN_MIN = 0.1f;
+
+AABB merge(const AABB& a, const AABB& b) { return {glm::min(a.min, b.min), glm::max(a.max, b.max)}; }
+
+float area(const AABB& box) {
+    glm::vec3 d = box.max - box.min;
+    return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+bool contains(const AABB& outer, const AABB& inner) {
+    return glm::all(glm::lessThanEqual(outer.min, inner.min)) &&
+           glm::all(glm::greaterThanEqual(outer.max, inner.max));
+}
+
+bool overlaps(const AABB& a, const AABB& b) {
+    return glm::all(glm::lessThanEqual(a.min, b.max)) &&
+           glm::all(glm::greaterThanEqual(a.max, b.min));
+}
+
+bool overlaps(const AABB& box, const BoundingSphere& sphere) {
+    glm::vec3 closest = glm::clamp(sphere.center, box.min, box.max);
+    glm::vec3 d = closest - sphere.center;
+    return glm::dot(d, d) <= sphere.radius * sphere.radius;
+}
+
+enum class Containment { OUTSIDE, INTERSECTS, INSIDE };
+
+Containment classify(const AABB& box, const glm::vec4 planes[6]) {
+    glm::vec3 center = box.getCenter();
+    glm::vec3 extents = box.getExtents();
+    Containment result = Containment::INSIDE;
+
+    for (int p = 0; p < 6; p++) {
+        glm::vec3 normal(planes[p]);
+        float dist = glm::dot(normal, center) + planes[p].w;
+        float reach = glm::dot(glm::abs(normal), extents);
+        if (dist + reach < 0.0f) {
+            return Containment::OUTSIDE;
+        }
+        if (dist - reach < 0.0f) {
+            result = Containment::INTERSECTS;
+        }
+    }
+    return result;
+}
+
+// Slab test; retorna a distancia de entrada ou infinito se nao acerta
+float intersectRay(const AABB& box, const glm::vec3& origin, const glm::vec3& invDirection,
+                   float maxDistance) {
+    glm::vec3 t0 = (box.min - origin) * invDirection;
+    glm::vec3 t1 = (box.max - origin) * invDirection;
+    glm::vec3 tMin = glm::min(t0, t1);
+    glm::vec3 tMax = glm::max(t0, t1);
+
+    float enter = std::max({tMin.x, tMin.y, tMin.z, 0.0f});
+    float exit = std::min({tMax.x, tMax.y, tMax.z, maxDistance});
+    return enter <= exit ? enter : std::numeric_limits<float>::infinity();
+}
+} // namespace
+
+int32_t SceneBVH::allocateNode() {
+    if (freeList == NULL_NODE) {
+        nodes.emplace_back();
+        nodes.back().height = 0;
+        return static_cast<int32_t>(nodes.size() - 1);
+    }
+
+    int32_t id = freeList;
+    freeList = nodes[id].parent;
+    nodes[id] = Node();
+    nodes[id].height = 0;
+    return id;
+}
+
+void SceneBVH::freeNode(int32_t id) {
+    nodes[id].parent = freeList;
+    nodes[id].height = -1;
+    nodes[id].object = nullptr;
+    freeList = id;
+}
+
+void SceneBVH::fatten(int32_t leaf) {
+    Node& node = nodes[leaf];
+    glm::vec3 margin = node.tightBox.getExtents() * FAT_MARGIN_RATIO + FAT_MARGIN_MIN;
+    node.box = {node.tightBox.min - margin, node.tightBox.max + margin};
+}
+
+int32_t SceneBVH::createProxy(GameObject* object) {
+    AABB box;
+    BoundingSphere sphere;
+    if (!object || !object->getWorldBounds(box, sphere)) {
+        return NULL_NODE;
+    }
+
+    int32_t leaf = allocateNode();
+    nodes[leaf].object = object;
+    nodes[leaf].tightBox = box;
+    nodes[leaf].sphere = sphere;
+    fatten(leaf);
+    insertLeaf(leaf);
+    proxyCount++;
+
+    if (object->getTransform()) {
+        object->getTransform()->setObserver(this, leaf);
+    }
+    return leaf;
+}
+
+void SceneBVH::destroyProxy(int32_t proxy) {
+    GameObject* object = nodes[proxy].object;
+    if (object && object->getTransform()) {
+        object->getTransform()->setObserver(nullptr, NULL_NODE);
+    }
+
+    // Entradas pendentes de um proxy destruido seriam lidas como outro objeto
+    if (nodes[proxy].queued) {
+        dirtyProxies.erase(std::remove(dirtyProxies.begin(), dirtyProxies.end(), proxy),
+                           dirtyProxies.end());
+    }
+
+    removeLeaf(proxy);
+    freeNode(proxy);
+    proxyCount--;
+}
+
+void SceneBVH::clear() {
+    for (auto& node : nodes) {
+        if (node.height == 0 && node.object && node.object->getTransform()) {
+            node.object->getTransform()->setObserver(nullptr, NULL_NODE);
+        }
+    }
+    nodes.clear();
+    dirtyProxies.clear();
+    root = NULL_NODE;
+    freeList = NULL_NODE;
+    proxyCount = 0;
+}
+
+void SceneBVH::onTransformChanged(int32_t proxy) {
+    if (!nodes[proxy].queued) {
+        nodes[proxy].queued = true;
+        dirtyProxies.push_back(proxy);
+    }
+}
+
+void SceneBVH::update() {
+    for (int32_t proxy : dirtyProxies) {
+        Node& node = nodes[proxy];
+        node.queued = false;
+        if (!node.object->getWorldBounds(node.tightBox, node.sphere)) {
+            continue;
+        }
+
+        // Ainda dentro da caixa gorda: a arvore nao muda
+        if (contains(node.box, node.tightBox)) {
+            continue;
+        }
+
+        removeLeaf(proxy);
+        fatten(proxy);
+        insertLeaf(proxy);
+    }
+    dirtyProxies.clear();
+}
+
+void SceneBVH::insertLeaf(int32_t leaf) {
+    if (root == NULL_NODE) {
+        root = leaf;
+        nodes[root].parent = NULL_NODE;
+        return;
+    }
+
+    // Desce escolhendo o filho que menos aumenta a area total
+    AABB leafBox = nodes[leaf].box;
+    int32_t index = root;
+    while (!nodes[index].isLeaf()) {
+        int32_t left = nodes[index].left;
+        int32_t right = nodes[index].right;
+
+        float nodeArea = area(nodes[index].box);
+        float combinedArea = area(merge(nodes[index].box, leafBox));
+        // Custo de criar um novo pai aqui e custo herdado por descer
+        float cost = 2.0f * combinedArea;
+        float inheritance = 2.0f * (combinedArea - nodeArea);
+
+        auto descendCost = [&](int32_t child) {
+            AABB merged = merge(leafBox, nodes[child].box);
+            if (nodes[child].isLeaf()) {
+                return area(merged) + inheritance;
+            }
+            return area(merged) - area(nodes[child].box) + inheritance;
+        };
+        float costLeft = descendCost(left);
+        float costRight = descendCost(right);
+
+        if (cost < costLeft && cost < costRight) {
+            break;
+        }
+        index = costLeft < costRight ? left : right;
+    }
+
+    int32_t sibling = index;
+    int32_t oldParent = nodes[sibling].parent;
+    int32_t newParent = allocateNode();
+    nodes[newParent].parent = oldParent;
+    nodes[newParent].box = merge(leafBox, nodes[sibling].box);
+    nodes[newParent].height = nodes[sibling].height + 1;
+    nodes[newParent].left = sibling;
+    nodes[newParent].right = leaf;
+    nodes[sibling].parent = newParent;
+    nodes[leaf].parent = newParent;
+
+    if (oldParent == NULL_NODE) {
+        root = newParent;
+    } else if (nodes[oldParent].left == sibling) {
+        nodes[oldParent].left = newParent;
+    } else {
+        nodes[oldParent].right = newParent;
+    }
+
+    refitUpwards(nodes[leaf].parent);
+}
+
+void SceneBVH::removeLeaf(int32_t leaf) {
+    if (leaf == root) {
+        root = NULL_NODE;
+        return;
+    }
+
+    int32_t parent = nodes[leaf].parent;
+    int32_t grandParent = nodes[parent].parent;
+    int32_t sibling = nodes[parent].left == leaf ? nodes[parent].right : nodes[parent].left;
+
+    if (grandParent == NULL_NODE) {
+        root = sibling;
+        nodes[sibling].parent = NULL_NODE;
+        freeNode(parent);
+        return;
+    }
+
+    if (nodes[grandParent].left == parent) {
+        nodes[grandParent].left = sibling;
+    } else {
+        nodes[grandParent].right = sibling;
+    }
+    nodes[sibling].parent = grandParent;
+    freeNode(parent);
+
+    refitUpwards(grandParent);
+}
+
+void SceneBVH::refitUpwards(int32_t id) {
+    while (id != NULL_NODE) {
+        id = balance(id);
+
+        Node& node = nodes[id];
+        node.height = 1 + std::max(nodes[node.left].height, nodes[node.right].height);
+        node.box = merge(nodes[node.left].box, nodes[node.right].box);
+        id = node.parent;
+    }
+}
+
+// Rotaciona o no a se os filhos diferem em altura por mais de 1; retorna a nova raiz
+// da subarvore
+int32_t SceneBVH::balance(int32_t a) {
+    if (nodes[a].isLeaf() || nodes[a].height < 2) {
+        return a;
+    }
+
+    int32_t b = nodes[a].left;
+    int32_t c = nodes[a].right;
+    int32_t diff = nodes[c].height - nodes[b].height;
+
+    auto rotateUp = [&](int32_t up, int32_t other, bool upIsRight) {
+        int32_t f = nodes[up].left;
+        int32_t g = nodes[up].right;
+
+        nodes[up].left = a;
+        nodes[up].parent = nodes[a].parent;
+        nodes[a].parent = up;
+
+        int32_t upParent = nodes[up].parent;
+        if (upParent == NULL_NODE) {
+            root = up;
+        } else if (nodes[upParent].left == a) {
+            nodes[upParent].left = up;
+        } else {
+            nodes[upParent].right = up;
+        }
+
+        // O neto mais alto sobe junto com up; o outro desce para o lugar de up em a
+        int32_t keep = nodes[f].height > nodes[g].height ? f : g;
+        int32_t move = keep == f ? g : f;
+        nodes[up].right = keep;
+        if (upIsRight) {
+            nodes[a].right = move;
+        } else {
+            nodes[a].left = move;
+        }
+        nodes[move].parent = a;
+
+        nodes[a].box = merge(nodes[other].box, nodes[move].box);
+        nodes[up].box = merge(nodes[a].box, nodes[keep].box);
+        nodes[a].height = 1 + std::max(nodes[other].height, nodes[move].height);
+        nodes[up].height = 1 + std::max(nodes[a].height, nodes[keep].height);
+        return up;
+    };
+
+    if (diff > 1) {
+        return rotateUp(c, b, true);
+    }
+    if (diff < -1) {
+        return rotateUp(b, c, false);
+    }
+    return a;
+}
+
+void SceneBVH::collectLeaves(int32_t id, std::vector<int32_t>& out) {
+    size_t base = stack.size();
+    stack.push_back(id);
+    while (stack.size() > base) {
+        int32_t current = stack.back();
+        stack.pop_back();
+        if (nodes[current].isLeaf()) {
+            out.push_back(current);
+        } else {
+            stack.push_back(nodes[current].left);
+            stack.push_back(nodes[current].right);
+        }
+    }
+}
+
+void SceneBVH::queryFrustum(const glm::vec4 planes[6], std::vector<int32_t>& out) {
+    update();
+    out.clear();
+    if (root == NULL_NODE) {
+        return;
+    }
+
+    stack.clear();
+    stack.push_back(root);
+    while (!stack.empty()) {
+        int32_t id = stack.back();
+        stack.pop_back();
+
+        Containment containment = classify(nodes[id].box, planes);
+        if (containment == Containment::OUTSIDE) {
+            continue;
+        }
+        if (containment == Containment::INSIDE || nodes[id].isLeaf()) {
+            collectLeaves(id, out);
+            continue;
+        }
+        stack.push_back(nodes[id].left);
+        stack.push_back(nodes[id].right);
+    }
+}
+
+void SceneBVH::queryAABB(const AABB& box, std::vector<int32_t>& out) {
+    update();
+    out.clear();
+    if (root == NULL_NODE) {
+        return;
+    }
+
+    stack.clear();
+    stack.push_back(root);
+    while (!stack.empty()) {
+        int32_t id = stack.back();
+        stack.pop_back();
+        if (!overlaps(nodes[id].box, box)) {
+            continue;
+        }
+        if (nodes[id].isLeaf()) {
+            if (overlaps(nodes[id].tightBox, box)) {
+                out.push_back(id);
+            }
+        } else {
+            stack.push_back(nodes[id].left);
+            stack.push_back(nodes[id].right);
+        }
+    }
+}
+
+void SceneBVH::querySphere(const BoundingSphere& sphere, std::vector<int32_t>& out) {
+    update();
+    out.clear();
+    if (root == NULL_NODE) {
+        return;
+    }
+
+    stack.clear();
+    stack.push_back(root);
+    while (!stack.empty()) {
+        int32_t id = stack.back();
+        stack.pop_back();
+        if (!overlaps(nodes[id].box, sphere)) {
+            continue;
+        }
+        if (nodes[id].isLeaf()) {
+            if (overlaps(nodes[id].tightBox, sphere)) {
+                out.push_back(id);
+            }
+        } else {
+            stack.push_back(nodes[id].left);
+            stack.push_back(nodes[id].right);
+        }
+    }
+}
+
+bool SceneBVH::raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                       RaycastHit& hit) {
+    update();
+    float length = glm::length(direction);
+    if (root == NULL_NODE || length == 0.0f) {
+        return false;
+    }
+
+    glm::vec3 unitDirection = direction / length;
+    glm::vec3 invDirection = 1.0f / unitDirection;
+    float best = maxDistance;
+    int32_t bestProxy = NULL_NODE;
+
+    stack.clear();
+    stack.push_back(root);
+    while (!stack.empty()) {
+        int32_t id = stack.back();
+        stack.pop_back();
+
+        if (intersectRay(nodes[id].box, origin, invDirection, best) > best) {
+            continue;
+        }
+        if (!nodes[id].isLeaf()) {
+            stack.push_back(nodes[id].left);
+            stack.push_back(nodes[id].right);
+            continue;
+        }
+
+        float distance = intersectRay(nodes[id].tightBox, origin, invDirection, best);
+        if (distance <= best) {
+            best = distance;
+            bestProxy = id;
+        }
+    }
+
+    if (bestProxy == NULL_NODE) {
+        return false;
+    }
+
+    hit.object = nodes[bestProxy].object;
+    hit.distance = best;
+    hit.point = origin + unitDirection * best;
+    return true;
+}
@@ -0,0 +1,98 @@
+#ifndef SCENE_BVH_HPP
+#define SCENE_BVH_HPP
+
+#include "bounds.hpp"
+#include "transform.hpp"
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+class GameObject;
+
+struct RaycastHit {
+    GameObject* object = nullptr;
+    float distance = 0.0f;
+    glm::vec3 point = glm::vec3(0.0f);
+};
+
+// Arvore AABB dinamica sobre os objetos da cena (no estilo da b2DynamicTree).
+// Cada folha guarda uma caixa "gorda" (a caixa do objeto com margem); enquanto o
+// objeto se move dentro dela so a caixa justa e atualizada, e quando sai a folha e
+// reinserida. Insercao escolhe o irmao pelo custo de area e rotacoes mantem a altura
+// em O(log n).
+//
+// As folhas observam o Transform do objeto; mudancas entram numa fila e sao aplicadas
+// em update(), que as consultas chamam antes de percorrer a arvore.
+class SceneBVH : public TransformObserver {
+  public:
+    static constexpr int32_t NULL_NODE = -1;
+
+  private:
+    struct Node {
+        AABB box; // caixa gorda nas folhas, uniao dos filhos nos nos internos
+        AABB tightBox;
+        BoundingSphere sphere;
+        GameObject* object = nullptr;
+        int32_t parent = NULL_NODE;
+        int32_t left = NULL_NODE;
+        int32_t right = NULL_NODE;
+        // -1 para nos livres, 0 para folhas
+        int32_t height = -1;
+        bool queued = false;
+        // Quadro em que a folha passou no culling (ver markVisible)
+        uint32_t visibleStamp = 0;
+
+        bool isLeaf() const { return left == NULL_NODE; }
+    };
+
+    std::vector<Node> nodes;
+    int32_t root = NULL_NODE;
+    int32_t freeList = NULL_NODE;
+    uint32_t proxyCount = 0;
+    std::vector<int32_t> dirtyProxies;
+    std::vector<int32_t> stack;
+
+    int32_t allocateNode();
+    void freeNode(int32_t id);
+    void insertLeaf(int32_t leaf);
+    void removeLeaf(int32_t leaf);
+    int32_t balance(int32_t a);
+    void refitUpwards(int32_t id);
+    void fatten(int32_t leaf);
+    void collectLeaves(int32_t id, std::vector<int32_t>& out);
+
+  public:
+    // Retorna NULL_NODE se o objeto nao tem volume (sem mesh nem sprite)
+    int32_t createProxy(GameObject* object);
+    void destroyProxy(int32_t proxy);
+    void clear();
+
+    void onTransformChanged(int32_t proxy) override;
+    // Aplica as mudancas pendentes de Transform
+    void update();
+
+    // Folhas cuja caixa gorda intersecta o frustum (planos apontando para dentro,
+    // como em FrustumCuller::extractPlanes). Subarvores inteiramente dentro sao
+    // aceitas sem testar os filhos.
+    void queryFrustum(const glm::vec4 planes[6], std::vector<int32_t>& out);
+    void queryAABB(const AABB& box, std::vector<int32_t>& out);
+    void querySphere(const BoundingSphere& sphere, std::vector<int32_t>& out);
+    // Acerto mais proximo contra as caixas justas; direction nao precisa ser unitaria
+    bool raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                 RaycastHit& hit);
+
+    GameObject* getObject(int32_t proxy) const { return nodes[proxy].object; }
+    const AABB& getTightBounds(int32_t proxy) const { return nodes[proxy].tightBox; }
+    const BoundingSphere& getBoundingSphere(int32_t proxy) const { return nodes[proxy].sphere; }
+    uint32_t getProxyCount() const { return proxyCount; }
+
+    // Marca de visibilidade do renderer: stamp muda a cada quadro, entao nada precisa
+    // ser limpo entre quadros
+    void markVisible(int32_t proxy, uint32_t stamp) { nodes[proxy].visibleStamp = stamp; }
+    bool isVisible(int32_t proxy, uint32_t stamp) const {
+        return nodes[proxy].visibleStamp == stamp;
+    }
+    int32_t getHeight() const { return root == NULL_NODE ? 0 : nodes[root].height; }
+};
+
+#endif // SCENE_BVH_HPP
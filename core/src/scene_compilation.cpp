@@ -0,0 +1,220 @@
+#include "scene_compilation.hpp"
+#include "color.hpp"
+#include "vector3.hpp"
+#include "stb_image.h"
+#include <array>
+#include <cstdio>
+#include <iostream>
+#include <unordered_map>
+
+using json = nlohmann::json;
+
+namespace {
+// Tabelas de meshes/materiais/texturas sem repeticao; a chave e o conteudo serializado
+struct SceneTables {
+    CompiledScene& scene;
+    std::unordered_map<std::string, uint32_t> meshes;
+    std::unordered_map<std::string, uint32_t> materials;
+    std::unordered_map<std::string, uint32_t> textures;
+};
+
+template <typename T>
+uint32_t addToTable(std::unordered_map<std::string, uint32_t>& index, std::vector<T>& table,
+                    const std::string& key, const T& value) {
+    auto it = index.find(key);
+    if (it != index.end()) {
+        return it->second;
+    }
+    uint32_t position = static_cast<uint32_t>(table.size());
+    table.push_back(value);
+    index.emplace(key, position);
+    return position;
+}
+
+void copyPath(char* destination, size_t size, const std::string& path) {
+    std::snprintf(destination, size, "%s", path.c_str());
+}
+
+void compileCamera(CompiledScene& scene, const json& cam) {
+    scene.camera = SceneCameraData{};
+    for (int i = 0; i < 4; i++)
+        scene.camera.background_color[i] = cam["background_color"][i];
+    scene.camera.fov = cam["fov"];
+    for (int i = 0; i < 2; i++)
+        scene.camera.view_rect[i] = cam["view_rect"][i];
+    for (int i = 0; i < 3; i++)
+        scene.camera.position[i] = cam["position"][i];
+
+    scene.camera.orthographic = cam.value("orthographic", false);
+    scene.camera.orthoSize = cam.value("orthoSize", 5.0f);
+
+    if (cam.contains("skybox")) {
+        scene.camera.hasSkybox = true;
+        auto& skybox = cam["skybox"];
+
+        std::string vertPath = skybox["material"]["vertexShaderPath"];
+        std::string fragPath = skybox["material"]["fragmentShaderPath"];
+
+        copyPath(scene.camera.skybox.material.vertexShaderPath,
+                 sizeof(scene.camera.skybox.material.vertexShaderPath), vertPath);
+        copyPath(scene.camera.skybox.material.fragmentShaderPath,
+                 sizeof(scene.camera.skybox.material.fragmentShaderPath), fragPath);
+
+        for (int i = 0; i < 6; i++) {
+            std::string texPath = skybox["cubeMapTextures"][i];
+            copyPath(scene.camera.skybox.cubeMapTextures[i],
+                     sizeof(scene.camera.skybox.cubeMapTextures[i]), texPath);
+        }
+    } else {
+        scene.camera.hasSkybox = false;
+    }
+}
+
+void compileLights(CompiledScene& scene, const json& j) {
+    scene.lights.clear();
+    if (!j.contains("lights"))
+        return;
+
+    for (auto& source : j["lights"]) {
+        LightData light{};
+        std::string type = source["type"];
+        if (type == "DIRECTIONAL")
+            light.type = 0;
+        else if (type == "POINT")
+            light.type = 1;
+        else if (type == "SPOT")
+            light.type = 2;
+        else
+            light.type = 0;
+
+        std::array<float, 3> direction = source["direction"];
+        light.direction = {direction[0], direction[1], direction[2]};
+        // Opcionais, usados por POINT e SPOT
+        std::array<float, 3> position = source.value("position", std::array<float, 3>{});
+        light.position = {position[0], position[1], position[2]};
+        light.range = source.value("range", 10.0f);
+        scene.lights.push_back(light);
+    }
+}
+
+uint32_t compileMaterial(SceneTables& tables, const json& source) {
+    std::string vertPath = source["vertexShaderPath"];
+    std::string fragPath = source["fragmentShaderPath"];
+    std::array<float, 4> color = source["color"];
+
+    MaterialData material{};
+    copyPath(material.vertexShaderPath, sizeof(material.vertexShaderPath), vertPath);
+    copyPath(material.fragmentShaderPath, sizeof(material.fragmentShaderPath), fragPath);
+    material.color = {color[0], color[1], color[2], color[3]};
+
+    std::string key = vertPath + "|" + fragPath + "|" + std::to_string(color[0]) + "," +
+                      std::to_string(color[1]) + "," + std::to_string(color[2]) + "," +
+                      std::to_string(color[3]);
+    return addToTable(tables.materials, tables.scene.materials, key, material);
+}
+
+void compileMeshRenderer(SceneTables& tables, ComponentData& compData, const json& comp) {
+    compData.type = ComponentType::MESH_RENDERER;
+
+    std::string objPath = comp["mesh"]["path"];
+    MeshData mesh{};
+    copyPath(mesh.path, sizeof(mesh.path), objPath);
+    mesh.shadeSmooth = comp["mesh"].value("shadeSmooth", true);
+
+    std::string key = objPath + (mesh.shadeSmooth ? "|smooth" : "|flat");
+    compData.meshRenderer.mesh = addToTable(tables.meshes, tables.scene.meshes, key, mesh);
+    compData.meshRenderer.material = compileMaterial(tables, comp["material"]);
+}
+
+void compileSpriteRenderer(SceneTables& tables, ComponentData& compData, const json& comp) {
+    compData.type = ComponentType::SPRITE_RENDERER;
+
+    std::string texPath = comp["texture"]["path"];
+    float scaleFactor = comp["texture"].value("scaleFactor", 1.0f);
+    std::string filter = comp["texture"].value("filterType", "NEAREST");
+
+    std::string key = texPath + "|" + std::to_string(scaleFactor) + "|" + filter;
+    auto it = tables.textures.find(key);
+    if (it != tables.textures.end()) {
+        compData.spriteRenderer.texture = it->second;
+    } else {
+        int width, height, channels;
+        if (!stbi_info(texPath.c_str(), &width, &height, &channels)) {
+            std::cerr << "Failed to read texture info: " << texPath << std::endl;
+            width = height = 1;
+        }
+
+        TextureData texture{};
+        copyPath(texture.path, sizeof(texture.path), texPath);
+        texture.width = static_cast<float>(width);
+        texture.height = static_cast<float>(height);
+        texture.scaleFactor = scaleFactor;
+        texture.filterType = (filter == "LINEAR") ? 1 : 0;
+        compData.spriteRenderer.texture =
+            addToTable(tables.textures, tables.scene.textures, key, texture);
+    }
+
+    compData.spriteRenderer.material = compileMaterial(tables, comp["material"]);
+}
+
+void compileTransform(ComponentData& compData, const json& comp) {
+    compData.type = ComponentType::TRANSFORM;
+
+    compData.transform.position.x = comp["position"][0];
+    compData.transform.position.y = comp["position"][1];
+    compData.transform.position.z = comp["position"][2];
+
+    compData.transform.rotation.x = comp["rotation"][0];
+    compData.transform.rotation.y = comp["rotation"][1];
+    compData.transform.rotation.z = comp["rotation"][2];
+
+    compData.transform.scale.x = comp["scale"][0];
+    compData.transform.scale.y = comp["scale"][1];
+    compData.transform.scale.z = comp["scale"][2];
+
+    compData.transform.parent = comp.contains("parent") ? comp["parent"].get<int32_t>() : -1;
+}
+
+void compileGameObjects(SceneTables& tables, const json& j) {
+    CompiledScene& scene = tables.scene;
+    if (!j.contains("gameObjects"))
+        return;
+
+    auto& gameObjects = j["gameObjects"];
+    scene.gameObjects.reserve(gameObjects.size());
+    for (auto& go : gameObjects) {
+        GameObjectData goData;
+        goData.firstComponent = static_cast<uint32_t>(scene.components.size());
+        goData.componentCount = 0;
+
+        if (go.contains("components")) {
+            for (auto& comp : go["components"]) {
+                std::string type = comp["type"];
+                ComponentData compData{};
+
+                if (type == "MESH_RENDERER") {
+                    compileMeshRenderer(tables, compData, comp);
+                } else if (type == "TRANSFORM") {
+                    compileTransform(compData, comp);
+                } else if (type == "SPRITE_RENDERER") {
+                    compileSpriteRenderer(tables, compData, comp);
+                } else {
+                    std::cerr << "Unknown component type: " << type << std::endl;
+                    continue;
+                }
+                scene.components.push_back(compData);
+                goData.componentCount++;
+            }
+        }
+        scene.gameObjects.push_back(goData);
+    }
+}
+} // namespace
+
+void compileScene(const json& source, CompiledScene& scene) {
+    scene = CompiledScene();
+    SceneTables tables{scene, {}, {}, {}};
+    compileCamera(scene, source["camera"]);
+    compileLights(scene, source);
+    compileGameObjects(tables, source);
+}
@@ -0,0 +1,12 @@
+#ifndef SCENE_COMPILATION_HPP
+#define SCENE_COMPILATION_HPP
+
+#include "scene_format.hpp"
+#include <nlohmann/json.hpp>
+
+// Converte a descricao JSON de uma cena (.scn) em CompiledScene. Usado pelo
+// scene_compiler e pelos benchmarks; campos obrigatorios ausentes lancam
+// nlohmann::json::exception.
+void compileScene(const nlohmann::json& source, CompiledScene& scene);
+
+#endif // SCENE_COMPILATION_HPP
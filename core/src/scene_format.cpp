@@ -0,0 +1,136 @@
+#include "scene_format.hpp"
+#include <cstring>
+#include <fstream>
+
+namespace {
+template <typename T> void writeTable(std::ofstream& file, const std::vector<T>& table) {
+    if (!table.empty()) {
+        file.write(reinterpret_cast<const char*>(table.data()), sizeof(T) * table.size());
+    }
+}
+
+// remaining: bytes ainda nao lidos do arquivo; contagens maiores que ele sao
+// rejeitadas antes de alocar
+template <typename T>
+bool readTable(std::ifstream& file, std::vector<T>& table, uint32_t count, uint64_t& remaining) {
+    if (count > remaining / sizeof(T)) {
+        return false;
+    }
+    remaining -= static_cast<uint64_t>(sizeof(T)) * count;
+    table.resize(count);
+    if (count == 0) {
+        return true;
+    }
+    return static_cast<bool>(
+        file.read(reinterpret_cast<char*>(table.data()), sizeof(T) * count));
+}
+
+template <size_t N> bool isTerminated(const char (&path)[N]) {
+    return std::memchr(path, '\0', N) != nullptr;
+}
+
+bool isTerminated(const MaterialData& material) {
+    return isTerminated(material.vertexShaderPath) && isTerminated(material.fragmentShaderPath);
+}
+} // namespace
+
+bool writeCompiledScene(const std::string& filepath, const CompiledScene& scene) {
+    std::ofstream file(filepath, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    SceneFileHeader header;
+    header.meshCount = static_cast<uint32_t>(scene.meshes.size());
+    header.materialCount = static_cast<uint32_t>(scene.materials.size());
+    header.textureCount = static_cast<uint32_t>(scene.textures.size());
+    header.gameObjectCount = static_cast<uint32_t>(scene.gameObjects.size());
+    header.componentCount = static_cast<uint32_t>(scene.components.size());
+    header.lightCount = static_cast<uint32_t>(scene.lights.size());
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(&scene.camera), sizeof(scene.camera));
+    writeTable(file, scene.meshes);
+    writeTable(file, scene.materials);
+    writeTable(file, scene.textures);
+    writeTable(file, scene.gameObjects);
+    writeTable(file, scene.components);
+    writeTable(file, scene.lights);
+    return static_cast<bool>(file);
+}
+
+bool readCompiledScene(const std::string& filepath, CompiledScene& scene) {
+    std::ifstream file(filepath, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return false;
+    }
+    std::streamoff fileSize = file.tellg();
+    file.seekg(0);
+
+    SceneFileHeader header;
+    uint64_t fixedSize = sizeof(header) + sizeof(scene.camera);
+    if (fileSize < 0 || static_cast<uint64_t>(fileSize) < fixedSize ||
+        !file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        header.magic != SCENE_MAGIC || header.version != SCENE_VERSION) {
+        return false;
+    }
+
+    uint64_t remaining = static_cast<uint64_t>(fileSize) - fixedSize;
+    if (!file.read(reinterpret_cast<char*>(&scene.camera), sizeof(scene.camera)) ||
+        !readTable(file, scene.meshes, header.meshCount, remaining) ||
+        !readTable(file, scene.materials, header.materialCount, remaining) ||
+        !readTable(file, scene.textures, header.textureCount, remaining) ||
+        !readTable(file, scene.gameObjects, header.gameObjectCount, remaining) ||
+        !readTable(file, scene.components, header.componentCount, remaining) ||
+        !readTable(file, scene.lights, header.lightCount, remaining)) {
+        return false;
+    }
+
+    // Caminhos sem '\0' fariam a leitura passar do fim do array
+    if (scene.camera.hasSkybox) {
+        for (const auto& path : scene.camera.skybox.cubeMapTextures) {
+            if (!isTerminated(path)) {
+                return false;
+            }
+        }
+        if (!isTerminated(scene.camera.skybox.material)) {
+            return false;
+        }
+    }
+    for (const auto& mesh : scene.meshes) {
+        if (!isTerminated(mesh.path)) {
+            return false;
+        }
+    }
+    for (const auto& material : scene.materials) {
+        if (!isTerminated(material)) {
+            return false;
+        }
+    }
+    for (const auto& texture : scene.textures) {
+        if (!isTerminated(texture.path)) {
+            return false;
+        }
+    }
+
+    // Indices fora das tabelas indicam arquivo corrompido
+    for (const auto& object : scene.gameObjects) {
+        if (object.firstComponent > scene.components.size() ||
+            object.componentCount > scene.components.size() - object.firstComponent) {
+            return false;
+        }
+    }
+    for (const auto& component : scene.components) {
+        if (component.type == ComponentType::MESH_RENDERER &&
+            (component.meshRenderer.mesh >= scene.meshes.size() ||
+             component.meshRenderer.material >= scene.materials.size())) {
+            return false;
+        }
+        if (component.type == ComponentType::SPRITE_RENDERER &&
+            (component.spriteRenderer.material >= scene.materials.size() ||
+             component.spriteRenderer.texture >= scene.textures.size())) {
+            return false;
+        }
+    }
+    return true;
+}
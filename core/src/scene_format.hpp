@@ -4,11 +4,39 @@
 #include "color.hpp"
 #include "vector3.hpp"
 #include <cstdint>
+#include <string>
+#include <vector>
+
+// Formato binario (.scnb), versao 3:
+//   SceneFileHeader
+//   SceneCameraData
+//   MeshData[meshCount]
+//   MaterialData[materialCount]
+//   TextureData[textureCount]
+//   GameObjectData[gameObjectCount]
+//   ComponentData[componentCount]
+//   LightData[lightCount]
+// Meshes, materiais e texturas ficam em tabelas sem repeticao e os componentes
+// guardam indices, entao o tamanho cresce com os objetos e nao com os caminhos.
+constexpr uint32_t SCENE_MAGIC = 0x53434E45;
+constexpr uint32_t SCENE_VERSION = 3;
+
+struct SceneFileHeader {
+    uint32_t magic = SCENE_MAGIC;
+    uint32_t version = SCENE_VERSION;
+    uint32_t meshCount;
+    uint32_t materialCount;
+    uint32_t textureCount;
+    uint32_t gameObjectCount;
+    uint32_t componentCount;
+    uint32_t lightCount;
+};
 
 struct LightData {
     uint8_t type; // 0=DIRECTIONAL, 1=POINT, 2=SPOT
     Vector3 direction;
-    // float position[3];
+    Vector3 position;
+    float range;
 };
 
 struct MaterialData {
@@ -58,34 +86,44 @@ struct ComponentData {
     union {
         struct {
             Vector3 position;
-            Vector3 rotation;
+            Vector3 rotation; // graus
             Vector3 scale;
+            // Indice do GameObject pai em gameObjects, -1 sem pai
+            int32_t parent;
         } transform;
-        
+
+        // Indices nas tabelas de meshes/materiais/texturas
         struct {
-            MeshData mesh;
-            MaterialData material;
+            uint32_t mesh;
+            uint32_t material;
         } meshRenderer;
-        
+
         struct {
-            MaterialData material;
-            TextureData texture;
+            uint32_t material;
+            uint32_t texture;
         } spriteRenderer;
     };
 };
 
+// Componentes [firstComponent, firstComponent + componentCount)
 struct GameObjectData {
-    uint8_t componentCount;
-    ComponentData components[8];
+    uint32_t firstComponent;
+    uint32_t componentCount;
 };
 
 struct CompiledScene {
-    uint32_t magic = 0x53434E45;
     SceneCameraData camera;
-    uint32_t gameObjectCount;
-    GameObjectData gameObjects[32];
-    uint32_t lightCount;
-    LightData lights[32];
+    std::vector<MeshData> meshes;
+    std::vector<MaterialData> materials;
+    std::vector<TextureData> textures;
+    std::vector<GameObjectData> gameObjects;
+    std::vector<ComponentData> components;
+    std::vector<LightData> lights;
 };
 
-#endif
\ No newline at end of file
+bool writeCompiledScene(const std::string& filepath, const CompiledScene& scene);
+// Falha se o arquivo nao existe, esta truncado, e de outra versao do formato ou
+// tem contagens, indices ou caminhos invalidos
+bool readCompiledScene(const std::string& filepath, CompiledScene& scene);
+
+#endif // SCENE_FORMAT_HPP
@@ -12,6 +12,8 @@
 #include "shader_asset.hpp"
 #include "skybox.hpp"
 #include "stb_image.h"
+#include "memory_tracker.hpp"
+#include "trace.hpp"
 #include <fstream>
 
 SceneLoader::SceneLoader() : rendererBackend(nullptr) {}
@@ -19,18 +21,19 @@ SceneLoader::SceneLoader() : rendererBackend(nullptr) {}
 void SceneLoader::setRendererBackend(RendererBackend& backend) { rendererBackend = &backend; }
 
 CompiledScene* SceneLoader::loadCompiledScene(const std::string& filepath) {
+    TRACE_ZONE("SceneLoader::loadCompiledScene");
     if (!validateSceneFile(filepath))
         return nullptr;
 
-    std::ifstream file(filepath, std::ios::binary);
     auto scene = new CompiledScene();
-    if (!file.read(reinterpret_cast<char*>(scene), sizeof(CompiledScene))) {
-        LOG_ERROR("Failed to read scene file: " + filepath);
+    if (!readCompiledScene(filepath, *scene)) {
+        LOG_ERROR("Failed to read scene file (truncated or compiled by another version, "
+                  "recompile the .scn): " + filepath);
         delete scene;
         return nullptr;
     }
 
-    LOG_INFO("Loaded scene with " + std::to_string(scene->gameObjectCount) + " game objects");
+    LOG_INFO("Loaded scene with " + std::to_string(scene->gameObjects.size()) + " game objects");
 
     return scene;
 }
@@ -38,39 +41,23 @@ CompiledScene* SceneLoader::loadCompiledScene(const std::string& filepath) {
 void SceneLoader::loadTransformComponent(GameObject* gameObject, const ComponentData& comp) {
     auto transform = std::make_unique<Transform>();
     transform->setPosition(comp.transform.position);
-    transform->setRotation(comp.transform.rotation);
+    transform->setEulerAngles(comp.transform.rotation);
     transform->setScale(comp.transform.scale);
     gameObject->setTransform(std::move(transform));
 }
 
-void SceneLoader::loadMeshRendererComponent(GameObject* gameObject, const ComponentData& comp) {
-    auto& meshData = comp.meshRenderer.mesh;
-    auto& materialData = comp.meshRenderer.material;
+void SceneLoader::loadMeshRendererComponent(GameObject* gameObject, const CompiledScene& scene,
+                                            const ComponentData& comp) {
+    auto& meshData = scene.meshes[comp.meshRenderer.mesh];
 
-    auto mesh = loadObjMesh(meshData.path, meshData.shadeSmooth);
+    auto mesh = getOrLoadMesh(scene, comp.meshRenderer.mesh);
     if (!mesh) {
         LOG_ERROR("Failed to load mesh: " + std::string(meshData.path));
         return;
     }
-    mesh->setMeshBuffer(rendererBackend->createMeshBuffer());
-    mesh->configure();
 
-    auto shaderExt = rendererBackend->getShaderExtension();
-    auto vertexShader = std::make_unique<ShaderAsset>(materialData.vertexShaderPath + shaderExt,
-                                                      ShaderType::VERTEX);
-    vertexShader->setShaderCompiler(rendererBackend->createShaderCompiler());
-
-    auto fragmentShader = std::make_unique<ShaderAsset>(materialData.fragmentShaderPath + shaderExt,
-                                                        ShaderType::FRAGMENT);
-    fragmentShader->setShaderCompiler(rendererBackend->createShaderCompiler());
-
-    auto material = std::make_unique<Material>();
-    material->setShaderProgram(rendererBackend->createShaderProgram());
-    material->setVertexShader(std::move(vertexShader));
-    material->setFragmentShader(std::move(fragmentShader));
-    material->setBaseColor(materialData.color);
-
-    if (!material->init()) {
+    auto material = getOrCreateMaterial(scene, comp.meshRenderer.material);
+    if (!material) {
         LOG_ERROR("Material init failed for mesh: " + std::string(meshData.path));
         return;
     }
@@ -82,9 +69,10 @@ void SceneLoader::loadMeshRendererComponent(GameObject* gameObject, const Compon
     gameObject->setMeshRenderer(std::move(meshRenderer));
 }
 
-void SceneLoader::loadSpriteRendererComponent(GameObject* gameObject, const ComponentData& comp) {
-    auto& textureData = comp.spriteRenderer.texture;
-    auto& materialData = comp.spriteRenderer.material;
+void SceneLoader::loadSpriteRendererComponent(GameObject* gameObject, const CompiledScene& scene,
+                                              const ComponentData& comp) {
+    auto& textureData = scene.textures[comp.spriteRenderer.texture];
+    auto& materialData = scene.materials[comp.spriteRenderer.material];
 
     float width = textureData.width * textureData.scaleFactor;
     float height = textureData.height * textureData.scaleFactor;
@@ -93,6 +81,55 @@ void SceneLoader::loadSpriteRendererComponent(GameObject* gameObject, const Comp
     unsigned int texID = rendererBackend->loadTexture(textureData.path, textureData.filterType);
     sprite->setTexture(texID);
 
+    auto material = createMaterial(materialData, false);
+    if (!material) {
+        LOG_ERROR("Material init failed for sprite: " + std::string(textureData.path));
+        return;
+    }
+
+    auto spriteRenderer = std::make_unique<SpriteRenderer>();
+    spriteRenderer->setMaterial(std::move(material));
+
+    gameObject->setSprite(std::move(sprite));
+    gameObject->setSpriteRenderer(std::move(spriteRenderer));
+}
+
+std::shared_ptr<Mesh> SceneLoader::getOrLoadMesh(const CompiledScene& scene, uint32_t index) {
+    if (meshCache[index]) {
+        return meshCache[index];
+    }
+
+    auto& meshData = scene.meshes[index];
+    std::shared_ptr<Mesh> mesh = loadObjMesh(meshData.path, meshData.shadeSmooth);
+    if (!mesh) {
+        return nullptr;
+    }
+    mesh->setMeshBuffer(rendererBackend->createMeshBuffer());
+    mesh->configure();
+
+    meshCache[index] = mesh;
+    return mesh;
+}
+
+std::shared_ptr<Material> SceneLoader::getOrCreateMaterial(const CompiledScene& scene,
+                                                           uint32_t index) {
+    if (materialCache[index]) {
+        return materialCache[index];
+    }
+
+    std::shared_ptr<Material> material = createMaterial(scene.materials[index], true);
+    if (!material) {
+        return nullptr;
+    }
+
+    materialCache[index] = material;
+    return material;
+}
+
+std::unique_ptr<Material> SceneLoader::createMaterial(const MaterialData& materialData,
+                                                      bool instancing) {
+    TRACE_ZONE("SceneLoader::createMaterial");
+    MEMORY_SCOPE(MemoryTag::ASSETS);
     auto shaderExt = rendererBackend->getShaderExtension();
     auto vertexShader = std::make_unique<ShaderAsset>(materialData.vertexShaderPath + shaderExt,
                                                       ShaderType::VERTEX);
@@ -108,19 +145,35 @@ void SceneLoader::loadSpriteRendererComponent(GameObject* gameObject, const Comp
     material->setFragmentShader(std::move(fragmentShader));
     material->setBaseColor(materialData.color);
 
-    if (!material->init()) {
-        LOG_ERROR("Material init failed for sprite: " + std::string(textureData.path));
-        return;
+    // "flat.vxs" -> "flat_instanced.vxs", usado apenas se o shader existir
+    if (instancing) {
+        std::string vertexPath = materialData.vertexShaderPath;
+        auto dot = vertexPath.rfind('.');
+        std::string instancedPath =
+            (dot == std::string::npos ? vertexPath + "_instanced"
+                                      : vertexPath.substr(0, dot) + "_instanced" +
+                                            vertexPath.substr(dot)) +
+            shaderExt;
+
+        if (std::ifstream(instancedPath).good()) {
+            auto instancedShader =
+                std::make_unique<ShaderAsset>(instancedPath, ShaderType::VERTEX);
+            instancedShader->setShaderCompiler(rendererBackend->createShaderCompiler());
+            material->setInstancedVariant(std::move(instancedShader),
+                                          rendererBackend->createShaderProgram());
+        }
     }
 
-    auto spriteRenderer = std::make_unique<SpriteRenderer>();
-    spriteRenderer->setMaterial(std::move(material));
+    if (!material->init()) {
+        return nullptr;
+    }
 
-    gameObject->setSprite(std::move(sprite));
-    gameObject->setSpriteRenderer(std::move(spriteRenderer));
+    return material;
 }
 
 std::unique_ptr<Mesh> SceneLoader::loadObjMesh(const std::string& filepath, bool shadeSmooth) {
+    TRACE_ZONE("SceneLoader::loadObjMesh");
+    MEMORY_SCOPE(MemoryTag::ASSETS);
     tinyobj::attrib_t attrib;
     std::vector<tinyobj::shape_t> shapes;
     std::vector<tinyobj::material_t> materials;
@@ -205,6 +258,7 @@ std::unique_ptr<Mesh> SceneLoader::loadObjMesh(const std::string& filepath, bool
 }
 
 Camera* SceneLoader::loadCamera(const CompiledScene* scene) {
+    TRACE_ZONE("SceneLoader::loadCamera");
 
     auto camera = new Camera();
     auto& cam = scene->camera;
@@ -253,42 +307,74 @@ Camera* SceneLoader::loadCamera(const CompiledScene* scene) {
 }
 
 std::vector<GameObject*>* SceneLoader::loadGameObjects(const CompiledScene* scene) {
+    TRACE_ZONE("SceneLoader::loadGameObjects");
 
     auto objects = new std::vector<GameObject*>();
 
-    LOG_INFO("Loading " + std::to_string(scene->gameObjectCount) + " game objects");
+    LOG_INFO("Loading " + std::to_string(scene->gameObjects.size()) + " game objects");
+
+    meshCache.assign(scene->meshes.size(), nullptr);
+    materialCache.assign(scene->materials.size(), nullptr);
+    objects->reserve(scene->gameObjects.size());
+    // Pais sao ligados depois que todos os objetos existem
+    std::vector<int32_t> parents(scene->gameObjects.size(), -1);
 
-    for (uint32_t i = 0; i < scene->gameObjectCount; i++) {
-        auto& goData = scene->gameObjects[i];
+    for (const auto& goData : scene->gameObjects) {
         auto gameObject = new GameObject();
 
-        for (uint8_t j = 0; j < goData.componentCount; j++) {
-            auto& comp = goData.components[j];
+        for (uint32_t j = 0; j < goData.componentCount; j++) {
+            auto& comp = scene->components[goData.firstComponent + j];
 
             if (comp.type == ComponentType::MESH_RENDERER) {
-                LOG_INFO("Loading mesh renderer component");
-                loadMeshRendererComponent(gameObject, comp);
+                loadMeshRendererComponent(gameObject, *scene, comp);
             } else if (comp.type == ComponentType::TRANSFORM) {
                 loadTransformComponent(gameObject, comp);
+                parents[objects->size()] = comp.transform.parent;
             } else if (comp.type == ComponentType::SPRITE_RENDERER) {
-                loadSpriteRendererComponent(gameObject, comp);
+                loadSpriteRendererComponent(gameObject, *scene, comp);
             }
         }
 
         objects->push_back(gameObject);
     }
 
+    for (size_t i = 0; i < parents.size(); i++) {
+        if (parents[i] < 0) {
+            continue;
+        }
+        Transform* parent = static_cast<size_t>(parents[i]) < objects->size()
+                                ? (*objects)[parents[i]]->getTransform()
+                                : nullptr;
+        if (!parent) {
+            LOG_WARN("Game object " + std::to_string(i) + " has an invalid parent " +
+                     std::to_string(parents[i]));
+            continue;
+        }
+        (*objects)[i]->getTransform()->setParent(parent);
+    }
+
+    LOG_INFO("Unique meshes: " + std::to_string(scene->meshes.size()) +
+             ", unique materials: " + std::to_string(scene->materials.size()));
+
+    // Os objetos mantem as referencias; o cache nao deve prolongar a vida da cena
+    meshCache.clear();
+    materialCache.clear();
+
     return objects;
 }
 
 std::vector<Light>* SceneLoader::loadLights(const CompiledScene* scene) {
+    TRACE_ZONE("SceneLoader::loadLights");
 
     auto lights = new std::vector<Light>();
 
-    for (uint32_t i = 0; i < scene->lightCount; i++) {
+    lights->reserve(scene->lights.size());
+    for (const auto& lightData : scene->lights) {
         Light light;
-        light.type = static_cast<LightType>(scene->lights[i].type);
-        light.direction = scene->lights[i].direction;
+        light.type = static_cast<LightType>(lightData.type);
+        light.direction = lightData.direction;
+        light.position = lightData.position;
+        light.range = lightData.range;
         lights->push_back(light);
     }
 
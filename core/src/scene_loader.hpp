@@ -15,15 +15,27 @@ class SceneLoader {
   private:
     RendererBackend* rendererBackend = nullptr;
 
-    std::unique_ptr<Mesh> loadObjMesh(const std::string& filepath, bool shadeSmooth);
+    // Objetos com a mesma mesh/material passam a compartilhar a instancia,
+    // o que permite ao backend agrupa-los em draws instanciados. Indexados pelas
+    // tabelas da cena compilada e validos apenas durante loadGameObjects.
+    std::vector<std::shared_ptr<Mesh>> meshCache;
+    std::vector<std::shared_ptr<Material>> materialCache;
+
+    std::shared_ptr<Mesh> getOrLoadMesh(const CompiledScene& scene, uint32_t index);
+    std::unique_ptr<Material> createMaterial(const MaterialData& materialData, bool instancing);
+    std::shared_ptr<Material> getOrCreateMaterial(const CompiledScene& scene, uint32_t index);
     void loadTransformComponent(GameObject* gameObject, const ComponentData& comp);
-    void loadMeshRendererComponent(GameObject* gameObject, const ComponentData& comp);
-    void loadSpriteRendererComponent(GameObject* gameObject, const ComponentData& comp);
+    void loadMeshRendererComponent(GameObject* gameObject, const CompiledScene& scene,
+                                   const ComponentData& comp);
+    void loadSpriteRendererComponent(GameObject* gameObject, const CompiledScene& scene,
+                                     const ComponentData& comp);
 
   public:
     SceneLoader();
     void setRendererBackend(RendererBackend&);
     bool validateSceneFile(const std::string& filepath);
+    // So le o arquivo; o MeshBuffer e criado por quem usa a mesh
+    std::unique_ptr<Mesh> loadObjMesh(const std::string& filepath, bool shadeSmooth);
     CompiledScene* loadCompiledScene(const std::string& filepath);
 
     Camera* loadCamera(const CompiledScene* scene);
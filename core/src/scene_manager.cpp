@@ -1,8 +1,11 @@
 #define CLASS_NAME "SceneManager"
 #include "scene_manager.hpp"
 #include "log_macros.hpp"
+#include "engine_stats.hpp"
 #include "renderer/renderer_backend.hpp"
 #include "scene_loader.hpp"
+#include "memory_tracker.hpp"
+#include "trace.hpp"
 
 
 SceneManager::~SceneManager() {
@@ -19,6 +22,8 @@ Scene* SceneManager::getActiveScene() const { return activeScene; }
 
 // TODO: revisar esse delete
 void SceneManager::loadScene(const std::string& name) {
+    TRACE_ZONE("SceneManager::loadScene");
+    MEMORY_SCOPE(MemoryTag::SCENE_LOAD);
     auto it = sceneRegistry.find(name);
     if (it == sceneRegistry.end()) {
         LOG_WARN("Scene not found: " + name);
@@ -40,6 +45,9 @@ void SceneManager::loadScene(const std::string& name) {
     activeScene->setGameObjects(sceneLoader.loadGameObjects(compiledScene));
 
     delete compiledScene;
+
+    // Orcamentos sao por cena: o historico de tempos recomeca sem o carregamento
+    EngineStats::resetFrameTimes();
 }
 
 void SceneManager::setRendererBackend(RendererBackend& rendererBackend) {
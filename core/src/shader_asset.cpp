@@ -1,6 +1,9 @@
 #define CLASS_NAME "ShaderAsset"
 #include "shader_asset.hpp"
 #include "log_macros.hpp"
+#include "engine_stats.hpp"
+#include "memory_tracker.hpp"
+#include "trace.hpp"
 
 ShaderAsset::ShaderAsset(const std::string& path, ShaderType type)
     : Asset(path), shaderType(type) {}
@@ -10,7 +13,12 @@ void ShaderAsset::setShaderCompiler(std::unique_ptr<ShaderCompiler> comp) {
 }
 
 bool ShaderAsset::load() {
+    TRACE_ZONE("ShaderAsset::load");
+    MEMORY_SCOPE(MemoryTag::ASSETS);
     if (compiler && compiler->compile(getPath(), shaderType, &shaderHandle)) {
+        if (!loaded) {
+            EngineStats::countAsset(AssetType::SHADER, 1);
+        }
         loaded = true;
         return true;
     }
@@ -24,5 +32,8 @@ void ShaderAsset::unload() {
         compiler->destroy(shaderHandle);
         shaderHandle = nullptr;
     }
+    if (loaded) {
+        EngineStats::countAsset(AssetType::SHADER, -1);
+    }
     loaded = false;
 }
@@ -1,10 +1,12 @@
 #include "shader_compiler_factory.hpp"
+#include "renderer/backends/null/null_shader_compiler.hpp"
 
 #ifdef PLATFORM_WEBGL
 #include "renderer/backends/webgl/web_gl_shader_compiler.hpp"
 #else
 #include "renderer/backends/opengl/open_gl_shader_compiler.hpp"
 #include "renderer/backends/vulkan/vulkan_shader_compiler.hpp"
+#include "renderer/backends/software/software_shader_compiler.hpp"
 #ifdef _WIN32
 #include "renderer/backends/directx12/d3d12_shader_compiler.hpp"
 #endif
@@ -20,11 +22,15 @@ std::unique_ptr<ShaderCompiler> ShaderCompilerFactory::create(GraphicsAPI api, v
         return std::make_unique<OpenGLShaderCompiler>();
     case GraphicsAPI::VULKAN:
         return std::make_unique<VulkanShaderCompiler>(static_cast<VulkanRendererBackend*>(context));
+    case GraphicsAPI::SOFTWARE:
+        return std::make_unique<SoftwareShaderCompiler>();
 #ifdef _WIN32
     case GraphicsAPI::DIRECTX12:
         return std::make_unique<D3D12ShaderCompiler>(static_cast<D3D12RendererBackend*>(context));
 #endif
 #endif
+    case GraphicsAPI::NONE:
+        return std::make_unique<NullShaderCompiler>(static_cast<NullRendererBackend*>(context));
     default:
         return nullptr;
     }
@@ -1,11 +1,18 @@
 #ifndef SHADER_PROGRAM_HPP
 #define SHADER_PROGRAM_HPP
 
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 
 class ShaderAsset;
 
 class ShaderProgram {
+  private:
+    inline static std::atomic<uint32_t> nextId{1};
+    uint32_t id = nextId++;
+    bool instanced = false;
+
   public:
     virtual ~ShaderProgram() = default;
     virtual bool attachShader(const ShaderAsset& shader) = 0;
@@ -14,6 +21,19 @@ class ShaderProgram {
     virtual void setUniformBuffer(const char* name, const void* data, size_t size) = 0;
     virtual void* getHandle() const = 0;
     virtual bool isValid() const = 0;
+
+    // Compilacao/link podem terminar de forma assincrona (KHR_parallel_shader_compile,
+    // pipelines Vulkan em worker threads). Retorna true quando o resultado de link()
+    // ja e conhecido; a partir dai isValid() indica se deu certo. Nunca bloqueia.
+    virtual bool isReady() { return true; }
+
+    // Identificador estavel usado nas chaves de ordenacao da fila de render
+    uint32_t getId() const { return id; }
+
+    // Programa que le a matriz model por instancia (atributos 2..5); deve ser
+    // definido antes de link()
+    void setInstanced(bool value) { instanced = value; }
+    bool isInstanced() const { return instanced; }
 };
 
 #endif // SHADERPROGRAM_HPP
\ No newline at end of file
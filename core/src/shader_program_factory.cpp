@@ -1,10 +1,12 @@
 #include "shader_program_factory.hpp"
+#include "renderer/backends/null/null_shader_program.hpp"
 
 #ifdef PLATFORM_WEBGL
 #include "renderer/backends/webgl/web_gl_shader_program.hpp"
 #else
 #include "renderer/backends/opengl/open_gl_shader_program.hpp"
 #include "renderer/backends/vulkan/vulkan_shader_program.hpp"
+#include "renderer/backends/software/software_shader_program.hpp"
 #ifdef _WIN32
 #include "renderer/backends/directx12/d3d12_shader_program.hpp"
 #endif
@@ -17,14 +19,18 @@ std::unique_ptr<ShaderProgram> ShaderProgramFactory::create(GraphicsAPI api, voi
         return std::make_unique<WebGLShaderProgram>();
 #else
     case GraphicsAPI::OPENGL:
-        return std::make_unique<OpenGLShaderProgram>();
+        return std::make_unique<OpenGLShaderProgram>(static_cast<OpenGLRendererBackend*>(context));
     case GraphicsAPI::VULKAN:
         return std::make_unique<VulkanShaderProgram>(static_cast<VulkanRendererBackend*>(context));
+    case GraphicsAPI::SOFTWARE:
+        return std::make_unique<SoftwareShaderProgram>(static_cast<SoftwareRendererBackend*>(context));
 #ifdef _WIN32
     case GraphicsAPI::DIRECTX12:
         return std::make_unique<D3D12ShaderProgram>(static_cast<D3D12RendererBackend*>(context));
 #endif
 #endif
+    case GraphicsAPI::NONE:
+        return std::make_unique<NullShaderProgram>(static_cast<NullRendererBackend*>(context));
     default:
         return nullptr;
     }
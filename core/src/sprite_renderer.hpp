@@ -6,7 +6,8 @@
 
 class SpriteRenderer {
 private:
-    std::unique_ptr<Material> material;
+    // Cada sprite tem o seu; shared so para os proxies da thread de render
+    std::shared_ptr<Material> material;
 
 public:
     SpriteRenderer() = default;
@@ -0,0 +1,241 @@
+#define CLASS_NAME "Trace"
+#include "trace.hpp"
+#include "log_macros.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+enum class EventType : uint8_t { BEGIN, END, COUNTER, FRAME, GPU_ZONE };
+
+// tid da trilha de GPU; as threads comecam em 1
+constexpr uint32_t GPU_TRACK_ID = 0;
+
+struct Event {
+    const char* name;
+    uint64_t timestamp; // ns desde begin()
+    // Valor do contador ou duracao em ns da zona de GPU
+    double value;
+    EventType type;
+};
+
+// So a thread dona escreve; count publica os eventos para quem le em end()
+struct Chunk {
+    static constexpr uint32_t CAPACITY = 4096;
+    Event events[CAPACITY];
+    std::atomic<uint32_t> count{0};
+    std::unique_ptr<Chunk> next;
+};
+
+struct ThreadBuffer {
+    uint32_t threadId;
+    std::string name;
+    Chunk head;
+    Chunk* tail = &head;
+};
+
+struct ThreadState {
+    ThreadBuffer* buffer = nullptr;
+    uint32_t session = 0;
+    std::string name;
+};
+
+std::atomic<bool> g_enabled{false};
+// Muda a cada begin(); buffers de sessoes anteriores nao sao mais usados
+std::atomic<uint32_t> g_session{0};
+std::mutex g_registryMutex;
+std::vector<std::unique_ptr<ThreadBuffer>> g_buffers;
+std::string g_path;
+Clock::time_point g_start;
+uint32_t g_nextThreadId = 1;
+
+thread_local ThreadState t_state;
+
+ThreadBuffer* currentBuffer() {
+    uint32_t session = g_session.load(std::memory_order_acquire);
+    if (t_state.session == session && t_state.buffer) {
+        return t_state.buffer;
+    }
+
+    // Primeiro evento desta thread na sessao: unico ponto com lock
+    std::lock_guard<std::mutex> lock(g_registryMutex);
+    auto buffer = std::make_unique<ThreadBuffer>();
+    buffer->threadId = g_nextThreadId++;
+    buffer->name = t_state.name;
+    t_state.buffer = buffer.get();
+    t_state.session = session;
+    g_buffers.push_back(std::move(buffer));
+    return t_state.buffer;
+}
+
+uint64_t elapsedNs() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - g_start).count());
+}
+
+void recordAt(const char* name, EventType type, uint64_t timestamp, double value) {
+    ThreadBuffer* buffer = currentBuffer();
+    Chunk* chunk = buffer->tail;
+    uint32_t count = chunk->count.load(std::memory_order_relaxed);
+    if (count == Chunk::CAPACITY) {
+        chunk->next = std::make_unique<Chunk>();
+        chunk = chunk->next.get();
+        buffer->tail = chunk;
+        count = 0;
+    }
+
+    chunk->events[count] = {name, timestamp, value, type};
+    chunk->count.store(count + 1, std::memory_order_release);
+}
+
+void record(const char* name, EventType type, double value) {
+    if (!g_enabled.load(std::memory_order_relaxed)) {
+        return;
+    }
+    recordAt(name, type, elapsedNs(), value);
+}
+
+void writeEscaped(FILE* file, const char* text) {
+    for (const char* c = text; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            std::fputc('\\', file);
+        }
+        if (static_cast<unsigned char>(*c) >= 0x20) {
+            std::fputc(*c, file);
+        }
+    }
+}
+
+bool writeChromeTrace(const std::string& path) {
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) {
+        return false;
+    }
+
+    std::fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    std::fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+                       "\"args\":{\"name\":\"GPU\"}}",
+                 GPU_TRACK_ID);
+    bool first = false;
+    for (const auto& buffer : g_buffers) {
+        if (!buffer->name.empty()) {
+            std::fprintf(file,
+                         "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+                         "\"args\":{\"name\":\"",
+                         first ? "" : ",\n", buffer->threadId);
+            writeEscaped(file, buffer->name.c_str());
+            std::fprintf(file, "\"}}");
+            first = false;
+        }
+
+        for (const Chunk* chunk = &buffer->head; chunk; chunk = chunk->next.get()) {
+            uint32_t count = chunk->count.load(std::memory_order_acquire);
+            for (uint32_t i = 0; i < count; i++) {
+                const Event& event = chunk->events[i];
+                std::fprintf(file, "%s{\"name\":\"", first ? "" : ",\n");
+                writeEscaped(file, event.name);
+                double microseconds = event.timestamp / 1000.0;
+                switch (event.type) {
+                case EventType::BEGIN:
+                    std::fprintf(file, "\",\"ph\":\"B\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}",
+                                 microseconds, buffer->threadId);
+                    break;
+                case EventType::END:
+                    std::fprintf(file, "\",\"ph\":\"E\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}",
+                                 microseconds, buffer->threadId);
+                    break;
+                case EventType::COUNTER:
+                    std::fprintf(file,
+                                 "\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":1,\"tid\":%u,"
+                                 "\"args\":{\"value\":%.17g}}",
+                                 microseconds, buffer->threadId, event.value);
+                    break;
+                case EventType::FRAME:
+                    std::fprintf(file,
+                                 "\",\"ph\":\"i\",\"s\":\"g\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}",
+                                 microseconds, buffer->threadId);
+                    break;
+                case EventType::GPU_ZONE:
+                    std::fprintf(file,
+                                 "\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                                 microseconds, event.value / 1000.0, GPU_TRACK_ID);
+                    break;
+                }
+                first = false;
+            }
+        }
+    }
+    std::fprintf(file, "\n]}\n");
+
+    bool ok = std::ferror(file) == 0;
+    return std::fclose(file) == 0 && ok;
+}
+} // namespace
+
+namespace Trace {
+
+bool begin(const std::string& path) {
+    std::lock_guard<std::mutex> lock(g_registryMutex);
+    if (g_enabled.load()) {
+        LOG_WARN("Trace already running, writing to " + g_path);
+        return false;
+    }
+
+    g_path = path;
+    g_buffers.clear();
+    g_nextThreadId = 1;
+    g_start = Clock::now();
+    g_session.fetch_add(1, std::memory_order_release);
+    g_enabled.store(true);
+    LOG_INFO("Tracing to " + path);
+    return true;
+}
+
+bool end() {
+    if (!g_enabled.exchange(false)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(g_registryMutex);
+    bool written = writeChromeTrace(g_path);
+    if (!written) {
+        LOG_ERROR("Failed to write trace " + g_path);
+    }
+    g_buffers.clear();
+    g_session.fetch_add(1, std::memory_order_release);
+    return written;
+}
+
+bool isEnabled() { return g_enabled.load(std::memory_order_relaxed); }
+
+void beginZone(const char* name) { record(name, EventType::BEGIN, 0.0); }
+
+void endZone(const char* name) { record(name, EventType::END, 0.0); }
+
+void counter(const char* name, double value) { record(name, EventType::COUNTER, value); }
+
+void frameMark() { record("frame", EventType::FRAME, 0.0); }
+
+uint64_t now() { return g_enabled.load(std::memory_order_relaxed) ? elapsedNs() : 0; }
+
+void gpuZone(const char* name, uint64_t beginNs, uint64_t endNs) {
+    if (!g_enabled.load(std::memory_order_relaxed) || endNs < beginNs) {
+        return;
+    }
+    recordAt(name, EventType::GPU_ZONE, beginNs, static_cast<double>(endNs - beginNs));
+}
+
+void setThreadName(const char* name) {
+    t_state.name = name;
+    std::lock_guard<std::mutex> lock(g_registryMutex);
+    if (t_state.buffer && t_state.session == g_session.load()) {
+        t_state.buffer->name = name;
+    }
+}
+
+} // namespace Trace
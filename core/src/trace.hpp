@@ -0,0 +1,67 @@
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <cstdint>
+#include <string>
+
+// Instrumentacao de CPU: zonas (inicio/fim), contadores e marcadores de frame, mais
+// as zonas de GPU medidas pelos backends.
+// Cada thread grava num buffer proprio, sem locks no caminho quente; Trace::end
+// junta tudo num JSON do Chrome trace (abre em chrome://tracing e ui.perfetto.dev).
+// Os nomes precisam viver ate o fim da sessao (literais ou __func__).
+namespace Trace {
+
+// Liga a gravacao; o arquivo so e escrito em end()
+bool begin(const std::string& path);
+// Chamar com as outras threads paradas ou ociosas: os buffers sao liberados aqui
+bool end();
+bool isEnabled();
+
+void beginZone(const char* name);
+void endZone(const char* name);
+void counter(const char* name, double value);
+void frameMark();
+// ns desde begin(); base de tempo dos eventos
+uint64_t now();
+// Zona ja medida (ex.: pela GPU) exibida numa trilha "GPU" separada
+void gpuZone(const char* name, uint64_t beginNs, uint64_t endNs);
+// Nome exibido para a thread atual; pode ser chamado antes de begin()
+void setThreadName(const char* name);
+
+class Zone {
+  private:
+    const char* name;
+    bool active;
+
+  public:
+    explicit Zone(const char* name) : name(name), active(isEnabled()) {
+        if (active) {
+            beginZone(name);
+        }
+    }
+    ~Zone() {
+        if (active) {
+            endZone(name);
+        }
+    }
+    Zone(const Zone&) = delete;
+    Zone& operator=(const Zone&) = delete;
+};
+
+} // namespace Trace
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+// YUME_DISABLE_TRACE remove a instrumentacao do binario
+#ifdef YUME_DISABLE_TRACE
+#define TRACE_ZONE(name) ((void)0)
+#define TRACE_COUNTER(name, value) ((void)0)
+#define TRACE_FRAME_MARK() ((void)0)
+#else
+#define TRACE_ZONE(name) Trace::Zone TRACE_CONCAT(traceZone, __LINE__)(name)
+#define TRACE_COUNTER(name, value) Trace::counter(name, static_cast<double>(value))
+#define TRACE_FRAME_MARK() Trace::frameMark()
+#endif
+
+#endif // TRACE_HPP
@@ -1,36 +1,214 @@
+#define CLASS_NAME "Transform"
+#include "log_macros.hpp"
+
 #include "transform.hpp"
-#include <glm/gtc/matrix_transform.hpp>
+#include "transform_hierarchy.hpp"
+#include <algorithm>
+
+Transform::~Transform() {
+    if (hierarchy && queued) {
+        hierarchy->remove(this);
+    }
+    if (parent) {
+        auto& siblings = parent->children;
+        siblings.erase(std::find(siblings.begin(), siblings.end(), this));
+    }
+    // Filhos viram raizes com a propria matriz local como matriz de mundo
+    for (Transform* child : children) {
+        child->parent = nullptr;
+        child->markWorldChanged();
+    }
+}
+
+void Transform::setObserver(TransformObserver* obs, int32_t handle) {
+    observer = obs;
+    observerHandle = handle;
+}
+
+void Transform::setHierarchy(TransformHierarchy* transforms) {
+    if (hierarchy == transforms) {
+        return;
+    }
+    if (hierarchy && queued) {
+        hierarchy->remove(this);
+        queued = false;
+    }
+
+    hierarchy = transforms;
+    if (hierarchy && worldDirty) {
+        queued = true;
+        hierarchy->enqueue(this);
+    }
+}
+
+void Transform::notifyChanged() {
+    if (observer) {
+        observer->onTransformChanged(observerHandle);
+    }
+}
 
-glm::mat4 Transform::getModelMatrix() const {
-    glm::mat4 model = glm::mat4(1.0f);
-    model = glm::translate(model, glm::vec3(position.x, position.y, position.z));
-    model = glm::rotate(model, glm::radians(rotation.x), glm::vec3(1.0f, 0.0f, 0.0f));
-    model = glm::rotate(model, glm::radians(rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
-    model = glm::rotate(model, glm::radians(rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
-    model = glm::scale(model, glm::vec3(scale.x, scale.y, scale.z));
-    return model;
+void Transform::markWorldChanged() {
+    // Ja sujo: a subarvore tambem esta e ja foi avisada
+    if (worldDirty) {
+        notifyChanged();
+    } else {
+        invalidateWorld();
+    }
+
+    if (hierarchy && !queued) {
+        queued = true;
+        hierarchy->enqueue(this);
+    }
+}
+
+void Transform::invalidateWorld() {
+    if (worldDirty) {
+        return;
+    }
+    worldDirty = true;
+    notifyChanged();
+    for (Transform* child : children) {
+        child->invalidateWorld();
+    }
+}
+
+bool Transform::isAncestorOf(const Transform* other) const {
+    for (const Transform* node = other->parent; node; node = node->parent) {
+        if (node == this) {
+            return true;
+        }
+    }
+    return false;
 }
 
-Vector3 Transform::getPosition() const { 
-    return position; 
+bool Transform::setParent(Transform* newParent) {
+    if (newParent == parent) {
+        return true;
+    }
+    if (newParent == this || (newParent && isAncestorOf(newParent))) {
+        LOG_ERROR("Parent would create a cycle in the transform hierarchy");
+        return false;
+    }
+
+    if (parent) {
+        auto& siblings = parent->children;
+        siblings.erase(std::find(siblings.begin(), siblings.end(), this));
+    }
+    parent = newParent;
+    if (parent) {
+        parent->children.push_back(this);
+    }
+
+    markWorldChanged();
+    return true;
 }
 
-void Transform::setPosition(const Vector3& pos) { 
-    position = pos; 
+Transform* Transform::getParent() const {
+    return parent;
 }
 
-Vector3 Transform::getRotation() const { 
-    return rotation; 
+const std::vector<Transform*>& Transform::getChildren() const {
+    return children;
 }
 
-void Transform::setRotation(const Vector3& rot) { 
-    rotation = rot; 
+const glm::mat4& Transform::getModelMatrix() const {
+    if (worldDirty) {
+        const glm::mat4& local = getLocalMatrix();
+        worldMatrix = parent ? parent->getModelMatrix() * local : local;
+        worldDirty = false;
+    }
+    return worldMatrix;
 }
 
-Vector3 Transform::getScale() const { 
-    return scale; 
+const glm::mat4& Transform::getLocalMatrix() const {
+    if (localDirty) {
+        localMatrix = composeMatrix(position, rotation, scale);
+        localDirty = false;
+    }
+    return localMatrix;
 }
 
-void Transform::setScale(const Vector3& scl) { 
-    scale = scl; 
-}
\ No newline at end of file
+glm::mat4 Transform::composeMatrix(const Vector3& position, const glm::quat& rotation,
+                                   const Vector3& scale) {
+    // Colunas da rotacao ja escaladas; sem os translate/rotate/scale encadeados
+    glm::mat3 axes = glm::mat3_cast(rotation);
+    return glm::mat4(glm::vec4(axes[0] * scale.x, 0.0f), glm::vec4(axes[1] * scale.y, 0.0f),
+                     glm::vec4(axes[2] * scale.z, 0.0f),
+                     glm::vec4(position.x, position.y, position.z, 1.0f));
+}
+
+Vector3 Transform::getPosition() const {
+    return position;
+}
+
+void Transform::setPosition(const Vector3& pos) {
+    position = pos;
+    localDirty = true;
+    markWorldChanged();
+}
+
+glm::quat Transform::getRotation() const {
+    return rotation;
+}
+
+void Transform::setRotation(const glm::quat& rot) {
+    rotation = glm::normalize(rot);
+    localDirty = true;
+    markWorldChanged();
+}
+
+void Transform::setEulerAngles(const Vector3& degrees) {
+    rotation = glm::angleAxis(glm::radians(degrees.x), glm::vec3(1.0f, 0.0f, 0.0f)) *
+               glm::angleAxis(glm::radians(degrees.y), glm::vec3(0.0f, 1.0f, 0.0f)) *
+               glm::angleAxis(glm::radians(degrees.z), glm::vec3(0.0f, 0.0f, 1.0f));
+    localDirty = true;
+    markWorldChanged();
+}
+
+Vector3 Transform::getScale() const {
+    return scale;
+}
+
+void Transform::setScale(const Vector3& scl) {
+    scale = scl;
+    localDirty = true;
+    markWorldChanged();
+}
+
+void Transform::setLocalMatrix(const glm::mat4& matrix) {
+    position = {matrix[3].x, matrix[3].y, matrix[3].z};
+
+    glm::mat3 axes(matrix);
+    float lengths[3];
+    for (int i = 0; i < 3; i++) {
+        lengths[i] = glm::length(axes[i]);
+        if (lengths[i] > 0.0f) {
+            axes[i] /= lengths[i];
+        }
+    }
+    // Espelhamento vai para a escala, o quaternion so representa rotacoes
+    if (glm::determinant(axes) < 0.0f) {
+        lengths[0] = -lengths[0];
+        axes[0] = -axes[0];
+    }
+    scale = {lengths[0], lengths[1], lengths[2]};
+    rotation = glm::normalize(glm::quat_cast(axes));
+
+    localMatrix = matrix;
+    localDirty = false;
+    markWorldChanged();
+}
+
+void Transform::copyWorld(const Transform& source) {
+    const glm::mat4& world = source.getModelMatrix();
+    if (!worldDirty && worldMatrix == world) {
+        return;
+    }
+
+    setLocalMatrix(world);
+    // Sem pai a de mundo e a local: ja fica limpa para leituras de outras threads
+    if (!parent) {
+        worldMatrix = localMatrix;
+        worldDirty = false;
+    }
+}
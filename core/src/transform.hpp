@@ -2,25 +2,94 @@
 #define TRANSFORM_HPP
 
 #include "vector3.hpp"
+#include <cstdint>
 #include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <vector>
 
+class TransformHierarchy;
+
+// Notificado quando a matriz de mundo muda, inclusive por causa de um pai
+// (ex.: indice espacial da cena)
+class TransformObserver {
+  public:
+    virtual ~TransformObserver() = default;
+    virtual void onTransformChanged(int32_t handle) = 0;
+};
+
+// Posicao, rotacao e escala sao locais (relativas ao pai). As matrizes local e de
+// mundo ficam em cache e so sao recalculadas depois de uma mudanca: mexer num
+// Transform suja ele e a subarvore, objetos parados nao fazem conta nenhuma.
+// A TransformHierarchy da cena recalcula as subarvores sujas em lote; fora dela
+// getModelMatrix resolve sob demanda.
 class Transform {
   private:
-    Vector3 position;
-    Vector3 rotation;
-    Vector3 scale;
+    Vector3 position = {0.0f, 0.0f, 0.0f};
+    glm::quat rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    Vector3 scale = {1.0f, 1.0f, 1.0f};
+
+    Transform* parent = nullptr;
+    std::vector<Transform*> children;
+
+    // Preenchidas sob demanda, por isso mutable
+    mutable glm::mat4 localMatrix = glm::mat4(1.0f);
+    mutable glm::mat4 worldMatrix = glm::mat4(1.0f);
+    mutable bool localDirty = true;
+    // Sujo implica filhos sujos
+    mutable bool worldDirty = true;
+
+    TransformHierarchy* hierarchy = nullptr;
+    // Ja esta na fila de hierarchy
+    bool queued = false;
+
+    TransformObserver* observer = nullptr;
+    int32_t observerHandle = -1;
+
+    friend class TransformHierarchy;
+
+    void notifyChanged();
+    void markWorldChanged();
+    void invalidateWorld();
+    bool isAncestorOf(const Transform* other) const;
 
   public:
-    glm::mat4 getModelMatrix() const;
+    Transform() = default;
+    ~Transform();
+    Transform(const Transform&) = delete;
+    Transform& operator=(const Transform&) = delete;
+
+    void setObserver(TransformObserver* obs, int32_t handle);
+    void setHierarchy(TransformHierarchy* transforms);
+
+    // Falha se newParent for o proprio Transform ou um descendente; nullptr solta
+    bool setParent(Transform* newParent);
+    Transform* getParent() const;
+    const std::vector<Transform*>& getChildren() const;
+
+    // Matriz de mundo
+    const glm::mat4& getModelMatrix() const;
+    const glm::mat4& getLocalMatrix() const;
+
+    // T * R * S
+    static glm::mat4 composeMatrix(const Vector3& position, const glm::quat& rotation,
+                                   const Vector3& scale);
 
     Vector3 getPosition() const;
     void setPosition(const Vector3& pos);
 
-    Vector3 getRotation() const;
-    void setRotation(const Vector3& rot);
+    glm::quat getRotation() const;
+    void setRotation(const glm::quat& rot);
+    // Graus, aplicados em X, depois Y, depois Z (ordem do formato de cena)
+    void setEulerAngles(const Vector3& degrees);
 
     Vector3 getScale() const;
     void setScale(const Vector3& scl);
+
+    // Usa matrix como matriz local exata; posicao, rotacao e escala sao extraidas
+    // dela (aproximadas se houver cisalhamento)
+    void setLocalMatrix(const glm::mat4& matrix);
+    // Copia a pose de mundo de source para um Transform sem pai (proxies)
+    void copyWorld(const Transform& source);
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,112 @@
+#include "transform_hierarchy.hpp"
+#include "job_system.hpp"
+#include "trace.hpp"
+#include "transform.hpp"
+#include <algorithm>
+
+namespace {
+// Transforms por bloco do parallelFor; lotes menores rodam direto na thread chamadora
+constexpr size_t UPDATE_GRAIN = 256;
+} // namespace
+
+TransformHierarchy::~TransformHierarchy() { clear(); }
+
+void TransformHierarchy::enqueue(Transform* transform) { dirtyRoots.push_back(transform); }
+
+void TransformHierarchy::remove(Transform* transform) {
+    auto found = std::find(dirtyRoots.begin(), dirtyRoots.end(), transform);
+    if (found != dirtyRoots.end()) {
+        dirtyRoots.erase(found);
+    }
+}
+
+void TransformHierarchy::clear() {
+    for (Transform* transform : dirtyRoots) {
+        transform->queued = false;
+    }
+    dirtyRoots.clear();
+}
+
+void TransformHierarchy::gatherBatch() {
+    nodes.clear();
+    parents.clear();
+    levels.clear();
+
+    // Um ancestral tambem na fila ja cobre a subarvore
+    for (Transform* root : dirtyRoots) {
+        bool covered = false;
+        for (const Transform* node = root->parent; node; node = node->parent) {
+            if (node->queued) {
+                covered = true;
+                break;
+            }
+        }
+        if (covered) {
+            continue;
+        }
+        // O pai fica fora do lote: resolvido aqui para as threads so lerem o cache
+        if (root->parent) {
+            root->parent->getModelMatrix();
+        }
+        nodes.push_back(root);
+        parents.push_back(-1);
+    }
+    clear();
+
+    // Largura: cada nivel vem inteiro depois do anterior
+    levels.push_back(0);
+    size_t begin = 0;
+    while (begin < nodes.size()) {
+        size_t end = nodes.size();
+        levels.push_back(end);
+        for (size_t i = begin; i < end; i++) {
+            for (Transform* child : nodes[i]->children) {
+                nodes.push_back(child);
+                parents.push_back(static_cast<int32_t>(i));
+            }
+        }
+        begin = end;
+    }
+}
+
+void TransformHierarchy::update() {
+    if (dirtyRoots.empty()) {
+        lastUpdateCount = 0;
+        return;
+    }
+    TRACE_ZONE("TransformHierarchy::update");
+
+    gatherBatch();
+    size_t count = nodes.size();
+    locals.resize(count);
+    worlds.resize(count);
+    Yume::JobSystem& jobs = Yume::JobSystem::shared();
+
+    // Cada no aparece uma vez no lote, entao as threads nunca escrevem no mesmo cache
+    jobs.parallelFor(count, UPDATE_GRAIN, [this](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            locals[i] = nodes[i]->getLocalMatrix();
+        }
+    });
+
+    for (size_t level = 0; level + 1 < levels.size(); level++) {
+        size_t first = levels[level];
+        jobs.parallelFor(levels[level + 1] - first, UPDATE_GRAIN,
+                         [this, first](size_t begin, size_t end) {
+            for (size_t i = first + begin; i < first + end; i++) {
+                const Transform* node = nodes[i];
+                if (parents[i] >= 0) {
+                    worlds[i] = worlds[parents[i]] * locals[i];
+                } else if (node->parent) {
+                    worlds[i] = node->parent->worldMatrix * locals[i];
+                } else {
+                    worlds[i] = locals[i];
+                }
+                node->worldMatrix = worlds[i];
+                node->worldDirty = false;
+            }
+        });
+    }
+
+    lastUpdateCount = count;
+}
@@ -0,0 +1,48 @@
+#ifndef TRANSFORM_HIERARCHY_HPP
+#define TRANSFORM_HIERARCHY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+class Transform;
+
+// Recalcula em lote as matrizes de mundo dos Transforms registrados. Transforms
+// alterados entram numa fila; update() percorre so as subarvores deles e monta o
+// lote por profundidade em arrays paralelos (SoA): primeiro todas as matrizes
+// locais, independentes entre si, e depois um nivel por vez, cada no multiplicando
+// a matriz do pai ja pronta no nivel anterior. As duas etapas rodam em parallelFor.
+class TransformHierarchy {
+  private:
+    std::vector<Transform*> dirtyRoots;
+
+    // Lote do update, reaproveitado entre frames
+    std::vector<Transform*> nodes;
+    // Indice do pai no lote; -1 usa a matriz de mundo (ja limpa) do pai
+    std::vector<int32_t> parents;
+    std::vector<glm::mat4> locals;
+    std::vector<glm::mat4> worlds;
+    // Inicio de cada nivel em nodes, mais o fim
+    std::vector<size_t> levels;
+    size_t lastUpdateCount = 0;
+
+    friend class Transform;
+
+    void enqueue(Transform* transform);
+    void remove(Transform* transform);
+
+    void gatherBatch();
+
+  public:
+    ~TransformHierarchy();
+
+    // Esvazia a fila sem calcular nada
+    void clear();
+    void update();
+
+    // Transforms recalculados no ultimo update
+    size_t getLastUpdateCount() const { return lastUpdateCount; }
+};
+
+#endif // TRANSFORM_HIERARCHY_HPP
@@ -8,6 +8,11 @@ struct WindowDesc {
     int width  = 800;
     int height = 600;
     unsigned int extraFlags = 0;
+    // Sem janela: o backend renderiza num alvo offscreen de width x height
+    bool headless = false;
+    // Se nao vazio, grava frame_NNNNN.ppm nesse diretorio a cada captureInterval frames
+    std::string captureDirectory;
+    int captureInterval = 1;
 };
 
 #endif
\ No newline at end of file
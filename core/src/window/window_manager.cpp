@@ -2,9 +2,13 @@
 #define CLASS_NAME "WindowManager"
 #include "window_manager.hpp"
 #include "log_macros.hpp"
+#include "image_writer.hpp"
+#include <cstdio>
+#include <vector>
 
 
 WindowManager::~WindowManager() {
+    stopRenderThread();
     if (renderer) {
         delete renderer;
     }
@@ -15,15 +19,84 @@ WindowManager::~WindowManager() {
 }
 
 void WindowManager::render(Scene& scene) {
+    if (renderThread) {
+        RenderSnapshot& snapshot = renderThread->acquireSnapshot();
+        renderer->buildSnapshot(scene, snapshot);
+        snapshot.setFrameIndex(frameIndex);
+        return;
+    }
     renderer->render(scene);
 }
 
 void WindowManager::present() {
+    if (renderThread) {
+        renderThread->submitSnapshot();
+    } else {
+        presentFrame(frameIndex);
+    }
+    frameIndex++;
+}
+
+void WindowManager::presentFrame(uint64_t index) {
     if (renderer) {
         renderer->present(window);
+
+        if (!captureDirectory.empty() && index % captureInterval == 0) {
+            captureFrame(index);
+        }
+    }
+}
+
+bool WindowManager::startRenderThread() {
+    if (renderThread || !renderer || !renderer->getRendererBackend()) {
+        return renderThread != nullptr;
+    }
+
+    renderThread = std::make_unique<RenderThread>(
+        *renderer->getRendererBackend(), [this](RenderSnapshot& snapshot) {
+            renderer->render(snapshot);
+            presentFrame(snapshot.getFrameIndex());
+        });
+    if (!renderThread->start()) {
+        renderThread.reset();
+        return false;
+    }
+    return true;
+}
+
+void WindowManager::stopRenderThread() {
+    if (renderThread) {
+        renderThread->stop();
+        renderThread.reset();
     }
 }
 
+void WindowManager::pauseRendering() {
+    if (renderThread) {
+        renderThread->pause();
+    }
+}
+
+void WindowManager::resumeRendering() {
+    if (renderThread) {
+        renderThread->resume();
+    }
+}
+
+void WindowManager::captureFrame(uint64_t index) {
+    std::vector<uint8_t> pixels;
+    int width = 0, height = 0;
+    if (!renderer->getRendererBackend()->readPixels(pixels, width, height)) {
+        LOG_WARN("Backend cannot read back frames, capture disabled");
+        captureDirectory.clear();
+        return;
+    }
+
+    char name[32];
+    std::snprintf(name, sizeof(name), "/frame_%05llu.ppm", (unsigned long long)index);
+    ImageWriter::writePPM(captureDirectory + name, pixels.data(), width, height);
+}
+
 bool WindowManager::init(const WindowDesc& desc) {
 
     renderer = new Renderer();
@@ -33,6 +106,20 @@ bool WindowManager::init(const WindowDesc& desc) {
         return false;
     }
 
+    captureDirectory = desc.captureDirectory;
+    captureInterval = desc.captureInterval > 0 ? desc.captureInterval : 1;
+
+    if (desc.headless) {
+        headless = true;
+        if (!renderer->initHeadless(desc.width, desc.height)) {
+            LOG_ERROR("Failed to initialize headless renderer!");
+            return false;
+        }
+        LOG_INFO("Headless " + std::to_string(desc.width) + "x" +
+                 std::to_string(desc.height));
+        return true;
+    }
+
     unsigned int flags = SDL_WINDOW_SHOWN | desc.extraFlags |
                          renderer->getRendererBackend()->getRequiredWindowFlags();
 
@@ -2,15 +2,27 @@
 #define WINDOW_MANAGER_HPP
 
 #include "../graphics_api.hpp"
+#include "../renderer/render_thread.hpp"
 #include "../renderer/renderer.hpp"
 #include "window_desc.hpp"
 #include <SDL2/SDL.h>
+#include <cstdint>
+#include <memory>
+#include <string>
 
 class WindowManager {
 private:
     GraphicsAPI graphicsApi;
     SDL_Window* window = nullptr;
     Renderer* renderer = nullptr;
+    bool headless = false;
+    std::string captureDirectory;
+    int captureInterval = 1;
+    uint64_t frameIndex = 0;
+    std::unique_ptr<RenderThread> renderThread;
+
+    void presentFrame(uint64_t index);
+    void captureFrame(uint64_t index);
 
 public:
     ~WindowManager();
@@ -18,8 +30,19 @@ public:
     bool init(const WindowDesc& desc);
     void render(Scene& scene);
     SDL_Window* getWindow() {return window;};
+    bool isHeadless() const { return headless; }
+    uint64_t getFrameIndex() const { return frameIndex; }
     Renderer* getRenderer(){return renderer;}
     void present();
+
+    // Com a thread de render, render() so copia a cena num snapshot e present() o envia;
+    // o desenho e o present do backend acontecem na outra thread
+    bool startRenderThread();
+    void stopRenderThread();
+    bool hasRenderThread() const { return renderThread != nullptr; }
+    // Envolve carga de cena e qualquer outra criacao/destruicao de recursos do backend
+    void pauseRendering();
+    void resumeRendering();
     void setGraphicsApi(const GraphicsAPI &api) { graphicsApi = api; }
 };
 
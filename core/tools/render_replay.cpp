@@ -0,0 +1,178 @@
+#include "engine_stats.hpp"
+#include "logger.hpp"
+#include "renderer/render_replay.hpp"
+#include "renderer/renderer.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+// Reproduz uma captura de YUME_RENDER_CAPTURE num backend headless, sem logica de jogo
+// nem carga de cena, e imprime os tempos de frame. Mesmo arquivo em backends ou drivers
+// diferentes = mesma carga de trabalho, chamada por chamada.
+//
+// Uso (da raiz do projeto, de onde saem shaders e texturas):
+//   render_replay --capture=frames.yrc [--gpu=opengl|vulkan|software|none] [--loops=1]
+//                 [--fps=0] [--warmup=10] [--width=W] [--height=H] [--csv=frames.csv]
+// --fps=0 reproduz o mais rapido possivel; com --fps=N cada frame espera o seu horario.
+// Os primeiros --warmup frames rodam mas ficam fora das estatisticas.
+
+namespace {
+struct Arguments {
+    std::string capture;
+    std::string gpu = "opengl";
+    uint32_t loops = 1;
+    double fps = 0.0;
+    uint32_t warmup = 10;
+    int width = 0;
+    int height = 0;
+    std::string csv;
+};
+
+bool readArgument(const char* arg, const char* name, std::string& value) {
+    size_t length = std::strlen(name);
+    if (std::strncmp(arg, name, length) != 0 || arg[length] != '=') {
+        return false;
+    }
+    value = arg + length + 1;
+    return true;
+}
+
+bool parseArguments(int argc, char* argv[], Arguments& args) {
+    for (int i = 1; i < argc; i++) {
+        std::string value;
+        if (readArgument(argv[i], "--capture", value)) {
+            args.capture = value;
+        } else if (readArgument(argv[i], "--gpu", value)) {
+            args.gpu = value;
+        } else if (readArgument(argv[i], "--loops", value)) {
+            args.loops = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+        } else if (readArgument(argv[i], "--fps", value)) {
+            args.fps = std::atof(value.c_str());
+        } else if (readArgument(argv[i], "--warmup", value)) {
+            args.warmup = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+        } else if (readArgument(argv[i], "--width", value)) {
+            args.width = std::atoi(value.c_str());
+        } else if (readArgument(argv[i], "--height", value)) {
+            args.height = std::atoi(value.c_str());
+        } else if (readArgument(argv[i], "--csv", value)) {
+            args.csv = value;
+        } else {
+            std::fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+            return false;
+        }
+    }
+
+    if (args.capture.empty()) {
+        std::fprintf(stderr, "Missing --capture=<file.yrc>\n");
+        return false;
+    }
+    return true;
+}
+
+bool parseGraphicsApi(const std::string& name, GraphicsAPI& api) {
+    if (name == "software") {
+        api = GraphicsAPI::SOFTWARE;
+    } else if (name == "opengl") {
+        api = GraphicsAPI::OPENGL;
+    } else if (name == "vulkan") {
+        api = GraphicsAPI::VULKAN;
+    } else if (name == "none") {
+        api = GraphicsAPI::NONE;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void printSummary(const char* label, const FrameTimeSummary& summary) {
+    if (summary.samples == 0) {
+        return;
+    }
+    std::printf("%-4s %u frames: mean %.3f ms, p50 %.3f, p95 %.3f, p99 %.3f, max %.3f\n", label,
+                summary.samples, summary.mean, summary.p50, summary.p95, summary.p99,
+                summary.max);
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Arguments args;
+    GraphicsAPI api;
+    if (!parseArguments(argc, argv, args)) {
+        return 1;
+    }
+    if (!parseGraphicsApi(args.gpu, api)) {
+        std::fprintf(stderr, "Unknown --gpu: %s\n", args.gpu.c_str());
+        return 1;
+    }
+    Logger::init("render_replay");
+
+    // Os recursos da captura sao destruidos antes do backend
+    Renderer renderer;
+    RenderReplay replay;
+    if (!replay.load(args.capture) || replay.getFrameCount() == 0) {
+        std::fprintf(stderr, "Unable to load %s\n", args.capture.c_str());
+        Logger::shutdown();
+        return 1;
+    }
+
+    int width = 1280, height = 720;
+    replay.getViewport(width, height);
+    width = args.width > 0 ? args.width : width;
+    height = args.height > 0 ? args.height : height;
+
+    if (!renderer.initBackend(api) || !renderer.initHeadless(width, height)) {
+        std::fprintf(stderr, "Headless %s not available\n", args.gpu.c_str());
+        Logger::shutdown();
+        return 1;
+    }
+    if (!replay.createResources(*renderer.getRendererBackend())) {
+        std::fprintf(stderr, "Unable to create the captured resources\n");
+        Logger::shutdown();
+        return 1;
+    }
+
+    size_t frameCount = replay.getFrameCount();
+    uint64_t totalFrames = static_cast<uint64_t>(frameCount) * args.loops;
+    using Clock = std::chrono::steady_clock;
+    auto interval = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(args.fps > 0.0 ? 1.0 / args.fps : 0.0));
+    auto nextFrame = Clock::now();
+    auto start = nextFrame;
+
+    for (uint64_t frame = 0; frame < totalFrames; frame++) {
+        if (frame == args.warmup) {
+            EngineStats::resetFrameTimes();
+            if (!args.csv.empty()) {
+                EngineStats::openCsv(args.csv);
+            }
+            start = Clock::now();
+        }
+        if (args.fps > 0.0) {
+            std::this_thread::sleep_until(nextFrame);
+            nextFrame += interval;
+        }
+
+        replay.playFrame(frame % frameCount);
+        EngineStats::endFrame();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    // Esvazia a fila antes de destruir os recursos
+    std::vector<uint8_t> pixels;
+    renderer.getRendererBackend()->readPixels(pixels, width, height);
+    EngineStats::closeCsv();
+
+    uint64_t measured = totalFrames > args.warmup ? totalFrames - args.warmup : 0;
+    std::printf("%s: %zu captured frames x %u loops on %s, %llu measured in %.3f s (%.1f fps)\n",
+                args.capture.c_str(), frameCount, args.loops, args.gpu.c_str(),
+                static_cast<unsigned long long>(measured), seconds,
+                seconds > 0.0 ? measured / seconds : 0.0);
+    printSummary("cpu", EngineStats::getFrameTimes());
+    printSummary("gpu", EngineStats::getGpuFrameTimes());
+
+    Logger::shutdown();
+    return 0;
+}
@@ -0,0 +1,345 @@
+#include <nlohmann/json.hpp>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Gera cenas .scn de teste de escala a partir de uma semente. Mesmos argumentos e
+// mesma semente produzem os mesmos arquivos (.scn e meshes .obj), byte a byte.
+//
+// Uso (da raiz do projeto, de onde o main carrega meshes e shaders):
+//   scene_generator --out=stress.scn [--objects=1000] [--meshes=4] [--materials=16]
+//                   [--lights=1] [--sprites=0] [--distribution=grid|clustered|random]
+//                   [--clusters=8] [--extent=100] [--seed=1] [--texture=px.png]
+//
+// As meshes sao esferas com tesselacao diferente por indice, gravadas ao lado do
+// .scn como <nome>_mesh_<i>.obj. A primeira luz e direcional, as demais pontuais.
+// Depois: tools/scene_compiler stress.scn stress.scnb e YUME_SCENE=stress.scnb no main.
+
+using json = nlohmann::json;
+
+namespace {
+constexpr float PI = 3.14159265358979f;
+
+enum class Distribution { GRID, CLUSTERED, RANDOM };
+
+struct Arguments {
+    std::string output;
+    uint32_t objects = 1000;
+    uint32_t meshes = 4;
+    uint32_t materials = 16;
+    uint32_t lights = 1;
+    uint32_t sprites = 0;
+    Distribution distribution = Distribution::GRID;
+    uint32_t clusters = 8;
+    float extent = 100.0f;
+    uint32_t seed = 1;
+    std::string texture = "px.png";
+};
+
+// xorshift32: mesma sequencia em qualquer compilador/plataforma, ao contrario das
+// distribuicoes de <random>
+class SceneRandom {
+  private:
+    uint32_t state;
+
+  public:
+    explicit SceneRandom(uint32_t seed) : state(seed ? seed : 0x9E3779B9u) {}
+
+    uint32_t next() {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    // [min, max)
+    float range(float min, float max) {
+        return min + (max - min) * (next() >> 8) * (1.0f / 16777216.0f);
+    }
+
+    // Box-Muller
+    float gaussian() {
+        float u = range(1e-7f, 1.0f);
+        float v = range(0.0f, 1.0f);
+        return std::sqrt(-2.0f * std::log(u)) * std::cos(2.0f * PI * v);
+    }
+};
+
+// Uma sequencia por categoria: mudar o numero de luzes nao muda as posicoes dos objetos
+uint32_t streamSeed(uint32_t seed, uint32_t stream) {
+    uint32_t value = seed * 0x9E3779B9u + stream * 0x85EBCA6Bu;
+    value ^= value >> 16;
+    value *= 0x7FEB352Du;
+    value ^= value >> 15;
+    return value;
+}
+
+// Tres casas decimais deixam o .scn menor e estavel entre plataformas
+double round3(float value) { return std::round(value * 1000.0) / 1000.0; }
+
+bool readArgument(const char* arg, const char* name, std::string& value) {
+    size_t length = std::strlen(name);
+    if (std::strncmp(arg, name, length) != 0 || arg[length] != '=') {
+        return false;
+    }
+    value = arg + length + 1;
+    return true;
+}
+
+uint32_t toCount(const std::string& value) {
+    return static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+}
+
+bool parseArguments(int argc, char* argv[], Arguments& args) {
+    for (int i = 1; i < argc; i++) {
+        std::string value;
+        if (readArgument(argv[i], "--out", value)) {
+            args.output = value;
+        } else if (readArgument(argv[i], "--objects", value)) {
+            args.objects = toCount(value);
+        } else if (readArgument(argv[i], "--meshes", value)) {
+            args.meshes = toCount(value);
+        } else if (readArgument(argv[i], "--materials", value)) {
+            args.materials = toCount(value);
+        } else if (readArgument(argv[i], "--lights", value)) {
+            args.lights = toCount(value);
+        } else if (readArgument(argv[i], "--sprites", value)) {
+            args.sprites = toCount(value);
+        } else if (readArgument(argv[i], "--clusters", value)) {
+            args.clusters = toCount(value);
+        } else if (readArgument(argv[i], "--extent", value)) {
+            args.extent = static_cast<float>(std::atof(value.c_str()));
+        } else if (readArgument(argv[i], "--seed", value)) {
+            args.seed = toCount(value);
+        } else if (readArgument(argv[i], "--texture", value)) {
+            args.texture = value;
+        } else if (readArgument(argv[i], "--distribution", value)) {
+            if (value == "grid") {
+                args.distribution = Distribution::GRID;
+            } else if (value == "clustered") {
+                args.distribution = Distribution::CLUSTERED;
+            } else if (value == "random") {
+                args.distribution = Distribution::RANDOM;
+            } else {
+                std::fprintf(stderr, "Unknown distribution: %s\n", value.c_str());
+                return false;
+            }
+        } else {
+            std::fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+            return false;
+        }
+    }
+
+    if (args.output.empty()) {
+        std::fprintf(stderr, "Missing --out=<file.scn>\n");
+        return false;
+    }
+    if (args.objects > 0 && args.meshes == 0) {
+        std::fprintf(stderr, "--meshes must be at least 1 when there are objects\n");
+        return false;
+    }
+    if ((args.objects > 0 || args.sprites > 0) && args.materials == 0) {
+        std::fprintf(stderr, "--materials must be at least 1 when there are objects\n");
+        return false;
+    }
+    if (args.extent <= 0.0f || args.clusters == 0) {
+        std::fprintf(stderr, "--extent and --clusters must be positive\n");
+        return false;
+    }
+    return true;
+}
+
+// Esfera UV com normais por vertice
+bool writeSphereObj(const std::string& path, int segments, int rings) {
+    std::ofstream file(path);
+    if (!file) {
+        return false;
+    }
+
+    for (int r = 0; r <= rings; r++) {
+        float phi = PI * r / rings;
+        for (int s = 0; s <= segments; s++) {
+            float theta = 2.0f * PI * s / segments;
+            double x = round3(std::sin(phi) * std::cos(theta) * 0.5f);
+            double y = round3(std::cos(phi) * 0.5f);
+            double z = round3(std::sin(phi) * std::sin(theta) * 0.5f);
+            file << "v " << x << " " << y << " " << z << "\n";
+            file << "vn " << x * 2.0 << " " << y * 2.0 << " " << z * 2.0 << "\n";
+        }
+    }
+
+    // Indices do OBJ comecam em 1
+    int stride = segments + 1;
+    for (int r = 0; r < rings; r++) {
+        for (int s = 0; s < segments; s++) {
+            int a = r * stride + s + 1;
+            int b = a + stride;
+            file << "f " << a << "//" << a << " " << b << "//" << b << " " << (b + 1) << "//"
+                 << (b + 1) << "\n";
+            file << "f " << a << "//" << a << " " << (b + 1) << "//" << (b + 1) << " " << (a + 1)
+                 << "//" << (a + 1) << "\n";
+        }
+    }
+    return static_cast<bool>(file);
+}
+
+// Posicoes de todos os objetos (meshes e sprites) segundo a distribuicao escolhida
+class Placement {
+  private:
+    const Arguments& args;
+    SceneRandom random;
+    std::vector<float> centers;
+    uint32_t side = 1;
+    uint32_t placed = 0;
+
+  public:
+    Placement(const Arguments& args, uint32_t total)
+        : args(args), random(streamSeed(args.seed, 1)) {
+        side = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(total))));
+        side = side == 0 ? 1 : side;
+        for (uint32_t i = 0; i < args.clusters * 3; i++) {
+            centers.push_back(random.range(-0.4f, 0.4f) * args.extent);
+        }
+    }
+
+    json next() {
+        float half = args.extent * 0.5f;
+        float x = 0.0f, y = 0.0f, z = 0.0f;
+        switch (args.distribution) {
+        case Distribution::GRID: {
+            float spacing = side > 1 ? args.extent / (side - 1) : 0.0f;
+            x = (placed % side) * spacing - half;
+            z = (placed / side) * spacing - half;
+            break;
+        }
+        case Distribution::CLUSTERED: {
+            uint32_t cluster = random.next() % args.clusters;
+            float sigma = args.extent * 0.03f;
+            x = centers[cluster * 3 + 0] + random.gaussian() * sigma;
+            y = centers[cluster * 3 + 1] * 0.2f + random.gaussian() * sigma;
+            z = centers[cluster * 3 + 2] + random.gaussian() * sigma;
+            break;
+        }
+        case Distribution::RANDOM:
+            x = random.range(-half, half);
+            y = random.range(-half, half) * 0.2f;
+            z = random.range(-half, half);
+            break;
+        }
+        placed++;
+        return {round3(x), round3(y), round3(z)};
+    }
+};
+
+json makeMaterial(SceneRandom& random, uint32_t index) {
+    // Alterna os shaders do projeto para que haja trocas de programa, nao so de cor
+    const char* shader = index % 2 == 0 ? "flat" : "unlit";
+    return {{"vertexShaderPath", std::string(shader) + ".vxs"},
+            {"fragmentShaderPath", std::string(shader) + ".pxs"},
+            {"color",
+             {round3(random.range(0, 1)), round3(random.range(0, 1)), round3(random.range(0, 1)),
+              1.0}}};
+}
+
+json makeTransform(Placement& placement, SceneRandom& random) {
+    float scale = random.range(0.5f, 1.5f);
+    json position = placement.next();
+    return {{"type", "TRANSFORM"},
+            {"position", position},
+            {"rotation", {round3(random.range(0, 360)), round3(random.range(0, 360)), 0.0}},
+            {"scale", {round3(scale), round3(scale), round3(scale)}}};
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Arguments args;
+    if (!parseArguments(argc, argv, args)) {
+        return 1;
+    }
+
+    std::filesystem::path output(args.output);
+    std::string stem = output.stem().string();
+
+    // Meshes: caminho relativo ao diretorio de onde o main roda, como o proprio --out
+    std::vector<std::string> meshPaths;
+    for (uint32_t i = 0; i < args.meshes && args.objects > 0; i++) {
+        std::filesystem::path meshPath =
+            output.parent_path() / (stem + "_mesh_" + std::to_string(i) + ".obj");
+        if (!writeSphereObj(meshPath.string(), 8 + 4 * i, 4 + 2 * i)) {
+            std::fprintf(stderr, "Failed to write %s\n", meshPath.string().c_str());
+            return 1;
+        }
+        meshPaths.push_back(meshPath.generic_string());
+    }
+
+    SceneRandom materialRandom(streamSeed(args.seed, 2));
+    std::vector<json> materials;
+    for (uint32_t i = 0; i < args.materials; i++) {
+        materials.push_back(makeMaterial(materialRandom, i));
+    }
+
+    json scene;
+    scene["camera"] = {{"background_color", {0.2, 0.3, 0.3, 1.0}},
+                       {"fov", 60.0},
+                       {"view_rect", {800.0, 600.0}},
+                       {"position", {0.0, round3(args.extent * 0.3f), round3(args.extent * 0.6f)}}};
+
+    SceneRandom lightRandom(streamSeed(args.seed, 3));
+    json lights = json::array();
+    for (uint32_t i = 0; i < args.lights; i++) {
+        if (i == 0) {
+            lights.push_back({{"type", "DIRECTIONAL"}, {"direction", {0.5, -1.0, -0.5}}});
+            continue;
+        }
+        float half = args.extent * 0.5f;
+        lights.push_back({{"type", "POINT"},
+                          {"direction", {0.0, -1.0, 0.0}},
+                          {"position",
+                           {round3(lightRandom.range(-half, half)),
+                            round3(lightRandom.range(1.0f, 10.0f)),
+                            round3(lightRandom.range(-half, half))}},
+                          {"range", round3(lightRandom.range(5.0f, 20.0f))}});
+    }
+    scene["lights"] = lights;
+
+    Placement placement(args, args.objects + args.sprites);
+    SceneRandom objectRandom(streamSeed(args.seed, 4));
+    json objects = json::array();
+    for (uint32_t i = 0; i < args.objects; i++) {
+        uint32_t mesh = objectRandom.next() % args.meshes;
+        uint32_t material = objectRandom.next() % args.materials;
+        json renderer = {{"type", "MESH_RENDERER"},
+                         {"mesh", {{"path", meshPaths[mesh]}, {"shadeSmooth", mesh % 2 == 0}}},
+                         {"material", materials[material]}};
+        objects.push_back({{"components", {renderer, makeTransform(placement, objectRandom)}}});
+    }
+
+    for (uint32_t i = 0; i < args.sprites; i++) {
+        uint32_t material = objectRandom.next() % args.materials;
+        json renderer = {{"type", "SPRITE_RENDERER"},
+                         {"texture",
+                          {{"path", args.texture},
+                           {"scaleFactor", 0.01},
+                           {"filterType", i % 2 == 0 ? "NEAREST" : "LINEAR"}}},
+                         {"material", materials[material]}};
+        objects.push_back({{"components", {renderer, makeTransform(placement, objectRandom)}}});
+    }
+    scene["gameObjects"] = objects;
+
+    std::ofstream file(args.output);
+    file << scene.dump() << "\n";
+    if (!file) {
+        std::fprintf(stderr, "Failed to write %s\n", args.output.c_str());
+        return 1;
+    }
+
+    std::printf("%s: %u objects, %u sprites, %zu meshes, %u materials, %u lights (seed %u)\n",
+                args.output.c_str(), args.objects, args.sprites, meshPaths.size(),
+                args.materials, args.lights, args.seed);
+    return 0;
+}